@@ -1,5 +1,7 @@
 #type vertex
 #version 330 core
+// Packed vertex (Render2D::QuadVertex, 20 bytes): float position, RGBA8 color,
+// unorm16 UV, byte texture slot and ushort tiling in 8.8 fixed point.
 layout(location=0) in vec2 aPos;
 layout(location=1) in vec4 aColor;
 layout(location=2) in vec2 aUV;
@@ -17,7 +19,7 @@ void main(){
     vColor     = aColor;
     vUV        = aUV;
     vTexIndex  = aTexIndex;
-    vTiling    = aTiling;
+    vTiling    = aTiling * (1.0 / 256.0);
     gl_Position = uViewProj * vec4(aPos, 0.0, 1.0);
 }
 
@@ -0,0 +1,48 @@
+#type vertex
+#version 300 es
+precision highp float;
+
+// Instanced quads whose textures are layers of one sampler2DArray; aTexIndex is the layer.
+layout(location=0) in vec2  aCorner;
+layout(location=1) in vec2  aOrigin;
+layout(location=2) in vec2  aAxisX;
+layout(location=3) in vec2  aAxisY;
+layout(location=4) in vec4  aUVRect;   // u0, v0, u1, v1
+layout(location=5) in vec4  aColor;    // RGBA8, normalized
+layout(location=6) in float aTexIndex;
+layout(location=7) in float aTiling;
+
+uniform mat4 uViewProj;
+
+out vec4  vColor;
+out vec2  vUV;
+flat out float vLayer;
+out float vTiling;
+
+void main() {
+    vColor     = aColor;
+    vUV        = mix(aUVRect.xy, aUVRect.zw, aCorner);
+    vLayer     = aTexIndex;
+    vTiling    = aTiling;
+    vec2 pos   = aOrigin + aAxisX * aCorner.x + aAxisY * aCorner.y;
+    gl_Position = uViewProj * vec4(pos, 0.0, 1.0);
+}
+
+
+#type fragment
+#version 300 es
+precision mediump float;
+precision mediump sampler2DArray;
+
+in vec4  vColor;
+in vec2  vUV;
+flat in float vLayer;
+in float vTiling;
+
+out vec4 FragColor;
+
+uniform sampler2DArray uTextureArray;
+
+void main() {
+    FragColor = vColor * texture(uTextureArray, vec3(vUV * vTiling, vLayer));
+}
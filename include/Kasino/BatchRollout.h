@@ -0,0 +1,43 @@
+#pragma once
+#include "GameState.h"
+#include "Move.h"
+#include <cstdint>
+#include <vector>
+
+// Monte Carlo playouts.
+//
+// Rollout policy (the same for both runners): pick a uniformly random card from the
+// current hand; if that card has any capture in LegalMoves, play one of those captures
+// uniformly at random, otherwise trail it. Hands are re-dealt while the stock lasts.
+//
+// ReferenceRollouts plays every game through LegalMoves/ApplyMove. BatchRollouts runs
+// the same policy over groups of 8 games kept as structure-of-arrays (hands and table as
+// card bitmasks / rank lanes, scores as int lanes) and advances them in lock-step. The
+// two produce the same score distribution.
+
+struct RolloutRng {
+  uint32_t state = 1;
+
+  explicit RolloutRng(uint32_t seed = 1) : state(seed ? seed : 0x9E3779B9u) {}
+
+  uint32_t Next() {
+    uint32_t x = state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return state = x;
+  }
+
+  // uniform in [0, n)
+  uint32_t Below(uint32_t n) { return (uint32_t)(((uint64_t)Next() * n) >> 32); }
+};
+
+struct RolloutStats {
+  int games = 0;
+  std::vector<int64_t> totalScore; // summed ScoreRound totals per player
+  std::vector<int> wins;           // outright wins per player (ties count for nobody)
+};
+
+// Picks the policy move out of `moves` (= LegalMoves(gs)). Returns an index into moves.
+int RolloutPolicyPick(const GameState& gs, const std::vector<Move>& moves, RolloutRng& rng);
+
+RolloutStats ReferenceRollouts(const GameState& start, int games, uint32_t seed);
+RolloutStats BatchRollouts(const GameState& start, int games, uint32_t seed);
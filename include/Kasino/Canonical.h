@@ -0,0 +1,115 @@
+#pragma once
+#include "GameState.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Suit-isomorphism for positions.
+//
+// Nothing in move generation or scoring looks at suits (captures, builds and the
+// point counters only see ranks), so two positions that differ by a relabeling of
+// the suits play out identically. The hash below is invariant under any of the 24
+// suit permutations: each suit keeps its own Zobrist accumulator over
+// (rank, location) and the accumulators are sorted before being combined.
+//
+// Note: if the big/little casino cards (2S, 10D) ever start scoring, the symmetry
+// breaks and those two suits would have to be pinned.
+
+// Hash locations. Pile cards only matter through the score counters, so captured
+// cards drop out of the hash (LocGone).
+constexpr int LocGone = -1;
+constexpr int LocLoose = 4;
+constexpr int LocHand(int player) { return player; }
+constexpr int LocBuild(int owner, int value) { return 5 + (owner + 1) * 16 + (value < 0 ? 0 : value > 15 ? 15 : value); }
+constexpr int LocStock(int index) { return 85 + index; }
+constexpr int NumLocations = 85 + 52;
+
+struct PositionHash {
+  std::array<uint64_t, 4> suitHash{}; // per-suit XOR of rank/location keys
+  uint64_t buildKey = 0;              // sum of per-build (owner, value) keys
+  uint64_t scalarKey = 0;             // turn, last capture, score counters
+
+  void Reset(const GameState& gs);
+
+  // canonical (suit-permutation invariant) key
+  uint64_t Key() const;
+
+  // toCanonical[s] = suit that `s` maps to in the canonical labeling
+  std::array<Suit, 4> SuitOrder() const;
+
+  // low level: card moved between two Loc* slots
+  void MoveCard(const Card& c, int fromLoc, int toLoc);
+  void SyncScalars(const GameState& gs);
+};
+
+// Same as the GameLogic versions but keep `hash` up to date from the move itself
+// instead of rehashing the whole position.
+bool ApplyMove(GameState& gs, const Move& mv, PositionHash& hash);
+bool DealNextHands(GameState& gs, PositionHash& hash);
+void StartRound(GameState& gs, PositionHash& hash, int numPlayers=2, uint32_t shuffleSeed=0);
+
+uint64_t CanonicalHash(const GameState& gs);
+
+// Relabels suits into the canonical labeling. Container order is kept, so the
+// index fields of a Move stay valid; only Move::handCard needs RemapCard.
+GameState Canonicalize(const GameState& gs);
+GameState Canonicalize(const GameState& gs, const PositionHash& hash);
+
+inline Card RemapCard(const Card& c, const std::array<Suit, 4>& map) {
+  return Card(c.rank, map[static_cast<int>(c.suit)]);
+}
+
+inline std::array<Suit, 4> InverseSuitOrder(const std::array<Suit, 4>& map) {
+  std::array<Suit, 4> inv{};
+  for (int s=0; s<4; ++s) inv[static_cast<int>(map[s])] = static_cast<Suit>(s);
+  return inv;
+}
+
+// Direct-mapped transposition table keyed by the canonical hash. Size is rounded
+// up to a power of two; a colliding store simply replaces the old entry.
+template<class T>
+class PositionCache {
+public:
+  explicit PositionCache(size_t entries = 1u << 16) { Resize(entries); }
+
+  void Resize(size_t entries) {
+    size_t n = 1;
+    while (n < entries) n <<= 1;
+    m_Entries.assign(n, Entry{});
+    m_Mask = n - 1;
+    m_Hits = m_Misses = 0;
+  }
+
+  void Clear() {
+    for (auto& e : m_Entries) e.used = false;
+    m_Hits = m_Misses = 0;
+  }
+
+  const T* Probe(uint64_t key) const {
+    const Entry& e = m_Entries[key & m_Mask];
+    if (e.used && e.key == key) { ++m_Hits; return &e.value; }
+    ++m_Misses;
+    return nullptr;
+  }
+
+  void Store(uint64_t key, const T& value) {
+    Entry& e = m_Entries[key & m_Mask];
+    e.key = key; e.value = value; e.used = true;
+  }
+
+  size_t Capacity() const { return m_Entries.size(); }
+  uint64_t Hits() const { return m_Hits; }
+  uint64_t Misses() const { return m_Misses; }
+
+private:
+  struct Entry {
+    uint64_t key = 0;
+    T value{};
+    bool used = false;
+  };
+
+  std::vector<Entry> m_Entries;
+  size_t m_Mask = 0;
+  mutable uint64_t m_Hits = 0;
+  mutable uint64_t m_Misses = 0;
+};
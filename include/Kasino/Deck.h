@@ -15,9 +15,27 @@ struct Deck {
         cards.emplace_back(static_cast<Rank>(r), static_cast<Suit>(s));
   }
 
+  // Fisher-Yates on raw mt19937 output rather than std::shuffle, whose algorithm is
+  // up to the standard library: lockstep peers built against libstdc++, libc++ and
+  // MSVC must all deal the same deck from the same seed.
   void Shuffle(uint32_t seed=0) {
     std::mt19937 rng(seed ? seed : std::random_device{}());
-    std::shuffle(cards.begin(), cards.end(), rng);
+    for (uint32_t i = (uint32_t)cards.size(); i > 1; --i)
+      std::swap(cards[i-1], cards[UniformBelow(rng, i)]);
+  }
+
+  // Unbiased draw in [0, bound), Lemire's multiply-and-reject
+  static uint32_t UniformBelow(std::mt19937& rng, uint32_t bound) {
+    uint64_t m = (uint64_t)(uint32_t)rng() * bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound) {
+      const uint32_t threshold = (0u - bound) % bound;   // 2^32 mod bound
+      while (low < threshold) {
+        m = (uint64_t)(uint32_t)rng() * bound;
+        low = (uint32_t)m;
+      }
+    }
+    return (uint32_t)(m >> 32);
   }
 
   bool Empty() const { return cards.empty(); }
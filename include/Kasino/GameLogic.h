@@ -15,6 +15,11 @@
   std::vector<Move> LegalMoves(const GameState& gs);
   bool ApplyMove(GameState& gs, const Move& mv); // returns true if applied
 
+  // Compact move codes for the wire: a move is its index in LegalMoves(gs), which is
+  // deterministic for a given state. -1 / false when the move or code isn't legal.
+  int EncodeMove(const GameState& gs, const Move& mv);
+  bool DecodeMove(const GameState& gs, int code, Move& out);
+
   // Scoring at end of round
   struct ScoreLine {
     int total = 0;
@@ -27,6 +32,9 @@
   // Utility
   int CardSumValue(const std::vector<Card>& v);
 
+  // Exact hash of everything in the state (card order included); for desync checks.
+  uint64_t StateChecksum(const GameState& gs);
+
 struct Selection {
     std::optional<int> handIndex;
     std::set<int> loose;
@@ -5,10 +5,12 @@
 #include "Kasino/GameLogic.h"
 #include "Kasino/Scoring.h"
 #include "input/InputSystem.h"
-#include "gfx/ITexture2D.h"
+#include "gfx/TextureAtlas.h"
+#include "gfx/CompositeCache.h"
 #include "audio/IAudioBuffer.h"
 #include "audio/IAudioSource.h"
 #include "audio/SoundSystem.h"
+#include "ui/UISystem.h"
 
 #include <glm/glm.hpp>
 
@@ -16,10 +18,14 @@ class KasinoGame : public Game {
  public:
  bool OnStart() override;
  void OnUpdate(float dt) override;
- void OnRender() override;
+ void OnRender(float alpha) override;
  void OnStop() override;
+ bool WantsRedraw() const override;
  ~KasinoGame();
 
+ // Deals and AI choices come from this; fix it for repeatable scripted runs.
+ void SetSeed(uint32_t seed) { m_Rng.seed(seed); }
+
  private:
   enum class Phase { MainMenu, Playing, RoundSummary, MatchSummary };
 
@@ -73,6 +79,10 @@ private:
   void updateVolumeHandleRect();
 
   void drawScene();
+  void drawRetained(Render2D::DrawList &list, uint64_t version,
+                    void (KasinoGame::*draw)());
+  uint64_t hoverSignature() const;
+  void nextLayer();
   void drawMainMenu();
   void drawScoreboard();
   void drawHands();
@@ -88,6 +98,14 @@ private:
   void drawCardBack(const Rect &r, bool isCurrent, float rotation);
   void drawBuildFace(const Build &build, const Rect &r, bool legal,
                      bool hovered, bool selected);
+  // what the functions above bake into m_CardCache, or draw on a miss
+  void drawCardFaceLayers(const Card &card, const Rect &r, float rotation,
+                          bool labels, bool isCurrent, bool selected,
+                          bool legal, bool hovered);
+  void drawCardBackLayers(const Rect &r, bool isCurrent, float rotation);
+  void drawBuildFaceLayers(const Build &build, const Rect &r, bool legal,
+                           bool hovered, bool selected);
+  void drawComposite(const Sprite &sprite, const Rect &bounds, float rotation);
 
   std::string moveLabel(const Move &mv) const;
   std::string moveLabelForDifficulty(const Move &mv, Difficulty difficulty) const;
@@ -97,7 +115,7 @@ private:
   bool movesEquivalent(const Move &a, const Move &b) const;
   bool selectionCompatible(const Move &mv) const;
   void loadCardTextures();
-  std::string cardTextureKey(const Card &card) const;
+  static int cardSpriteIndex(const Card &card);
   std::string cardTexturePath(const Card &card) const;
   std::string cardRankString(Rank rank) const;
   std::string cardSuitFolder(Suit suit) const;
@@ -218,7 +236,40 @@ private:
       glm::vec4(0.35f, 0.80f, 0.45f, 1.0f),
       glm::vec4(0.90f, 0.70f, 0.25f, 1.0f)};
 
-  std::unordered_map<std::string, Ref<ITexture2D>> m_CardTextures;
-  Ref<ITexture2D> m_CardBackTexture;
+  uint16_t m_DrawLayer = 0;
+  bool m_ShowProfiler = false;
+  float m_RenderAlpha = 0.f;  // OnRender's step fraction, for animation interpolation
+
+  // Retained scene regions. m_SceneVersion moves on any input, animation, phase or
+  // viewport change; m_HoverVersion only when a hover highlight changes.
+  Render2D::DrawList m_TableList;
+  Render2D::DrawList m_ActionPanelList;
+  Render2D::DrawList m_HandsList;
+  Render2D::DrawList m_ScoreboardList;
+  uint64_t m_SceneVersion = 1;
+  uint64_t m_HoverVersion = 1;
+  glm::vec2 m_LastViewSize{0.f, 0.f};
+
+  // HUD strings, rebuilt only when their number changes
+  struct ScoreboardText {
+    struct Seat {
+      ui::NumberLabel player{"PLAYER "};
+      ui::NumberLabel total{"TOTAL "};
+      ui::NumberLabel cards{"CARDS +"};
+      ui::NumberLabel builds{"BUILDS +"};
+      ui::NumberLabel sweeps{"SWEEPS +"};
+    };
+    ui::NumberLabel round{"ROUND "};
+    ui::NumberLabel turn{"TURN P"};
+    ui::NumberLabel deck{"DECK "};
+    std::array<Seat, 4> seats;
+  };
+  ScoreboardText m_ScoreboardText;
+
+  // all 52 faces and the back share one atlas page
+  std::array<Sprite, 52> m_CardSprites{};
+  Sprite m_CardBackSprite;
+  // cards and builds with their borders, highlights and labels, baked to one quad each
+  CompositeCache m_CardCache;
 };
 
@@ -0,0 +1,105 @@
+#pragma once
+#include "GameState.h"
+#include "core/Types.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Peer-to-peer lock-step play. Every peer runs the full rules locally: the deck seed is
+// the XOR of one share from each peer, and after that only move codes (index into
+// LegalMoves) cross the wire. Each peer sends a checksum of its state every
+// `checksumInterval` turns so a desync shows up within a few moves.
+//
+// Wire messages (one per datagram/frame, the transport keeps message boundaries):
+//   Hello    [1][u8 peer][u32 seedShare]
+//   Move     [2][u16 turn][u16 code]
+//   Checksum [3][u16 turn][u32 hash]
+
+// Reliable, ordered, message-oriented link to one remote peer.
+class ILockstepTransport {
+public:
+  virtual ~ILockstepTransport() = default;
+  virtual void Send(const uint8_t* data, size_t size) = 0;
+  virtual bool Receive(std::vector<uint8_t>& out) = 0; // false when nothing is queued
+};
+
+// In-process transport for tests and hot-seat debugging; both ends may live on
+// different threads.
+class LoopbackTransport : public ILockstepTransport {
+public:
+  struct Channel {
+    std::mutex lock;
+    std::deque<std::vector<uint8_t>> queue;
+    size_t bytes = 0; // total bytes ever sent through this channel
+  };
+
+  LoopbackTransport(Ref<Channel> out, Ref<Channel> in) : m_Out(std::move(out)), m_In(std::move(in)) {}
+
+  void Send(const uint8_t* data, size_t size) override;
+  bool Receive(std::vector<uint8_t>& out) override;
+
+  size_t BytesSent() const { return m_Out->bytes; }
+
+  static std::pair<Ref<LoopbackTransport>, Ref<LoopbackTransport>> CreatePair();
+
+private:
+  Ref<Channel> m_Out;
+  Ref<Channel> m_In;
+};
+
+struct LockstepConfig {
+  int numPlayers = 2;
+  int numPeers = 2;
+  int localPeer = 0;
+  std::vector<int> seatPeer;   // seat -> owning peer; empty = seat i belongs to peer i
+  int checksumInterval = 8;    // turns between checksum exchanges
+};
+
+class LockstepSession {
+public:
+  explicit LockstepSession(const LockstepConfig& cfg);
+
+  void AddPeer(int peer, Ref<ILockstepTransport> transport);
+
+  // Sends our seed share; the round starts once every peer's share has arrived.
+  void Start(uint32_t seedShare);
+
+  // Pumps all transports: applies remote moves in turn order and checks checksums.
+  void Poll();
+
+  bool Started() const { return m_Started; }
+  bool IsLocalTurn() const;
+  bool SubmitLocalMove(const Move& mv); // false if not our turn or not legal
+
+  const GameState& State() const { return m_State; }
+  uint16_t Turn() const { return m_Turn; }
+  bool Desynced() const { return m_DesyncTurn >= 0; }
+  int DesyncTurn() const { return m_DesyncTurn; }
+
+  std::function<void(int seat, const Move& mv)> OnMoveApplied;
+  std::function<void(int turn)> OnDesync;
+
+private:
+  void broadcast(const uint8_t* data, size_t size);
+  void onMessage(int peer, const std::vector<uint8_t>& msg);
+  bool applyCode(int seat, int code);
+  void afterTurn();
+  void compareChecksum(uint16_t turn, uint32_t remote);
+
+  LockstepConfig m_Config;
+  std::vector<Ref<ILockstepTransport>> m_Peers;
+  std::vector<uint32_t> m_SeedShares;
+  std::vector<bool> m_HaveShare;
+  bool m_Started = false;
+
+  GameState m_State;
+  uint16_t m_Turn = 0;
+
+  std::unordered_map<uint16_t, std::pair<int, int>> m_PendingMoves; // turn -> (peer, code), arrived early
+  std::unordered_map<uint16_t, uint32_t> m_LocalChecksums;  // turn -> our hash
+  std::unordered_map<uint16_t, uint32_t> m_RemoteChecksums; // turn -> hash we couldn't check yet
+  int m_DesyncTurn = -1;
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include "BatchRollout.h"
+#include "Canonical.h"
+#include "GameState.h"
+#include "Move.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Flat Monte Carlo move choice.
+//
+// Every legal move is scored by BatchRollouts from the position it leads to. The child
+// is keyed by the canonical hash, updated from the move on a copy of the parent's
+// PositionHash rather than rehashed, and its value is kept in a PositionCache under
+// that key. Children that are suit relabelings of each other, and positions met again
+// by later searches, are rolled out once.
+//
+// Choose sees the whole state. A seat that must not see the other hands or the stock
+// uses ChooseHidden, which averages over Determinize()d copies.
+
+struct SearchConfig {
+  int gamesPerMove = 32;
+  int worlds = 4;        // ChooseHidden: determinizations per decision
+  uint32_t seed = 1;
+};
+
+struct SearchValue {
+  std::array<float, 4> meanScore{}; // ScoreRound total per player, over the rollouts
+};
+
+class MoveSearch {
+public:
+  explicit MoveSearch(size_t cacheEntries = 1u << 14) : m_Cache(cacheEntries) {}
+
+  // Index into moves (= LegalMoves(gs)) with the best mean margin for gs.current over
+  // the best other player, or -1 if there are none.
+  int Choose(const GameState& gs, const std::vector<Move>& moves, const SearchConfig& cfg = {});
+  int ChooseHidden(const GameState& gs, const std::vector<Move>& moves, const SearchConfig& cfg = {});
+
+  // Adds each move's margin to margins[i]; hash must be current for gs.
+  void Evaluate(const GameState& gs, const PositionHash& hash, const std::vector<Move>& moves,
+                const SearchConfig& cfg, std::vector<float>& margins);
+
+  const PositionCache<SearchValue>& Cache() const { return m_Cache; }
+  void Clear() { m_Cache.Clear(); }
+
+private:
+  PositionCache<SearchValue> m_Cache;
+};
+
+// Copy of gs with the cards `viewer` can't see (the other hands and the stock) dealt
+// out again at random. Sizes, the viewer's hand, the table and the piles are kept, so
+// LegalMoves for the viewer is unchanged.
+GameState Determinize(const GameState& gs, int viewer, uint32_t seed);
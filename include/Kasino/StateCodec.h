@@ -0,0 +1,43 @@
+#pragma once
+#include "GameState.h"
+#include <cstddef>
+#include <cstdint>
+
+// Binary GameState codec for networking and saves.
+//
+// Every blob starts with a 4 byte header: 'K' 'S' <version> <kind>. A card is one byte
+// (rank << 2 | suit).
+//
+//   Snapshot: the whole state.
+//   Delta:    changes relative to a base state: the turn pointer, score counter deltas,
+//             and per container (hands, piles, loose, stock, builds) which cards were
+//             removed and which were appended. It carries checksums of the base and the
+//             result, so applying it to the wrong base fails cleanly.
+//
+// Encoders write into the caller's buffer and return the byte count, or 0 if `cap` was
+// too small. Decoders write into an existing GameState and reuse its vectors; after
+// ReserveState they don't allocate, except for the card list of a build that isn't on
+// the table yet (std::vector<Build> keeps no storage for it) and for a snapshot with a
+// different player count. If a delta fails after its base check passed (corrupt data),
+// the state is unspecified and the caller should resync from a snapshot. Out-of-range
+// fields (player count, turn, last capturer, card bytes, build owner and value) fail
+// the decode.
+
+constexpr uint8_t StateCodecVersion = 1;
+
+enum class StateBlobKind : uint8_t { Snapshot = 0, Delta = 1 };
+
+size_t EncodeSnapshot(const GameState& gs, uint8_t* out, size_t cap);
+size_t EncodeDelta(const GameState& base, const GameState& target, uint8_t* out, size_t cap);
+
+bool DecodeSnapshot(const uint8_t* data, size_t size, GameState& out);
+bool ApplyDelta(const uint8_t* data, size_t size, GameState& state); // state must equal the base
+
+// Snapshot or delta, whichever the header says.
+bool DecodeState(const uint8_t* data, size_t size, GameState& state);
+
+// Upper bound on an encoded snapshot; a good size for a scratch buffer.
+constexpr size_t MaxSnapshotBytes = 512;
+
+// Full-deck capacity for every card list in gs, including the builds already on the table.
+void ReserveState(GameState& gs, int numPlayers = 4);
@@ -5,6 +5,7 @@
 #include "gfx/Render2D.h"
 #include "gfx/IGraphicsDevice.h"
 #include "gfx/RenderCommand.h"
+#include "gfx/RenderThread.h"
 #include "core/Factory.h"
 #include "window/IWindow.h"
 #include "audio/IAudioDevice.h"
@@ -13,9 +14,35 @@
 
 // forward-declare to avoid depending on its exact fields
 struct FactoryDesc;
+struct Image;
 
 class Game {
  public:
+  // Continuous redraws every iteration; OnDemand only when input arrives, the game
+  // reports WantsRedraw, or a RequestRedraw/RequestRedrawIn is pending, and otherwise
+  // sleeps in the window's event wait.
+  enum class RedrawMode { Continuous, OnDemand };
+
+  // OnUpdate runs in fixed steps off an accumulator; OnRender gets how far the clock
+  // is into the next step. A stall runs at most MaxCatchUpSteps and drops the rest.
+  struct FrameTiming {
+    float FixedStep       = 1.0f / 60.0f;  // seconds per OnUpdate
+    int   MaxCatchUpSteps = 4;             // per frame
+    float TargetFps       = 0.0f;          // > 0: pace frames (sleep, then spin)
+    float SpinSeconds     = 0.002f;        // tail of the pacing wait that spins
+    bool  Deterministic   = false;         // one step per frame, wall clock ignored
+  };
+
+  struct FrameStats {
+    uint64_t Frames         = 0;
+    uint64_t Steps          = 0;
+    uint32_t LateFrames     = 0;     // frames that overran the pacing target
+    uint32_t DroppedSteps   = 0;     // steps discarded by the catch-up cap
+    uint32_t SkippedFrames  = 0;     // on-demand idle iterations
+    float    LastFrameMs    = 0.0f;  // update + render, before pacing
+    float    WorstOverrunMs = 0.0f;
+  };
+
   Game() = default;
   virtual ~Game() = default;
 
@@ -25,12 +52,37 @@ class Game {
   void Shutdown();
   void Stop() { m_Running = false; }
 
+  void SetRedrawMode(RedrawMode mode);
+  RedrawMode GetRedrawMode() const { return m_RedrawMode; }
+  void RequestRedraw();
+  void RequestRedrawIn(float seconds);
+
+  void SetFrameTiming(const FrameTiming& timing);
+  const FrameTiming& GetFrameTiming() const { return m_Timing; }
+  const FrameStats& GetFrameStats() const { return m_FrameStats; }
+
+  // OnUpdate/OnRender record each frame into a command list while a render thread,
+  // which owns the GL context for the length of Run, executes the previous one. GL
+  // objects must be created in OnStart (or inside RenderCommand::Enqueue) and released
+  // in OnStop. Takes effect at the next Run; ignored on the web build.
+  void SetThreadedRendering(bool enable) { m_ThreadedRendering = enable; }
+  bool IsThreadedRendering() const { return m_ThreadedRendering; }
+  // Live while threaded; after Run, the totals of the last threaded run
+  RenderThread::Stats GetRenderThreadStats() const;
+
+  IWindow* GetWindow() const { return m_Window.get(); }
+  // Last rendered frame, see IGraphicsDevice::ReadPixels; call between Run and Shutdown.
+  bool ReadFrame(Image& out) const;
+
  protected:
   virtual bool OnStart() { return true; }
   virtual void OnUpdate(float dtSeconds) {}
-  virtual void OnRender() {}
+  // alpha in [0, 1): fraction of FixedStep since the last OnUpdate
+  virtual void OnRender(float /*alpha*/) {}
   virtual void OnResize(int fbWidth, int fbHeight) {}
   virtual void OnStop() {}  
+  // OnDemand mode: true while something moves on its own (animations, timers)
+  virtual bool WantsRedraw() const { return false; }
 
  protected:
   Scope<IWindow>         m_Window;
@@ -46,10 +98,29 @@ class Game {
   std::chrono::high_resolution_clock::time_point m_LastFrameTime{};
   bool m_OnStopCalled = false;
 
+  RedrawMode m_RedrawMode = RedrawMode::Continuous;
+  bool m_RedrawRequested = true;
+  bool m_WasIdle = false;
+  std::chrono::high_resolution_clock::time_point m_RedrawDeadline =
+      std::chrono::high_resolution_clock::time_point::max();
+  uint64_t m_EventGeneration = 0;
+
+  FrameTiming m_Timing;
+  FrameStats  m_FrameStats;
+  float       m_Accumulator = 0.0f;
+
+  bool                m_ThreadedRendering = false;
+  Scope<RenderThread> m_RenderThread;   // live during Run when threaded
+  RenderThread::Stats m_RenderThreadStats;
+  static constexpr double kMaxIdleWait = 0.5;  // seconds; still notices ShouldClose
+
   #ifdef __EMSCRIPTEN__
   static void EmscriptenMainLoop(void* userData);
 #endif
 
   void runFrame();
   void handleStop();
+  void stopRenderThread();
+  bool redrawDue(std::chrono::high_resolution_clock::time_point now) const;
+  void paceFrame(std::chrono::high_resolution_clock::time_point frameStart);
 };
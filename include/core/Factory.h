@@ -9,6 +9,8 @@
 #include "gfx/IVertexArray.h"
 #include "gfx/RendererAPI.h"
 #include "gfx/ITexture2D.h"
+#include "gfx/ITextureArray.h"
+#include "gfx/IRenderTarget.h"
 #include "audio/IAudioDevice.h"
 
 class Factory {
@@ -27,6 +29,8 @@ public:
   static Ref<IBuffer> CreateBuffer(BufferType type);
   static Ref<IVertexArray> CreateVertexArray();
   static std::shared_ptr<ITexture2D>   CreateTexture2D();
+  static std::shared_ptr<ITextureArray> CreateTextureArray();
+  static Ref<IRenderTarget> CreateRenderTarget();
 
   static std::unique_ptr<RendererAPI>  CreateRendererAPI();
 
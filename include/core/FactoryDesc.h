@@ -6,7 +6,8 @@ enum class WindowAPI {
   GLFW,
   Native,
   Android,
-  IOS
+  IOS,
+  Offscreen   // EGL surfaceless GL context, no display (KASINO_HAS_EGL builds)
 };
 
 enum class GraphicsAPI{
@@ -51,4 +52,9 @@ struct FactoryDesc{
   int  glMajor = 3;
   int  glMinor = 3;
   bool glDebug = false;    
+
+  // Linked shader programs are cached on disk (GL); empty dir picks the platform's
+  // per-user cache location
+  bool shaderCache = true;
+  std::string shaderCacheDir;
 };
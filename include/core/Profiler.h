@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Scoped CPU zones. Each thread writes into its own ring (no locks on the hot path;
+// the ring is registered once, under a mutex, on the thread's first zone). Readers
+// (overlay, trace export) copy the rings; a zone overwritten while being copied can
+// come out torn, which is fine for a debugging tool.
+//
+// The EN_PROFILE_* macros compile to nothing unless KASINO_PROFILE is defined (CMake
+// sets it outside Release builds), so release code pays nothing.
+class Profiler {
+public:
+  struct Zone {
+    const char* Name;      // string literal / __func__, never freed
+    uint64_t    StartNs;
+    uint64_t    EndNs;
+    uint32_t    ThreadId;
+    uint16_t    Depth;
+  };
+
+  static constexpr size_t FrameHistory = 240;
+
+  struct FrameSummary {
+    std::array<float, FrameHistory> FrameMs{};  // ring, newest at (Head - 1)
+    size_t   Head  = 0;
+    size_t   Count = 0;
+    uint64_t Frames = 0;
+  };
+
+  static void SetEnabled(bool enable);
+  static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+  static uint64_t NowNs();
+  static void Record(const char* name, uint64_t startNs, uint64_t endNs, uint16_t depth);
+
+  // Brackets one frame's work on the calling thread (the "main" thread for the
+  // overlay); idle waits and pacing belong outside.
+  static void BeginFrame();
+  static void EndFrame();
+  static FrameSummary GetFrameSummary();
+
+  // Zones of the last finished frame on the frame thread, in start order.
+  static std::vector<Zone> LastFrameZones();
+  // Every zone still in the rings, all threads.
+  static std::vector<Zone> Snapshot();
+
+  // chrome://tracing / Perfetto "traceEvents" JSON
+  static bool WriteChromeTrace(const std::string& path);
+
+private:
+  static std::atomic<bool> s_Enabled;
+};
+
+class ProfileScope {
+public:
+  explicit ProfileScope(const char* name);
+  ~ProfileScope();
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  const char* m_Name;
+  uint64_t    m_Start;
+  bool        m_Active;
+};
+
+#define EN_PROFILE_CONCAT_INNER(a, b) a##b
+#define EN_PROFILE_CONCAT(a, b) EN_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef KASINO_PROFILE
+#define EN_PROFILE_ZONE(name) ::ProfileScope EN_PROFILE_CONCAT(_enProfileZone, __LINE__)(name)
+#define EN_PROFILE_FUNCTION() EN_PROFILE_ZONE(__func__)
+#define EN_PROFILE_FRAME_BEGIN() ::Profiler::BeginFrame()
+#define EN_PROFILE_FRAME_END()   ::Profiler::EndFrame()
+#else
+#define EN_PROFILE_ZONE(name) ((void)0)
+#define EN_PROFILE_FUNCTION() ((void)0)
+#define EN_PROFILE_FRAME_BEGIN() ((void)0)
+#define EN_PROFILE_FRAME_END()   ((void)0)
+#endif
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <vector>
 #include <mutex>
@@ -47,6 +48,9 @@ public:
 
   void EmitClose() { call(dummy, m_OnWindowClose); }
 
+  // Bumped by every Emit, so a frame loop can tell whether anything arrived.
+  uint64_t Generation() const { return m_Generation; }
+
 public:
   int OnKeyDown(Handler<EKey> cb)   { m_OnKeyDown.emplace_back(std::move(cb)); return (int)m_OnKeyDown.size()-1; }
   int OnKeyUp(Handler<EKey> cb)     { m_OnKeyUp.emplace_back(std::move(cb));   return (int)m_OnKeyUp.size()-1; }
@@ -58,6 +62,7 @@ private:
   template <typename T>
     void call(const T& e, std::vector<Handler<T>>& handlers){
     std::lock_guard<std::mutex> lock(mutex());
+    ++m_Generation;
     for (auto &h : handlers)
       if (h)
 	h(e);
@@ -81,6 +86,7 @@ private:
   std::vector<std::function<void(const int &)>> m_OnWindowClose;
   // TODO: add touch  
   const int dummy = 0;
+  uint64_t m_Generation = 0;
 };
 
 // Specializations
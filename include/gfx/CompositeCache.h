@@ -0,0 +1,91 @@
+#pragma once
+#include "core/Types.h"
+#include "gfx/IRenderTarget.h"
+#include "gfx/TextureAtlas.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+class Camera2D;
+
+// Bakes small composites (a card with its border, overlays and labels) into render
+// target pages so each one then draws as a single quad. The caller keys an entry by
+// everything that changes its pixels. On a miss Get queues the draw and returns null;
+// the caller draws the long way that frame and the next BakePending renders the queue.
+// Baked sprites are premultiplied, so draw them with BlendMode::Premultiplied.
+//
+// Pages are shelf-packed at the pixel scale from SetPixelScale. Nothing is evicted one
+// entry at a time: when the pages are full, on Clear (resize) or on a scale change,
+// everything goes and is baked again as it is asked for.
+class CompositeCache {
+public:
+  // Draws the composite with its top-left corner at origin, in logical units.
+  using DrawFn = std::function<void(const glm::vec2& origin)>;
+
+  struct Stats {
+    uint32_t Entries   = 0;   // baked and current
+    uint32_t Bakes     = 0;
+    uint32_t Evictions = 0;   // whole-cache flushes
+  };
+
+  // Creates the pages. Needs the context, so call it before a render thread starts.
+  bool Init(uint32_t pageSize = 2048, uint32_t pageCount = 1);
+  void Shutdown();
+
+  // Target pixels per logical unit; a change evicts everything.
+  void SetPixelScale(float scale);
+  float PixelScale() const { return m_Scale; }
+
+  // The baked sprite for key at size, or null after queueing draw (once per key).
+  const Sprite* Get(uint64_t key, const glm::vec2& size, DrawFn draw);
+  bool HasPending() const { return !m_Pending.empty(); }
+
+  // Renders what Get queued. Call right after BeginScene, before anything is drawn:
+  // it ends that scene and begins a new one with camera. True if anything was baked
+  // or evicted, i.e. retained draw lists recorded since may use stale sprites.
+  bool BakePending(const Camera2D& camera);
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  struct Key {
+    uint64_t id;
+    uint32_t w, h;   // pixels
+    bool operator==(const Key& o) const { return id == o.id && w == o.w && h == o.h; }
+  };
+  struct KeyHash {
+    size_t operator()(const Key& k) const {
+      return (size_t)(k.id * 0x9E3779B97F4A7C15ull ^ ((uint64_t)k.w << 32 | k.h));
+    }
+  };
+  struct Entry {
+    Sprite sprite;
+    bool   baked = false;   // false: queued, or larger than a page
+  };
+  struct Pending {
+    Key       key;
+    glm::vec2 size;
+    DrawFn    draw;
+    int       page = -1;
+    uint32_t  x = 0, y = 0;
+  };
+  struct Page {
+    Ref<IRenderTarget> target;
+    uint32_t shelfX = 0, shelfY = 0, shelfH = 0;
+    bool dirty = false;   // holds evicted pixels; cleared when next drawn into
+  };
+
+  bool place(uint32_t w, uint32_t h, int& page, uint32_t& x, uint32_t& y);
+  void evict();
+
+  uint32_t m_PageSize = 0;
+  float m_Scale = 1.0f;
+  std::vector<Page> m_Pages;
+  std::unordered_map<Key, Entry, KeyHash> m_Entries;
+  std::vector<Pending> m_Pending;
+  Stats m_Stats;
+};
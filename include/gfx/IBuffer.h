@@ -1,9 +1,22 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 enum class BufferType { Vertex, Index };
 
+// How Stream() gets data to the GPU without waiting for draws that still read the buffer.
+//   Orphan:     append into fresh space, reallocate the storage when it wraps
+//   Ring:       N segments guarded by fences, written with unsynchronized maps
+//   Persistent: one coherent mapping, fenced segments; maps fresh storage when busy
+enum class StreamMode { Auto, Orphan, Ring, Persistent };
+
+struct BufferStreamStats {
+  std::size_t Bytes  = 0;   // total streamed
+  uint32_t Orphans   = 0;   // storage reallocations
+  uint32_t Stalls    = 0;   // the next segment was still in use by the GPU (then orphaned)
+};
+
 class IBuffer {
 public:
   virtual ~IBuffer() = default;
@@ -13,6 +26,15 @@ public:
                        bool dynamic = false) = 0;
   // Update a subrange; buffer must have been created with SetData first.
   virtual void UpdateSubData(std::size_t byteOffset, const void* data, std::size_t bytes) = 0;                       
+
+  // Turns the buffer into a streaming ring of `capacity` bytes (contents are discarded).
+  // Auto picks the best mode the backend supports.
+  virtual void InitStreaming(std::size_t capacity, StreamMode mode = StreamMode::Auto) = 0;
+  // Appends data and returns the byte offset it landed at; point attributes there.
+  // `bytes` must fit in a third of the capacity.
+  virtual std::size_t Stream(const void* data, std::size_t bytes) = 0;
+  virtual StreamMode GetStreamMode() const = 0;
+  virtual BufferStreamStats GetStreamStats() const = 0;
   virtual void Bind() const = 0;
   virtual void Unbind() const = 0;  
 };
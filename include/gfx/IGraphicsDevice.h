@@ -1,5 +1,7 @@
 #pragma once
 #include "core/FactoryDesc.h"
+#include <cstdint>
+#include <vector>
 class IWindow;
 // class GraphicsAPI;
 
@@ -10,4 +12,11 @@ public:
   virtual bool Initialize(IWindow& window) = 0;
   virtual void BeginFrame(int fbWidth, int fbHeight) = 0;
   virtual void EndFrame() = 0;  
+
+  // Copies the last finished frame as RGBA8, rows top to bottom. Offscreen targets
+  // only: a window's back buffer is undefined after the swap, so that returns false.
+  virtual bool ReadPixels(std::vector<uint8_t>& rgba, int& width, int& height) {
+    (void)rgba; (void)width; (void)height;
+    return false;
+  }
 };
@@ -0,0 +1,24 @@
+#pragma once
+#include "core/Types.h"
+#include "gfx/ITexture2D.h"
+#include <cstdint>
+
+// An RGBA8 texture that can be drawn into. Between Begin and End draws land in
+// Texture() instead of the frame; End puts back the framebuffer and viewport that were
+// current at Begin. Rows are stored bottom-up like any GL framebuffer, so content
+// drawn with a y-up projection samples upright. Begin/End touch the context: go
+// through RenderCommand::Enqueue.
+class IRenderTarget {
+public:
+    virtual ~IRenderTarget() = default;
+
+    virtual bool Create(uint32_t width, uint32_t height) = 0;
+
+    // Viewport covers the whole target; clear = wipe it to transparent first.
+    virtual void Begin(bool clear) = 0;
+    virtual void End() = 0;
+
+    virtual const Ref<ITexture2D>& Texture() const = 0;
+    virtual uint32_t Width()  const = 0;
+    virtual uint32_t Height() const = 0;
+};
@@ -11,6 +11,12 @@ public:
   virtual bool CompileFromSource(const char *vs, const char *fs,
                                  std::string *outLog = nullptr) = 0;
 
+  // false if the last compile/link failed
+  virtual bool IsValid() const = 0;
+  // Backends may compile in the background: false while the driver is still working.
+  // Never blocks; anything else (IsValid, Bind, uniforms) waits for the result.
+  virtual bool IsReady() const { return true; }
+
   virtual void Bind() const = 0;
   virtual void Unbind() const = 0;
 
@@ -19,4 +25,11 @@ public:
   virtual void SetVec2(const char *name, const glm::vec2& v) = 0;
   virtual void SetMat4(const char* name, const glm::mat4& v) = 0;  
   virtual void SetIntArray(const char* name, const int* v, int count) = 0;
+
+  // Uniforms are resolved once at link time. A handle (-1 if the uniform is absent
+  // or optimized out) skips the name lookup; setting an unchanged value is free.
+  virtual int GetUniform(const char* name) const = 0;
+  virtual void SetFloat(int uniform, float v) = 0;
+  virtual void SetVec2(int uniform, const glm::vec2& v) = 0;
+  virtual void SetMat4(int uniform, const glm::mat4& v) = 0;
 };
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+
+// Layered RGBA8 texture (sampler2DArray); every layer has the same size.
+class ITextureArray {
+public:
+    virtual ~ITextureArray() = default;
+
+    // Allocates width x height x layers; layer contents are undefined until SetLayer.
+    virtual bool Create(uint32_t width, uint32_t height, uint32_t layers) = 0;
+
+    // Uploads one whole layer, RGBA8 rows top to bottom.
+    virtual bool SetLayer(uint32_t layer, const void* rgba) = 0;
+
+    virtual void Bind(uint32_t slot) const = 0;
+
+    virtual uint32_t Width()  const = 0;
+    virtual uint32_t Height() const = 0;
+    virtual uint32_t Layers() const = 0;
+};
@@ -11,4 +11,7 @@ public:
     // index: shader location; comps: 1..4; type: GL_FLOAT (pass-through as unsigned int)
     virtual void EnableAttrib(unsigned int index, int comps, unsigned int type,
                               bool normalized, int stride, std::size_t offset) = 0;
+
+    // 0 = per vertex (default), 1 = advance once per instance
+    virtual void SetAttribDivisor(unsigned int index, unsigned int divisor) = 0;
 };
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// RGBA8, rows top to bottom: what IGraphicsDevice::ReadPixels returns.
+struct Image {
+  int Width = 0;
+  int Height = 0;
+  std::vector<uint8_t> Pixels;
+};
+
+struct ImageDiff {
+  bool     SizeMismatch = false;
+  uint64_t Differing = 0;   // pixels with a channel off by more than the tolerance
+  int      MaxDelta = 0;    // largest channel difference seen
+};
+
+// Uncompressed (stored) PNG: bigger than it needs to be, but exact and dependency-free.
+bool WritePNG(const std::string& path, const Image& image);
+// Anything stb_image reads, converted to RGBA8.
+bool ReadImage(const std::string& path, Image& out);
+// tolerance absorbs rasterizer rounding between drivers; 0 demands identical pixels
+ImageDiff CompareImages(const Image& a, const Image& b, int tolerance = 0);
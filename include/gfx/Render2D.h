@@ -1,6 +1,8 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <atomic>
 #include <memory>
+#include <span>
 #include <vector>
 #include <cstdint>
 
@@ -8,6 +10,9 @@
 #include "gfx/IBuffer.h"
 #include "gfx/IShader.h"
 #include "gfx/ITexture2D.h"
+#include "gfx/ITextureArray.h"
+#include "gfx/TextureAtlas.h"
+#include "gfx/RendererAPI.h"
 
 template<typename T> using Ref = std::shared_ptr<T>;
 class Camera2D;
@@ -36,6 +41,53 @@ public:
     uint32_t DrawCalls   = 0;
     uint32_t QuadCount   = 0;
     uint32_t TextureBinds= 0;
+    uint32_t UploadBytes = 0;
+    uint32_t UploadStalls= 0;   // flushes whose ring segment was still in use by the GPU
+    // GPU time of a recent frame, from timer queries (0 when the backend has none)
+    float    GpuFrameMs  = 0.0f;
+    float    GpuFlushMs  = 0.0f;   // all Flush calls of that frame
+    uint32_t GpuFlushes  = 0;
+  };
+
+  // Per-quad record for the instanced path (52 bytes vs 4 * 48 for QuadVertex).
+  // The axes are the transformed unit edges, so any 2D affine transform fits.
+  struct QuadInstance {
+    glm::vec2 Origin;     // aOrigin: world position of local (0,0)
+    glm::vec2 AxisX;      // aAxisX:  world offset of local (1,0)
+    glm::vec2 AxisY;      // aAxisY:  world offset of local (0,1)
+    glm::vec4 UVRect;     // aUVRect: u0, v0, u1, v1
+    uint32_t  Color;      // aColor:  RGBA8
+    float     TexIndex;   // aTexIndex
+    float     Tiling;     // aTiling
+  };
+
+  // One quad for DrawQuads. Rotation turns the quad about its center (like the card
+  // transforms); 0 takes the axis-aligned path.
+  struct SpriteDesc {
+    glm::vec2     Position{0.0f};      // top-left before rotation
+    glm::vec2     Size{1.0f};
+    float         Rotation = 0.0f;     // radians
+    glm::vec4     Color{1.0f};         // flat color, or tint for Image
+    const Sprite* Image    = nullptr;  // null: flat color quad
+  };
+
+  // Retained block of quads (BeginDrawList/EndDrawList). Replaying it skips the
+  // per-quad transform and texture work; re-record when the version changes.
+  class DrawList {
+  public:
+    bool IsCurrent(uint64_t version) const { return m_Recorded && m_Version == version; }
+    void Invalidate() { m_Recorded = false; }
+    uint32_t QuadCount() const { return (uint32_t)m_Quads.size(); }
+    uint16_t LayerSpan() const { return m_LayerSpan; }
+
+  private:
+    friend class Render2D;
+    std::vector<QuadInstance>    m_Quads;     // TexIndex unused; see m_Keys
+    std::vector<uint32_t>        m_Keys;      // layer offset:16 | blend:4 | texture:12
+    std::vector<Ref<ITexture2D>> m_Textures;
+    uint64_t m_Version   = 0;
+    uint16_t m_LayerSpan = 0;
+    bool     m_Recorded  = false;
   };
 
 public:
@@ -51,7 +103,8 @@ public:
   static void DrawQuad(const glm::vec2& pos, const glm::vec2& size, const glm::vec4& color);
   static void DrawQuad(const glm::vec3& pos, const glm::vec2& size, const glm::vec4& color);
 
-  // Textured quad
+  // Textured quad. The per-vertex path carries tilingFactor in 8.8 fixed point, so
+  // keep it within [0, 256) and to multiples of 1/256 to match the instanced path.
   static void DrawQuad(const glm::vec2& pos, const glm::vec2& size, const Ref<ITexture2D>& tex,
 		       float tilingFactor = 1.0f, const glm::vec4& tint = glm::vec4(1.0f));
   static void DrawQuad(const glm::vec3& pos, const glm::vec2& size, const Ref<ITexture2D>& tex,
@@ -62,44 +115,172 @@ public:
   static void DrawQuad(const glm::mat4& transform, const Ref<ITexture2D>& tex,
 		       float tilingFactor = 1.0f, const glm::vec4& tint = glm::vec4(1.0f));
 
+  // One character of the built-in 5px-high font; (pos) is the top-left, each font pixel
+  // is scale x scale. The font lives in the white texture, so text batches with flat quads.
+  static void DrawGlyph(const glm::vec2& pos, float scale, char c, const glm::vec4& color);
+  // Builds the quad DrawGlyph would draw; false for blank glyphs (space).
+  static bool MakeGlyphQuad(const glm::vec2& pos, float scale, char c, QuadInstance& out);
+  // Prebuilt glyph quads (MakeGlyphQuad), moved by offset and recolored; copied into the
+  // batch in bulk.
+  static void DrawGlyphQuads(const QuadInstance* quads, size_t count, const glm::vec2& offset,
+                             const glm::vec4& color);
+
+  // Many quads in one call: textures are resolved once per run of equal textures and
+  // the records are written straight into the batch (or the deferred queue).
+  static void DrawQuads(std::span<const SpriteDesc> sprites);
+
+  // Atlas sprite (sub-rectangle of a texture)
+  static void DrawQuad(const glm::vec2& pos, const glm::vec2& size, const Sprite& sprite,
+		       const glm::vec4& tint = glm::vec4(1.0f));
+  static void DrawQuad(const glm::mat4& transform, const Sprite& sprite,
+		       const glm::vec4& tint = glm::vec4(1.0f));
+
+  // Deferred mode: DrawQuad only records the quad with a 64-bit key
+  //   layer:16 | blend:4 | texture:12 | submission order:32
+  // and the queue is sorted and batched at EndScene/Flush. Layers paint in order; inside
+  // a layer quads are grouped by blend mode and texture, keeping submission order per
+  // texture. So quads that overlap must share a texture or sit on different layers.
+  static void SetDeferred(bool enable);
+  static bool IsDeferred();
+  static void SetLayer(uint16_t layer);
+  static uint16_t GetLayer();
+  static void SetBlendMode(BlendMode mode);
+
+  // Recording: until EndDrawList, quads go into the list instead of the batch. Layers
+  // are stored relative to the current one, so SubmitDrawList replays them above
+  // whatever layer is current then and leaves the layer where recording ended.
+  static void BeginDrawList(DrawList& list, uint64_t version);
+  static void EndDrawList();
+  static void SubmitDrawList(const DrawList& list);
+
+  // Instanced path: one QuadInstance per quad, corners are built in the vertex shader.
+  // On by default; falls back to 4 vertices per quad if the instanced shader fails.
+  static void SetInstancing(bool enable);
+  static bool IsInstancing();
+
+  // Texture-array path (instanced only): textures added as layers are drawn from one
+  // sampler2DArray with the layer as the per-quad index, so those batches do a single
+  // fetch and never run out of slots. Other textures keep the 16-slot path; a batch
+  // switches path (and flushes) when the next quad's texture is on the other one.
+  static bool EnableTextureArray(uint32_t layerWidth, uint32_t layerHeight, uint32_t maxLayers);
+  static bool AcceptsArrayLayer(uint32_t width, uint32_t height);  // enabled, size matches, room left
+  // Copies rgba (RGBA8, layer-sized) into the next layer; texture stays the key callers
+  // draw with and the slot-path fallback.
+  static bool AddArrayLayer(const Ref<ITexture2D>& texture, const void* rgba);
+  // The built-in font image; once a copy of it sits inside an array layer (sprite),
+  // flat quads and text batch with that layer's textures too.
+  static const uint32_t* FontPixels(uint32_t& width, uint32_t& height);
+  static bool HasArrayFont();
+  static bool SetArrayFont(const Sprite& sprite);
+
+  // Counters accumulate until ResetStats; the Gpu* fields are always the latest readback.
   static void ResetStats();
   static Statistics GetStats();
 
 private:
+  // Per-vertex path, packed to 20 bytes (was 48 with float color/UV and a vec3 position)
   struct QuadVertex {
-    glm::vec3 Position;   // aPos
-    glm::vec4 Color;      // aColor
-    glm::vec2 TexCoord;   // aUV
-    float     TexIndex;   // aTexIndex
-    float     Tiling;     // aTiling
+    glm::vec2 Position;      // aPos
+    uint32_t  Color;         // aColor:    RGBA8, normalized
+    uint16_t  TexCoord[2];   // aUV:       unorm16
+    uint8_t   TexIndex;      // aTexIndex: slot
+    uint8_t   Pad;
+    uint16_t  Tiling;        // aTiling:   8.8 fixed point (256 = 1.0)
+  };
+  static_assert(sizeof(QuadVertex) == 20, "QuadVertex layout is mirrored in basic.glsl");
+
+  struct QueuedQuad {
+    uint64_t Key;
+    uint32_t Index;       // into s_Queue
+  };
+
+  struct ArrayTexture {
+    Ref<ITexture2D> Texture;
+    float     Layer;
+    glm::vec4 UVMap;      // offset.xy, scale.zw into the layer; (0,0,1,1) for whole layers
   };
 
+  static void BuildWhiteTexture();
+  static void FlushBatch();
+  static void SubmitQueue();
   static void StartBatch();
+  static void BindVertexLayout(size_t base);
+  static void BindInstanceLayout(size_t base);
   static void NextBatch();
   static float GetTextureIndexOrAppend(const Ref<ITexture2D>& texture);
-  static void PushQuad(const glm::mat4& transform,
-		       const glm::vec4& color,
-		       float texIndex,
-		       float tiling);
+  static const ArrayTexture* BatchTexture(const Ref<ITexture2D>& texture, float& texIndex);
+  static void MapArrayUV(const ArrayTexture& entry, glm::vec4& uv);
+  static void SubmitQuad(const glm::mat4& transform,
+			 const glm::vec4& color,
+			 const Ref<ITexture2D>& texture,
+			 float tiling,
+			 const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+  static void Submit(QuadInstance q, const Ref<ITexture2D>& texture);
+  static void MakeQuad(const glm::vec2& pos, const glm::vec2& size, float rotation, QuadInstance& q);
+  static const Ref<ITexture2D>& SpriteTexture(const SpriteDesc& s);
+  static void MakeSpriteQuad(const SpriteDesc& s, QuadInstance& q);
+  static void PushQuad(const QuadInstance& q);
+  static void Enqueue(const QuadInstance& q, const Ref<ITexture2D>& texture);
+  static uint32_t QueueTextureId(const Ref<ITexture2D>& texture);
+  static uint32_t PackColor(const glm::vec4& color);
 
 private:
-  static inline const uint32_t MaxQuads     = 20000;                     // Hazel default-ish
+  static inline const uint32_t MaxQuads     = 16384;                     // 4 * MaxQuads vertices fit 16-bit indices
   static inline const uint32_t MaxVertices  = MaxQuads * 4;
   static inline const uint32_t MaxIndices   = MaxQuads * 6;
   static inline const uint32_t MaxTexSlots  = 16;                        // keep 16, matches shader ladder
 
+private:
+  // One flushed batch: everything the GL side needs, so it can run later on the render
+  // thread. Data points into the staging arrays, or into the recording list's payload.
+  struct BatchDraw {
+    const void*     Data = nullptr;
+    size_t          Bytes = 0;
+    uint32_t        Quads = 0;
+    uint32_t        TextureCount = 0;
+    bool            Instanced = false;
+    bool            Array = false;
+    glm::mat4       ViewProj{1.0f};
+    Ref<ITexture2D> Textures[MaxTexSlots];
+  };
+
+  static void DrawBatch(const BatchDraw& draw);
+
 private:
   // GPU
   static Ref<IVertexArray> s_VAO;
   static Ref<IBuffer>      s_VBO;
   static Ref<IBuffer>      s_IBO;
   static Ref<IShader>      s_Shader;
+  static int               s_ShaderViewProj;       // uniform handles, resolved at init
+
+  // Instanced path (shares s_IBO: its first 6 indices are the unit quad)
+  static Ref<IVertexArray> s_InstanceVAO;
+  static Ref<IBuffer>      s_InstanceVBO;
+  static Ref<IBuffer>      s_UnitQuadVBO;
+  static Ref<IShader>      s_InstanceShader;
+  static int               s_InstanceViewProj;
+  static bool              s_UseInstancing;
 
-  // White 1x1
+  // White block + built-in font
   static Ref<ITexture2D>   s_WhiteTexture;
+  static glm::vec4         s_WhiteUV;
+  static glm::vec4         s_GlyphUV[128];
+  static bool              s_GlyphEmpty[128];
+  static std::vector<uint32_t> s_FontPixels;
+  static uint32_t          s_FontWidth, s_FontHeight;
+
+  // Texture array
+  static Ref<ITextureArray>        s_TextureArray;
+  static Ref<IShader>              s_ArrayShader;
+  static int                       s_ArrayViewProj;
+  static std::vector<ArrayTexture> s_ArrayTextures;
+  static uint32_t                  s_ArrayLayerCount;
+  static bool                      s_BatchArray;    // current batch samples the array
 
   // CPU staging
   static std::vector<QuadVertex> s_CPUBuffer;
+  static std::vector<QuadInstance> s_Instances;
   static uint32_t                s_QuadCount;
 
   // Texture slots
@@ -109,8 +290,24 @@ private:
   // Scene
   static glm::mat4 s_ViewProj;
 
-  // Stats
+  // Deferred queue
+  static uint16_t  s_Layer;
+  static BlendMode s_Blend;        // requested
+  static BlendMode s_ActiveBlend;  // last sent to the API
+  static bool      s_Deferred;
+  static std::vector<QuadInstance> s_Queue;
+  static std::vector<QueuedQuad>   s_QueueKeys;
+  static std::vector<Ref<ITexture2D>> s_QueueTextures;
+  static std::vector<uint32_t>     s_ListTexIds;   // SubmitDrawList scratch
+
+  // Draw list being recorded (null when not recording)
+  static DrawList* s_Recording;
+  static uint16_t  s_RecordLayer;   // layer at BeginDrawList
+  static BlendMode s_RecordBlend;   // blend at BeginDrawList
+
+  // Stats (UploadStalls is counted where the upload runs, possibly the render thread)
   static Statistics s_Stats;
+  static std::atomic<uint32_t> s_StreamStalls;
 
   static bool s_Initialized;
 };
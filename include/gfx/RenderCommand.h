@@ -1,6 +1,8 @@
 #pragma once
 #include <memory>
+#include <utility>
 #include "gfx/RendererAPI.h"
+#include "gfx/RenderCommandList.h"
 
 class RenderCommand {
 public:
@@ -12,9 +14,33 @@ public:
   static void Clear();
 
   static void EnableBlend(bool e);
+  static void SetBlendMode(BlendMode mode);
 
-  static void DrawIndexed(const IVertexArray& vao, std::uint32_t indexCount);
+  static void DrawIndexed(const IVertexArray& vao, std::uint32_t indexCount,
+                          IndexType type = IndexType::U32);
+  static void DrawIndexedInstanced(const IVertexArray& vao, std::uint32_t indexCount,
+                                   std::uint32_t instanceCount, IndexType type = IndexType::U32);
+
+  static void BeginGpuFrame();
+  static void EndGpuFrame();
+  static void BeginGpuPass();
+  static void EndGpuPass();
+  static GpuTimings GetGpuTimings();
+
+  // Threaded rendering: while a list is set on a thread, the calls above (and Enqueue)
+  // made from that thread are recorded into it instead of reaching the API, and run
+  // when the render thread executes the list.
+  static void SetRecording(RenderCommandList* list) { s_Recording = list; }
+  static RenderCommandList* Recording() { return s_Recording; }
+
+  // Runs fn now, or records it; anything fn reads from the caller must be captured by value.
+  template <typename F>
+  static void Enqueue(F&& fn) {
+    if (s_Recording) s_Recording->Record(std::forward<F>(fn));
+    else fn();
+  }
 
 private:
   static std::unique_ptr<RendererAPI> s_API;
+  static thread_local RenderCommandList* s_Recording;
 };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// One frame of recorded render work: closures that Execute runs in order, plus payload
+// memory (vertex data, copied state) that stays valid until Reset. Everything lives in
+// fixed blocks that are kept between frames, so a warmed-up list records without
+// allocating and nothing recorded ever moves.
+class RenderCommandList {
+public:
+  RenderCommandList() = default;
+  ~RenderCommandList() { Reset(); }
+
+  RenderCommandList(const RenderCommandList&) = delete;
+  RenderCommandList& operator=(const RenderCommandList&) = delete;
+
+  // fn() runs on Execute; captures are stored in the list and destroyed by Reset.
+  template <typename F>
+  void Record(F&& fn) {
+    using Fn = std::decay_t<F>;
+    static_assert(alignof(Fn) <= kMaxAlign, "over-aligned render command");
+    Fn* obj = new (Allocate(sizeof(Fn), alignof(Fn))) Fn(std::forward<F>(fn));
+    m_Commands.push_back({ obj,
+                           [](void* p) { (*static_cast<Fn*>(p))(); },
+                           [](void* p) { static_cast<Fn*>(p)->~Fn(); } });
+  }
+
+  // Raw payload space, valid until Reset; align must not exceed 16.
+  void* Allocate(std::size_t bytes, std::size_t align = kMaxAlign);
+
+  // Runs every command in recording order; the list keeps its contents.
+  void Execute();
+  // Destroys the commands and rewinds the blocks for the next frame.
+  void Reset();
+
+  bool        Empty() const { return m_Commands.empty(); }
+  std::size_t CommandCount() const { return m_Commands.size(); }
+  std::size_t BytesUsed() const { return m_Used; }
+
+private:
+  struct Command {
+    void* Object;
+    void (*Run)(void*);
+    void (*Destroy)(void*);
+  };
+
+  struct Block {
+    std::unique_ptr<std::byte[]> Data;   // operator new[]: 16-byte aligned
+    std::size_t Size;
+  };
+
+  static constexpr std::size_t kMaxAlign  = 16;
+  static constexpr std::size_t kBlockSize = 256 * 1024;
+
+  std::vector<Command> m_Commands;
+  std::vector<Block>   m_Blocks;
+  std::size_t m_Block  = 0;    // block being filled
+  std::size_t m_Offset = 0;    // into it
+  std::size_t m_Used   = 0;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "gfx/RenderCommandList.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+class IWindow;
+
+// Owns the GL context on a thread of its own and executes recorded frames there. The
+// main thread records frame N into one list while this thread executes frame N-1 from
+// the other; Submit only blocks while the previous frame is still executing, so at
+// most one frame is in flight and a frame costs max(update + record, execute) rather
+// than their sum.
+class RenderThread {
+public:
+  struct Stats {
+    uint64_t Frames        = 0;
+    float    LastExecuteMs = 0.0f;   // render thread, last list
+    float    LastWaitMs    = 0.0f;   // main thread blocked in the last Submit
+    uint32_t LastCommands  = 0;
+    uint32_t LastBytes     = 0;      // payload recorded into the last list
+  };
+
+  explicit RenderThread(IWindow& window);
+  ~RenderThread();
+
+  RenderThread(const RenderThread&) = delete;
+  RenderThread& operator=(const RenderThread&) = delete;
+
+  // Moves the context from the calling thread to the render thread; false (context
+  // back on the caller) if the window can't make it current there.
+  bool Start();
+  // Executes what was submitted, joins, and makes the context current on the caller.
+  void Stop();
+  bool IsRunning() const { return m_Thread.joinable(); }
+
+  // The list the main thread records into this frame.
+  RenderCommandList& Recording() { return m_Lists[m_RecordIndex]; }
+  // Hands Recording() to the render thread and flips to the other list.
+  void Submit();
+  // Blocks until every submitted list has executed.
+  void WaitIdle();
+
+  Stats GetStats() const;
+
+private:
+  void threadMain();
+
+  IWindow& m_Window;
+  std::thread m_Thread;
+
+  mutable std::mutex      m_Mutex;
+  std::condition_variable m_Cv;
+  RenderCommandList       m_Lists[2];
+  int                     m_RecordIndex = 0;
+  RenderCommandList*      m_Pending     = nullptr;   // submitted, not finished
+  bool                    m_Quit        = false;
+  int                     m_ContextState = 0;        // 0 pending, 1 current, -1 failed
+  Stats                   m_Stats;
+};
@@ -5,6 +5,20 @@
 #include "core/FactoryDesc.h"
 class IVertexArray;
 
+// Alpha keeps coverage in the destination alpha (1 - (1-a)(1-b)), so what is drawn into
+// a transparent render target comes out premultiplied; draw that with Premultiplied.
+enum class BlendMode : std::uint8_t { Alpha = 0, Additive = 1, None = 2, Premultiplied = 3 };
+enum class IndexType : std::uint8_t { U32 = 0, U16 = 1 };
+
+// GPU time of the newest frame whose queries have come back (a few frames old).
+struct GpuTimings {
+    bool          Supported = false;
+    float         FrameMs   = 0.0f;   // BeginGpuFrame .. EndGpuFrame
+    float         PassMs    = 0.0f;   // sum of the frame's passes
+    std::uint32_t Passes    = 0;
+    std::uint32_t Dropped   = 0;      // frames whose results weren't back in time (total)
+};
+
 class RendererAPI{
 public:
     virtual ~RendererAPI() = default;
@@ -17,7 +31,21 @@ public:
     virtual void Clear() = 0;
 
     virtual void EnableBlend(bool enable) = 0;
+    virtual void SetBlendMode(BlendMode mode) = 0;
 
     // Draw indexed using currently bound VAO & index buffer
-    virtual void DrawIndexed(const IVertexArray& vao, std::uint32_t indexCount) = 0;
+    virtual void DrawIndexed(const IVertexArray& vao, std::uint32_t indexCount,
+                             IndexType type = IndexType::U32) = 0;
+    // Same, repeated instanceCount times (attributes with a divisor advance per instance)
+    virtual void DrawIndexedInstanced(const IVertexArray& vao, std::uint32_t indexCount,
+                                      std::uint32_t instanceCount,
+                                      IndexType type = IndexType::U32) = 0;
+
+    // GPU timing. Results are read back frames later, never waited on; backends without
+    // timer queries keep the no-op defaults and report Supported = false.
+    virtual void BeginGpuFrame() {}
+    virtual void EndGpuFrame() {}
+    virtual void BeginGpuPass() {}
+    virtual void EndGpuPass() {}
+    virtual GpuTimings GetGpuTimings() const { return {}; }
 };
\ No newline at end of file
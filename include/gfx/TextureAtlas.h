@@ -0,0 +1,58 @@
+#pragma once
+#include "core/Types.h"
+#include "gfx/ITexture2D.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A region of a texture. Render2D::DrawQuad takes these directly, so sprites that share
+// an atlas page share a texture slot and stay in one batch.
+struct Sprite {
+  Ref<ITexture2D> Texture;
+  glm::vec4 UV{0.0f, 0.0f, 1.0f, 1.0f}; // u0, v0, u1, v1
+  glm::vec2 Size{0.0f, 0.0f};           // source size in pixels
+
+  explicit operator bool() const { return (bool)Texture; }
+};
+
+// Packs images into one or more RGBA8 pages with a shelf packer. Add images, call
+// Build() once to upload, then fetch sprites by the id Add returned. Each image gets a
+// 1px border copied from its own edge pixels so filtering never picks up a neighbour.
+class TextureAtlas {
+public:
+  explicit TextureAtlas(uint32_t pageWidth = 2048, uint32_t pageHeight = 2048);
+
+  // Returns a sprite id, or -1 if the image could not be loaded or does not fit a page.
+  int AddFromFile(const std::string& path, bool flipY = false);
+  int Add(uint32_t width, uint32_t height, const uint8_t* rgba, bool flipY = false);
+
+  // Array mode: pages keep their full size and Build also adds them as layers of
+  // Render2D's texture array (enabled beforehand with the page size), packing the
+  // built-in font in beside the images. Without a matching array this is a no-op.
+  void SetTextureArray(bool enable) { m_TextureArray = enable; }
+
+  // Uploads every page (trimmed to the used height) and frees the CPU copies.
+  bool Build();
+
+  Sprite Get(int id) const;
+  size_t PageCount() const { return m_Pages.size(); }
+
+private:
+  struct Page {
+    std::vector<uint8_t> pixels;
+    uint32_t shelfX = 0, shelfY = 0, shelfH = 0;
+    uint32_t usedH = 0;
+    Ref<ITexture2D> texture;
+  };
+  struct Entry { int page; uint32_t x, y, w, h; };
+
+  bool place(uint32_t w, uint32_t h, int& page, uint32_t& x, uint32_t& y);
+
+  uint32_t m_PageW, m_PageH;
+  std::vector<Page> m_Pages;
+  std::vector<Entry> m_Entries;
+  bool m_Built = false;
+  bool m_TextureArray = false;
+};
@@ -2,6 +2,7 @@
 #include "gfx/IBuffer.h"
 
 using GLuint = unsigned int;
+typedef struct __GLsync *GLsync;
 
 class GLBuffer : public IBuffer{
 public:
@@ -14,9 +15,33 @@ public:
     void Bind() const override;
     void Unbind() const override;
 
+    void InitStreaming(std::size_t capacity, StreamMode mode = StreamMode::Auto) override;
+    std::size_t Stream(const void* data, std::size_t bytes) override;
+    StreamMode GetStreamMode() const override { return m_Mode; }
+    BufferStreamStats GetStreamStats() const override { return m_Stats; }
+
     GLuint id() const { return m_Id; }
 
+private:
+    static constexpr int kSegments = 3;
+
+    unsigned int target() const;
+    void recreate();                        // fresh buffer name, old one deleted
+    void releaseStreaming();
+    void allocPersistent();                 // storage + mapping, or a Ring fallback
+    void orphan();
+    void nextSegment();
+
 private:
     GLuint m_Id = 0;
     BufferType m_Type;
-};
\ No newline at end of file
+
+    // streaming
+    StreamMode m_Mode = StreamMode::Auto;   // Auto = not streaming
+    std::size_t m_Capacity = 0;
+    std::size_t m_Cursor = 0;
+    int m_Segment = 0;
+    GLsync m_Fences[kSegments] = {};
+    void* m_Mapped = nullptr;               // Persistent only
+    BufferStreamStats m_Stats;
+};
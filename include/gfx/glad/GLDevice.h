@@ -6,17 +6,26 @@
 class GLDevice : public IGraphicsDevice{
  public:
   explicit GLDevice(const FactoryDesc& desc);
+  ~GLDevice() override;
   GraphicsAPI API() const override { return GraphicsAPI::OpenGL; }
   bool Initialize(IWindow& window) override;
   void BeginFrame(int fbWidth, int fbHeight) override;
   void EndFrame() override;
+  bool ReadPixels(std::vector<uint8_t>& rgba, int& width, int& height) override;
 
   void SetClearColor(glm::vec4 color) {
     color = m_Clear;
   }
 
  private:
+  // offscreen target for windows without a default framebuffer
+  bool ensureTarget(int width, int height);
+
   class IWindow* m_Window = nullptr;
+  std::string m_ShaderCacheDir;       // "" when the program cache is off
+  unsigned int m_TargetFbo = 0;
+  unsigned int m_TargetColor = 0;     // RGBA8 renderbuffer
+  int m_TargetW = 0, m_TargetH = 0;
   glm::vec4 m_Clear = {0.08f, 0.09f, 0.10f, 1.0f};
   bool m_Initialized = false;
 };
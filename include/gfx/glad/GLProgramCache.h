@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+using GLuint = unsigned int;
+using GLenum = unsigned int;
+
+// Linked program binaries on disk (glGetProgramBinary / glProgramBinary), one file per
+// program, keyed by a hash of the shader sources and the driver string (vendor,
+// renderer, version), so a driver update just misses. A binary the driver refuses is
+// deleted and the program is built from source again.
+//
+// Also hooks up KHR/ARB_parallel_shader_compile: with it the driver compiles and links
+// on its own threads and IsComplete polls without blocking.
+//
+// Without program binary support or a cache directory, Load always misses and Store
+// does nothing.
+class GLProgramCache {
+public:
+    using GLProc = void* (*)(const char*);
+
+    struct Stats {
+        uint32_t Hits     = 0;
+        uint32_t Misses   = 0;
+        uint32_t Stores   = 0;
+        uint32_t Rejected = 0;   // files present but refused (stale, corrupt)
+    };
+
+    // After the GL loader ran; directory "" disables the disk cache.
+    static void Init(const std::string& directory, GLProc loader);
+    // Per-user cache location for this platform ("" where there is none, e.g. the web).
+    static std::string DefaultDirectory();
+
+    // Order-independent over shader stages.
+    static uint64_t HashSources(const std::unordered_map<GLenum, std::string>& sources);
+
+    // A linked program from the cache, or 0.
+    static GLuint Load(uint64_t sourceHash);
+    // Call before glLinkProgram on programs that may be stored.
+    static void PrepareProgram(GLuint program);
+    // Saves a successfully linked program.
+    static void Store(GLuint program, uint64_t sourceHash);
+
+    static bool ParallelCompile();
+    // True once compile and link of `program` have finished (always, without the extension).
+    static bool IsComplete(GLuint program);
+
+    static Stats GetStats();
+};
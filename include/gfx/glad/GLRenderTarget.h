@@ -0,0 +1,25 @@
+#pragma once
+#include "gfx/IRenderTarget.h"
+using GLuint = unsigned int;
+
+// Framebuffer object with a GLTexture2D as its only color attachment.
+class GLRenderTarget : public IRenderTarget {
+public:
+    GLRenderTarget();
+    ~GLRenderTarget() override;
+
+    bool Create(uint32_t width, uint32_t height) override;
+
+    void Begin(bool clear) override;
+    void End() override;
+
+    const Ref<ITexture2D>& Texture() const override { return m_Texture; }
+    uint32_t Width() const override  { return m_Texture->Width(); }
+    uint32_t Height() const override { return m_Texture->Height(); }
+
+private:
+    GLuint m_Fbo = 0;
+    Ref<ITexture2D> m_Texture;
+    GLuint m_PrevFbo = 0;
+    int m_PrevViewport[4] = {0, 0, 0, 0};
+};
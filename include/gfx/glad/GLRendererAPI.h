@@ -1,12 +1,48 @@
 #pragma once
 #include "gfx/RendererAPI.h"
 
+#include <array>
+#include <vector>
+
 class GLRendererAPI : public RendererAPI {
 public:
+    ~GLRendererAPI() override;
+
     void Init() override;
     void SetViewport(int x,int y,int w,int h) override;
     void SetClearColor(float r,float g,float b,float a) override;
     void Clear() override;
     void EnableBlend(bool enable) override;
-    void DrawIndexed(const class IVertexArray& vao, std::uint32_t indexCount) override;
+    void SetBlendMode(BlendMode mode) override;
+    void DrawIndexed(const class IVertexArray& vao, std::uint32_t indexCount,
+                     IndexType type = IndexType::U32) override;
+    void DrawIndexedInstanced(const class IVertexArray& vao, std::uint32_t indexCount,
+                              std::uint32_t instanceCount,
+                              IndexType type = IndexType::U32) override;
+
+    void BeginGpuFrame() override;
+    void EndGpuFrame() override;
+    void BeginGpuPass() override;
+    void EndGpuPass() override;
+    GpuTimings GetGpuTimings() const override { return m_GpuTimings; }
+
+private:
+    // Timestamp queries of one frame: [0] frame begin, [1] frame end, then begin/end
+    // pairs per pass. Timestamps (not GL_TIME_ELAPSED) because passes nest in the frame.
+    struct TimerFrame {
+        std::vector<unsigned int> Queries;
+        std::uint32_t Used = 0;
+        bool Pending = false;     // ended, results not read yet
+    };
+    static constexpr std::size_t   kTimerFrames = 4;      // read back 3 frames later
+    static constexpr std::uint32_t kMaxPasses   = 64;     // per frame; more go untimed
+
+    unsigned int timestamp(TimerFrame& f);
+    void resolve(TimerFrame& f);
+
+    std::array<TimerFrame, kTimerFrames> m_TimerFrames;
+    std::size_t m_TimerFrame = 0;
+    bool m_InGpuFrame = false;
+    bool m_InGpuPass = false;
+    GpuTimings m_GpuTimings;
 };
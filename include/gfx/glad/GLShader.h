@@ -2,11 +2,17 @@
 
 #include "gfx/IShader.h"
 
+#include <array>
+#include <string_view>
+#include <vector>
+
 using GLuint = unsigned int;
 using GLenum = unsigned int;
 
 class GLShader : public IShader {
 public:
+  // Reads and preprocesses the file, then either loads the linked program from
+  // GLProgramCache or starts compile and link without waiting for the result.
   GLShader(const std::string& filepath);
   ~GLShader() override {}
 
@@ -14,7 +20,10 @@ public:
 
   bool CompileFromSource(const char *vs, const char *fs,
                          std::string *outLog = nullptr) override;
+  // Starts compile and link; status is collected on first use (or IsReady).
   void CompileFromSource(const std::unordered_map<GLenum, std::string>& shaderSources);
+  bool IsValid() const override { return finishLink(); }
+  bool IsReady() const override;
   void Bind() const override;
   void Unbind() const override;
 
@@ -24,11 +33,38 @@ public:
 
   void SetIntArray(const char* name, const int* v, int count) override;
 
+  int GetUniform(const char* name) const override;
+  void SetFloat(int uniform, float v) override;
+  void SetVec2(int uniform, const glm::vec2 &v) override;
+  void SetMat4(int uniform, const glm::mat4 &v) override;
+
 private:
+  struct Uniform {
+    int Location = -1;
+    bool Cached = false;                 // Value holds what the program has
+    std::array<float, 16> Value{};
+  };
+  struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+  };
+
   std::string ReadFile(const std::string &filepath);
   std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);  
-  int uniformLoc(const char *name);
+  // Collects compile/link status of the pending program (waits if the driver isn't done).
+  bool finishLink() const;
+  void resolveUniforms() const;
+  Uniform* uniform(int handle);
+  static bool unchanged(Uniform& u, const float* v, size_t count);
+
+  std::string m_Name;
+  uint64_t    m_SourceHash = 0;
+  mutable std::string m_Log;                 // compile/link errors of the last build
 
-  GLuint m_Program = 0;
-  std::unordered_map<std::string,int> m_Uniforms;  
+  // linked lazily, hence mutable: the first const query may finish the link
+  mutable GLuint m_Program = 0;
+  mutable GLuint m_Pending = 0;              // linking, status not collected yet
+  mutable std::array<GLuint, 2> m_Stages{};  // its shaders
+  mutable std::vector<Uniform> m_UniformSlots;                                    // by handle
+  mutable std::unordered_map<std::string, int, NameHash, std::equal_to<>> m_Uniforms;  // name -> handle
 };
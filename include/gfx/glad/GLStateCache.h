@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+
+using GLuint = unsigned int;
+using GLenum = unsigned int;
+
+// Shadow of the GL state the backend touches. Every bind in src/glad goes through
+// here, so re-binding what is already bound costs a compare instead of a driver call
+// (which is what hurts on WebGL). Deleting an object must Forget it, since GL hands
+// the name out again; code that changes GL state behind our back calls Invalidate.
+//
+// GL_ELEMENT_ARRAY_BUFFER is VAO state and is passed straight through.
+class GLStateCache {
+public:
+    struct Stats {
+        uint32_t Calls   = 0;   // state changes sent to GL
+        uint32_t Skipped = 0;   // redundant ones dropped
+    };
+
+    static void UseProgram(GLuint program);
+    static void BindVertexArray(GLuint vao);
+    static void BindBuffer(GLenum target, GLuint buffer);
+    // Selects unit and binds texture to target (GL_TEXTURE_2D / GL_TEXTURE_2D_ARRAY).
+    static void BindTexture(uint32_t unit, GLenum target, GLuint texture);
+    // Binds on whichever unit is active; for uploads and parameter changes.
+    static void BindTexture(GLenum target, GLuint texture);
+    // srcAlpha/dstAlpha 0: same factors as color (glBlendFunc), else glBlendFuncSeparate.
+    static void SetBlend(bool enable, GLenum src = 0, GLenum dst = 0,
+                         GLenum srcAlpha = 0, GLenum dstAlpha = 0);
+    // GL_FRAMEBUFFER; 0 is the window's own (or whatever the device made current).
+    static void BindFramebuffer(GLuint fbo);
+
+    static GLuint CurrentProgram();
+    static GLuint CurrentFramebuffer();
+
+    static void ForgetProgram(GLuint program);
+    static void ForgetVertexArray(GLuint vao);
+    static void ForgetBuffer(GLuint buffer);
+    static void ForgetTexture(GLuint texture);
+    static void ForgetFramebuffer(GLuint fbo);
+    static void Invalidate();
+
+    static Stats GetStats();
+    static void ResetStats();
+};
@@ -0,0 +1,22 @@
+#pragma once
+#include "gfx/ITextureArray.h"
+using GLuint = unsigned int;
+
+class GLTextureArray : public ITextureArray {
+public:
+    GLTextureArray();
+    ~GLTextureArray() override;
+
+    bool Create(uint32_t w, uint32_t h, uint32_t layers) override;
+    bool SetLayer(uint32_t layer, const void* rgba) override;
+
+    void Bind(uint32_t slot) const override;
+
+    uint32_t Width() const override  { return m_w; }
+    uint32_t Height() const override { return m_h; }
+    uint32_t Layers() const override { return m_layers; }
+
+private:
+    GLuint m_id=0;
+    uint32_t m_w=0, m_h=0, m_layers=0;
+};
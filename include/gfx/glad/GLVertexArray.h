@@ -12,6 +12,7 @@ public:
 
     void EnableAttrib(unsigned int index, int comps, unsigned int type,
                       bool normalized, int stride, std::size_t offset) override;
+    void SetAttribDivisor(unsigned int index, unsigned int divisor) override;
 
 private:
     GLuint m_Id = 0;
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What the null graphics backend was asked to do. Object ids are handed out per
+// backend object (0 = none); A/B carry the op's arguments:
+//   Viewport        A = x | y << 32, B = w | h << 32
+//   Clear           -
+//   Blend           A = BlendMode, or 0xFF for EnableBlend(false) / 0xFE for (true)
+//   BindProgram     Object = shader
+//   Uniform         Object = shader, A = uniform handle
+//   BindTexture     Object = texture, A = slot
+//   BindVertexArray Object = vertex array
+//   BufferData      Object = buffer, A = bytes, B = offset (UpdateSubData)
+//   BufferStream    Object = buffer, A = bytes, B = offset it landed at
+//   TextureUpload   Object = texture, A = bytes, B = layer (arrays)
+//   Draw            Object = vertex array, A = index count, B = IndexType
+//   DrawInstanced   Object = vertex array, A = index count, B = instance count
+//   BindTarget      Object = render target, 0 when End hands back to the frame
+enum class NullOp : uint8_t {
+  BeginFrame, EndFrame,
+  Viewport, Clear, Blend,
+  BindProgram, Uniform, BindTexture, BindVertexArray, BindTarget,
+  BufferData, BufferStream, TextureUpload,
+  Draw, DrawInstanced,
+};
+
+struct NullCommand {
+  NullOp   Op;
+  uint32_t Object;
+  uint64_t A;
+  uint64_t B;
+};
+
+// Recording is an append into a preallocated vector, so the null backend costs
+// about as much as the calls into it. Counters are always kept; the command list
+// only while recording, and only up to the capacity (the rest is counted as
+// dropped) so a soak run can't grow without bound.
+class NullCommandLog {
+public:
+  struct Counters {
+    uint64_t Frames       = 0;
+    uint64_t Commands     = 0;
+    uint64_t Draws        = 0;
+    uint64_t Instances    = 0;   // DrawInstanced only
+    uint64_t Indices      = 0;   // per draw, not multiplied by instances
+    uint64_t UploadBytes  = 0;   // buffer data, streams and texture uploads
+    uint64_t StateChanges = 0;   // binds, blend, uniforms
+    uint64_t Dropped      = 0;   // commands counted but not kept
+  };
+
+  static void SetRecording(bool record) { s_Recording = record; }
+  static bool IsRecording() { return s_Recording; }
+  // Reserves room for maxCommands (default 1M, of which 64K are reserved on first use);
+  // commands past it are dropped until Clear().
+  static void SetCapacity(size_t maxCommands);
+
+  static void Record(NullOp op, uint32_t object = 0, uint64_t a = 0, uint64_t b = 0);
+  static uint32_t NextObjectId() { return ++s_NextId; }
+
+  static const std::vector<NullCommand>& Commands() { return s_Commands; }
+  static const Counters& Totals() { return s_Totals; }
+  // Counters of the last BeginFrame..EndFrame
+  static const Counters& LastFrame() { return s_LastFrame; }
+  static size_t CountOf(NullOp op);
+
+  // Forgets the commands and all counters (object ids keep counting).
+  static void Clear();
+
+  static const char* OpName(NullOp op);
+
+private:
+  static bool                     s_Recording;
+  static size_t                   s_Capacity;
+  static std::vector<NullCommand> s_Commands;
+  static Counters                 s_Totals;
+  static Counters                 s_Frame;      // current frame, in progress
+  static Counters                 s_LastFrame;
+  static uint32_t                 s_NextId;
+};
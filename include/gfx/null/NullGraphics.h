@@ -0,0 +1,166 @@
+#pragma once
+
+#include "core/Types.h"
+#include "gfx/IGraphicsDevice.h"
+#include "gfx/IBuffer.h"
+#include "gfx/IShader.h"
+#include "gfx/IVertexArray.h"
+#include "gfx/ITexture2D.h"
+#include "gfx/ITextureArray.h"
+#include "gfx/IRenderTarget.h"
+#include "gfx/RendererAPI.h"
+#include "gfx/null/NullCommandLog.h"
+
+#include <string_view>
+
+// GraphicsAPI::None: every object accepts what the GL one would and records it into
+// NullCommandLog instead of touching a GPU. Nothing is drawn and nothing can be
+// read back; sizes are kept so layout code sees the same values it would on GL.
+
+class NullDevice : public IGraphicsDevice {
+public:
+  explicit NullDevice(const FactoryDesc& desc);
+  GraphicsAPI API() const override { return GraphicsAPI::None; }
+  bool Initialize(IWindow& window) override;
+  void BeginFrame(int fbWidth, int fbHeight) override;
+  void EndFrame() override;
+
+private:
+  IWindow* m_Window = nullptr;
+};
+
+class NullRendererAPI : public RendererAPI {
+public:
+  void Init() override {}
+  void SetViewport(int x, int y, int w, int h) override;
+  void SetClearColor(float, float, float, float) override {}
+  void Clear() override;
+  void EnableBlend(bool enable) override;
+  void SetBlendMode(BlendMode mode) override;
+  void DrawIndexed(const IVertexArray& vao, std::uint32_t indexCount,
+                   IndexType type = IndexType::U32) override;
+  void DrawIndexedInstanced(const IVertexArray& vao, std::uint32_t indexCount,
+                            std::uint32_t instanceCount,
+                            IndexType type = IndexType::U32) override;
+};
+
+class NullBuffer : public IBuffer {
+public:
+  explicit NullBuffer(BufferType type) : m_Type(type) {}
+
+  BufferType Type() const override { return m_Type; }
+  void SetData(const void* data, std::size_t bytes, bool dynamic = false) override;
+  void UpdateSubData(std::size_t byteOffset, const void* data, std::size_t bytes) override;
+  void InitStreaming(std::size_t capacity, StreamMode mode = StreamMode::Auto) override;
+  std::size_t Stream(const void* data, std::size_t bytes) override;
+  StreamMode GetStreamMode() const override { return StreamMode::Orphan; }
+  BufferStreamStats GetStreamStats() const override { return m_Stats; }
+  void Bind() const override {}
+  void Unbind() const override {}
+
+  uint32_t Id() const { return m_Id; }
+
+private:
+  BufferType m_Type;
+  uint32_t m_Id = NullCommandLog::NextObjectId();
+  std::size_t m_Capacity = 0;
+  std::size_t m_Head = 0;
+  BufferStreamStats m_Stats;
+};
+
+class NullVertexArray : public IVertexArray {
+public:
+  void Bind() const override;
+  void Unbind() const override {}
+  void EnableAttrib(unsigned int, int, unsigned int, bool, int, std::size_t) override {}
+  void SetAttribDivisor(unsigned int, unsigned int) override {}
+
+  uint32_t Id() const { return m_Id; }
+
+private:
+  uint32_t m_Id = NullCommandLog::NextObjectId();
+};
+
+class NullShader : public IShader {
+public:
+  explicit NullShader(const std::string& filepath) : m_Path(filepath) {}
+
+  void Destroy() override {}
+  bool CompileFromSource(const char*, const char*, std::string* = nullptr) override { return true; }
+  bool IsValid() const override { return true; }
+
+  void Bind() const override;
+  void Unbind() const override {}
+
+  void SetFloat(const char* name, float v) override { SetFloat(GetUniform(name), v); }
+  void SetVec2(const char* name, const glm::vec2& v) override { SetVec2(GetUniform(name), v); }
+  void SetMat4(const char* name, const glm::mat4& v) override { SetMat4(GetUniform(name), v); }
+  void SetIntArray(const char* name, const int* v, int count) override;
+
+  // No program to query, so every name gets a handle on first use.
+  int GetUniform(const char* name) const override;
+  void SetFloat(int uniform, float) override { record(uniform); }
+  void SetVec2(int uniform, const glm::vec2&) override { record(uniform); }
+  void SetMat4(int uniform, const glm::mat4&) override { record(uniform); }
+
+  const std::string& Path() const { return m_Path; }
+  uint32_t Id() const { return m_Id; }
+
+private:
+  struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+  };
+
+  void record(int uniform) const;
+
+  std::string m_Path;
+  uint32_t m_Id = NullCommandLog::NextObjectId();
+  mutable std::unordered_map<std::string, int, NameHash, std::equal_to<>> m_Uniforms;
+};
+
+class NullTexture2D : public ITexture2D {
+public:
+  // Reads only the image header, for the size.
+  bool LoadFromFile(const char* path, bool flipY = true) override;
+  bool Create(uint32_t width, uint32_t height, int channels, const void* pixels) override;
+  void Bind(uint32_t slot) const override;
+  uint32_t Width() const override { return m_Width; }
+  uint32_t Height() const override { return m_Height; }
+
+  uint32_t Id() const { return m_Id; }
+
+private:
+  uint32_t m_Id = NullCommandLog::NextObjectId();
+  uint32_t m_Width = 0, m_Height = 0;
+};
+
+class NullTextureArray : public ITextureArray {
+public:
+  bool Create(uint32_t width, uint32_t height, uint32_t layers) override;
+  bool SetLayer(uint32_t layer, const void* rgba) override;
+  void Bind(uint32_t slot) const override;
+  uint32_t Width() const override { return m_Width; }
+  uint32_t Height() const override { return m_Height; }
+  uint32_t Layers() const override { return m_Layers; }
+
+  uint32_t Id() const { return m_Id; }
+
+private:
+  uint32_t m_Id = NullCommandLog::NextObjectId();
+  uint32_t m_Width = 0, m_Height = 0, m_Layers = 0;
+};
+
+class NullRenderTarget : public IRenderTarget {
+public:
+  NullRenderTarget();
+  bool Create(uint32_t width, uint32_t height) override;
+  void Begin(bool clear) override;
+  void End() override;
+  const Ref<ITexture2D>& Texture() const override { return m_Texture; }
+  uint32_t Width() const override { return m_Texture->Width(); }
+  uint32_t Height() const override { return m_Texture->Height(); }
+
+private:
+  Ref<ITexture2D> m_Texture;
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Wire format shared by KasinoServer and the load simulator.
+//
+// Every message is a frame: [u16 length][u8 type][payload], little endian, where length
+// counts the type byte plus payload. Moves travel as codes (index into LegalMoves), and
+// both ends run the same deterministic rules from the table seed, so clients mirror the
+// state themselves and nothing but moves is ever sent.
+namespace net {
+
+  enum class MsgType : uint8_t {
+    // client -> server
+    CreateTable = 1,  // u8 players, u8 aiMask (seat bits; seat 0 is always the creator)
+    JoinTable,        // u32 table
+    PlayMove,         // u32 table, u16 turn, u16 code
+    LeaveTable,       // u32 table
+
+    // server -> client
+    Joined = 16,      // u32 table, u8 seat, u8 players, u32 seed
+    Started,          // u32 table
+    MoveApplied,      // u32 table, u16 turn, u8 seat, u16 code
+    RoundOver,        // u32 table, u8 players, i16 total per player
+    Error,            // u8 ErrorCode, u32 table
+  };
+
+  enum class ErrorCode : uint8_t { BadMessage = 1, NoSuchTable, TableFull, NotYourTurn, IllegalMove, ServerFull };
+
+  constexpr size_t MaxFrame = 256;
+
+  // Appends one frame to `out`; Put* fill the payload and End patches the length.
+  struct FrameWriter {
+    std::vector<uint8_t>& out;
+    size_t start;
+
+    FrameWriter(std::vector<uint8_t>& buf, MsgType type) : out(buf), start(buf.size()) {
+      out.push_back(0); out.push_back(0);
+      out.push_back(static_cast<uint8_t>(type));
+    }
+    ~FrameWriter() {
+      size_t len = out.size() - start - 2;
+      out[start] = (uint8_t)(len & 0xff);
+      out[start + 1] = (uint8_t)(len >> 8);
+    }
+
+    FrameWriter& U8(uint8_t v)   { out.push_back(v); return *this; }
+    FrameWriter& U16(uint16_t v) { out.push_back((uint8_t)v); out.push_back((uint8_t)(v >> 8)); return *this; }
+    FrameWriter& U32(uint32_t v) { U16((uint16_t)v); return U16((uint16_t)(v >> 16)); }
+  };
+
+  // Reads a payload; `ok` drops to false on underrun so callers check once at the end.
+  struct FrameReader {
+    const uint8_t* p = nullptr;
+    size_t n = 0;
+    bool ok = true;
+
+    FrameReader(const uint8_t* data, size_t size) : p(data), n(size) {}
+
+    uint8_t U8() {
+      if (n < 1) { ok = false; return 0; }
+      uint8_t v = p[0]; p += 1; n -= 1; return v;
+    }
+    uint16_t U16() {
+      if (n < 2) { ok = false; return 0; }
+      uint16_t v = (uint16_t)(p[0] | (p[1] << 8)); p += 2; n -= 2; return v;
+    }
+    uint32_t U32() { uint32_t lo = U16(); return lo | ((uint32_t)U16() << 16); }
+  };
+
+  // Splits complete frames off the front of `buf`. Calls fn(type, payload, size) for each
+  // and returns false on a malformed frame. Consumed bytes are erased.
+  template<class Fn>
+  bool DrainFrames(std::vector<uint8_t>& buf, Fn&& fn) {
+    size_t off = 0;
+    bool good = true;
+    while (buf.size() - off >= 2) {
+      size_t len = buf[off] | (buf[off + 1] << 8);
+      if (len == 0 || len > MaxFrame) { good = false; break; }
+      if (buf.size() - off - 2 < len) break;
+      const uint8_t* frame = buf.data() + off + 2;
+      fn(static_cast<MsgType>(frame[0]), frame + 1, len - 1);
+      off += 2 + len;
+    }
+    buf.erase(buf.begin(), buf.begin() + off);
+    return good;
+  }
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Headless multi-table host (Linux, epoll).
+//
+// Tables are sharded across event-loop threads. Each shard owns an epoll set, its own
+// SO_REUSEPORT listener (the kernel spreads connections across shards) and the tables it
+// created; a table id carries the owning shard in its low byte. Messages for a table on
+// another shard, and writes to a connection owned by another shard, go through that
+// shard's mailbox (mutex + eventfd). AI seats are computed on a shared worker pool and
+// posted back to the owning shard, tagged with the table version so stale results drop.
+
+struct ServerConfig {
+  uint16_t port = 7777;        // 0 = no TCP listener
+  std::string unixPath;        // empty = no unix socket listener
+  int shards = 0;              // 0 = hardware threads
+  int aiWorkers = 0;           // 0 = hardware threads / 2
+  int maxTablesPerShard = 65536;
+  size_t outHighWater = 256 * 1024;   // queued output that pauses reading a connection
+  size_t outLimit = 4 * 1024 * 1024;  // queued output that drops it
+};
+
+struct ServerStats {
+  uint64_t connections = 0;   // open now
+  uint64_t tablesOpen = 0;
+  uint64_t movesApplied = 0;
+  uint64_t aiMoves = 0;
+};
+
+class TableServer {
+public:
+  explicit TableServer(const ServerConfig& cfg);
+  ~TableServer();
+
+  bool Start();
+  void Stop();
+  void Wait();
+
+  ServerStats Stats() const;
+
+  struct Shard;
+  struct AiPool;
+
+private:
+  ServerConfig m_Config;
+  std::vector<std::unique_ptr<Shard>> m_Shards;
+  std::unique_ptr<AiPool> m_AiPool;
+  std::vector<std::thread> m_Threads;
+  std::atomic<bool> m_Running{false};
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace ui {
+
+// Profiler panel: frame-time graph of the last frames, a frame-time histogram and
+// the zones of the last frame. Top-left at pos, width wide.
+void DrawProfilerOverlay(glm::vec2 pos, float width);
+
+}  // namespace ui
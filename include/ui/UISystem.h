@@ -5,6 +5,7 @@
 #include <glm/glm.hpp>
 
 #include <string>
+#include <vector>
 
 namespace ui {
 
@@ -22,6 +23,43 @@ void DrawText(const std::string &text, glm::vec2 pos, const TextStyle &style);
 void DrawText(const std::string &text, glm::vec2 pos, float scale,
               const glm::vec4 &color);
 
+// Greedy word wrap to maxWidth; '\n' starts a new paragraph, runs of spaces collapse.
+std::vector<std::string> WrapText(const std::string &text, const TextStyle &style,
+                                  float maxWidth);
+
+// Lines and glyph quads for one (text, style, maxWidth); quads are relative to the
+// top-left and get their color at draw time. maxWidth <= 0 keeps the text as is.
+struct TextLayout {
+  std::vector<std::string> lines;
+  std::vector<Render2D::QuadInstance> quads;
+  glm::vec2 size{0.0f, 0.0f};
+};
+
+// Cached by (text, scale, spacings, maxWidth); color is not part of the key. The
+// reference stays valid until the next TrimTextLayoutCache.
+const TextLayout &LayoutText(const std::string &text, const TextStyle &style,
+                             float maxWidth = 0.0f);
+void DrawTextLayout(const TextLayout &layout, glm::vec2 pos, const glm::vec4 &color);
+
+// Once per frame: once the cache is over its budget, drops layouts not used since
+// the previous trim.
+void TrimTextLayoutCache();
+void ClearTextLayoutCache();
+
+// prefix + number + suffix; the string is only rebuilt when the number changes.
+class NumberLabel {
+public:
+  explicit NumberLabel(std::string prefix = {}, std::string suffix = {});
+  const std::string &Text(int value);
+
+private:
+  std::string m_Prefix;
+  std::string m_Suffix;
+  std::string m_Text;
+  int m_Value = 0;
+  bool m_Valid = false;
+};
+
 struct ButtonStyle {
   glm::vec4 baseColor{0.18f, 0.32f, 0.38f, 1.0f};
   glm::vec4 hoveredColor{0.30f, 0.55f, 0.78f, 1.0f};
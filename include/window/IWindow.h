@@ -18,6 +18,14 @@ public:
 
   virtual bool ShouldClose() const = 0;
   virtual void PollEvents() = 0;
+  // Blocks until an event arrives or timeoutSeconds pass, then polls. Backends that
+  // can't block just poll.
+  virtual void WaitEvents(double timeoutSeconds) {
+    (void)timeoutSeconds;
+    PollEvents();
+  }
+  // Wakes a WaitEvents in progress (safe from other threads where the backend allows).
+  virtual void PostEmptyEvent() {}
   virtual void SwapBuffers() = 0;
 
   virtual std::pair<float, float> GetLogicalSize() const = 0;
@@ -39,6 +47,12 @@ public:
   virtual GLProc GetGLProcLoader() const { return nullptr; }
   virtual void SetSwapInterval(int interval) { (void)interval; }
   virtual bool IsVsyncEnabled() const { return false; }
+  // false for contexts without a window surface; the device then renders into its own target
+  virtual bool HasDefaultFramebuffer() const { return true; }
+  // Threaded rendering moves the GL context to the render thread and back; backends
+  // without a context have nothing to move.
+  virtual bool MakeContextCurrent() { return true; }
+  virtual void ReleaseContext() {}
 
   virtual float GetLogicalX(float windowX) const {
     auto [ww, wh] = GetWindowSize();
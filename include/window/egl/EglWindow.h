@@ -0,0 +1,25 @@
+#pragma once
+
+#include "window/null/NullWindow.h"
+
+// Offscreen GL: an EGL context made current without a surface (Mesa's surfaceless
+// platform, so llvmpipe works on machines with no GPU or display). Sizes and input
+// script come from NullWindow; with no default framebuffer GLDevice renders into a
+// framebuffer object of the window's size, readable with ReadPixels.
+class EglWindow : public NullWindow {
+public:
+  explicit EglWindow(const FactoryDesc& desc);
+  ~EglWindow() override;
+
+  WindowAPI API() const override { return WindowAPI::Offscreen; }
+
+  bool EnsureGLContext(int major, int minor, bool debug) override;
+  GLProc GetGLProcLoader() const override;
+  bool HasDefaultFramebuffer() const override { return false; }
+  bool MakeContextCurrent() override;
+  void ReleaseContext() override;
+
+private:
+  void* m_Display = nullptr;   // EGLDisplay
+  void* m_Context = nullptr;   // EGLContext
+};
@@ -17,6 +17,8 @@ public:
 
   bool ShouldClose() const override;
   void PollEvents() override;
+  void WaitEvents(double timeoutSeconds) override;
+  void PostEmptyEvent() override;
   void SwapBuffers() override;
 
   std::pair<float, float> GetLogicalSize() const override;
@@ -34,6 +36,8 @@ public:
   GLProc GetGLProcLoader() const override;
   void SetSwapInterval(int interval) override;
   bool IsVsyncEnabled() const override { return m_Vsync; }
+  bool MakeContextCurrent() override;
+  void ReleaseContext() override;
 
   void* GetNativeHandle() const override;
 
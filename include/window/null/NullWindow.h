@@ -0,0 +1,82 @@
+#pragma once
+
+#include "events/EventBus.h"
+#include "window/IWindow.h"
+#include "core/FactoryDesc.h"
+
+#include <cstdint>
+#include <vector>
+
+// Headless window: no display, no context, no waiting. Input comes from a script of
+// events keyed to the poll count (one poll per game frame), so a run is repeatable.
+// Coordinates are logical, the same space GlfwWindow emits after conversion.
+class NullWindow : public IWindow {
+public:
+  using Action = std::function<void(NullWindow&)>;
+
+  explicit NullWindow(const FactoryDesc& desc);
+
+  WindowAPI API() const override { return WindowAPI::None; }
+
+  bool ShouldClose() const override { return m_ShouldClose; }
+  void PollEvents() override;
+  // Nothing to wait for; idle frames just run the next scripted poll.
+  void WaitEvents(double) override { PollEvents(); }
+  void SwapBuffers() override { ++m_Swaps; }
+
+  std::pair<float, float> GetLogicalSize() const override;
+  std::pair<float, float> GetWindowSize() const override;
+  std::pair<float, float> GetFramebufferSize() const override;
+  float GetDevicePixelRatio() const override { return m_dpr; }
+
+  void SetCloseCallback(CloseCallback cb) override { m_OnClose = std::move(cb); }
+  void SetResizeCallback(ResizeCallback cb) override { m_OnResize = std::move(cb); }
+
+  EventBus &Events() override { return m_Events; }
+
+  void SetSwapInterval(int interval) override { m_Vsync = interval != 0; }
+  bool IsVsyncEnabled() const override { return m_Vsync; }
+
+  void* GetNativeHandle() const override { return nullptr; }
+
+  // Script. `poll` counts PollEvents/WaitEvents calls from 0; actions due at the
+  // same poll run in the order they were added.
+  void At(uint64_t poll, Action action);
+  void Click(uint64_t poll, float x, float y, MouseButton button = MouseButton::Left);
+  void MoveMouse(uint64_t poll, float x, float y);
+  void PressKey(uint64_t poll, Key key);
+  void Resize(uint64_t poll, int fbWidth, int fbHeight);
+  // Closes the window at `poll`; the game loop ends after that frame.
+  void CloseAt(uint64_t poll);
+
+  // Immediate versions, also what the scripted ones end up calling
+  void Close();
+  void SetFramebufferSize(int fbWidth, int fbHeight);
+
+  uint64_t Polls() const { return m_Polls; }
+  uint64_t Swaps() const { return m_Swaps; }
+  size_t PendingActions() const { return m_Script.size() - m_Next; }
+
+private:
+  struct Scripted {
+    uint64_t Poll;
+    Action   Run;
+  };
+
+  int   m_logicalW = 360;
+  int   m_logicalH = 640;
+  int   m_fbW = 360;
+  int   m_fbH = 640;
+  float m_dpr = 1.0f;
+  bool  m_Vsync = true;
+  bool  m_ShouldClose = false;
+
+  uint64_t m_Polls = 0;
+  uint64_t m_Swaps = 0;
+  std::vector<Scripted> m_Script;    // sorted by Poll, stable
+  size_t   m_Next = 0;               // first entry not run yet
+
+  EventBus m_Events;
+  CloseCallback m_OnClose;
+  ResizeCallback m_OnResize;
+};
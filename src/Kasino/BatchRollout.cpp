@@ -0,0 +1,312 @@
+#include "Kasino/BatchRollout.h"
+#include "Kasino/GameLogic.h"
+#include "Kasino/Scoring.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+
+// ---------- shared helpers
+
+static uint32_t gameSeed(uint32_t seed, int game){
+  uint64_t x = ((uint64_t)seed << 32) + (uint64_t)game + 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  x ^= x >> 31;
+  return (uint32_t)x ? (uint32_t)x : 1u;
+}
+
+static void recordGame(RolloutStats& st, const int* score, int numPlayers){
+  int best = -1, bestScore = 0; bool tie = false;
+  for (int p=0; p<numPlayers; ++p) {
+    st.totalScore[p] += score[p];
+    if (best < 0 || score[p] > bestScore) { best = p; bestScore = score[p]; tie = false; }
+    else if (score[p] == bestScore) tie = true;
+  }
+  if (!tie && best >= 0) st.wins[best]++;
+  st.games++;
+}
+
+static RolloutStats makeStats(int numPlayers){
+  RolloutStats st;
+  st.totalScore.assign(numPlayers, 0);
+  st.wins.assign(numPlayers, 0);
+  return st;
+}
+
+// ---------- reference (LegalMoves/ApplyMove)
+
+int RolloutPolicyPick(const GameState& gs, const std::vector<Move>& moves, RolloutRng& rng){
+  const auto& hand = gs.CurPlayer().hand;
+  if (hand.empty() || moves.empty()) return -1;
+  const Card card = hand[rng.Below((uint32_t)hand.size())];
+
+  int captures = 0, trail = -1;
+  for (int i=0; i<(int)moves.size(); ++i) {
+    if (moves[i].handCard != card) continue;
+    if (moves[i].type == MoveType::Capture) captures++;
+    else if (moves[i].type == MoveType::Trail) trail = i;
+  }
+  if (captures == 0) return trail;
+
+  int pick = (int)rng.Below((uint32_t)captures);
+  for (int i=0; i<(int)moves.size(); ++i) {
+    if (moves[i].handCard != card || moves[i].type != MoveType::Capture) continue;
+    if (pick-- == 0) return i;
+  }
+  return trail;
+}
+
+RolloutStats ReferenceRollouts(const GameState& start, int games, uint32_t seed){
+  RolloutStats st = makeStats(start.numPlayers);
+  for (int g=0; g<games; ++g) {
+    GameState gs = start;
+    RolloutRng rng(gameSeed(seed, g));
+    while (true) {
+      if (gs.HandsEmpty() && !DealNextHands(gs)) break;
+      auto moves = LegalMoves(gs);
+      int pick = RolloutPolicyPick(gs, moves, rng);
+      if (pick < 0) { AdvanceTurn(gs); continue; }
+      ApplyMove(gs, moves[pick]);
+    }
+    auto lines = ScoreRound(gs);
+    int score[4] = {};
+    for (int p=0; p<gs.numPlayers && p<4; ++p) score[p] = lines[p].total;
+    recordGame(st, score, gs.numPlayers);
+  }
+  return st;
+}
+
+// ---------- batched SoA
+
+namespace {
+
+constexpr int kLanes = 8;
+constexpr int kMaxSlots = 52;
+
+// card id = suit*13 + rank-1
+inline int cardId(const Card& c){ return static_cast<int>(c.suit) * 13 + RankValue(c.rank) - 1; }
+inline int idValue(int id){ return id % 13 + 1; }
+
+struct LaneGroup {
+  int32_t looseRank[kMaxSlots][kLanes]; // 0 = empty slot
+  int32_t hv[kLanes];                   // value of the card being played this step
+  int32_t canSum[kLanes];               // out: some non-equal loose subset sums to hv
+  int32_t hasEqual[kLanes];             // out: a loose card has the same rank
+
+  uint64_t hand[4][kLanes];
+  uint8_t stock[kMaxSlots][kLanes];
+  int32_t stockCount[kLanes];
+  int32_t looseCount[kLanes];
+  uint8_t buildCount[14][kLanes];       // builds only ever get captured during a rollout
+  uint8_t buildCards[14][kLanes];
+  int32_t buildsLeft[kLanes];
+  int32_t score[4][kLanes];
+  int32_t current[kLanes];
+  int32_t lastCapture[kLanes];
+  int32_t pick[kLanes];
+  RolloutRng rng[kLanes];
+  bool active[kLanes];
+};
+
+// reach |= reach << v over all loose slots; bit hv of reach says a subset sums to hv.
+// Equal-rank cards are masked to 0 (shifting by 0 is a no-op) and reported separately.
+void detectCaptures(LaneGroup& g, int slots){
+  for (int l=0; l<kLanes; ++l) {
+    uint32_t reach = 1, eq = 0;
+    const int32_t hv = g.hv[l];
+    for (int k=0; k<slots; ++k) {
+      int32_t v = g.looseRank[k][l];
+      uint32_t e = v == hv;
+      reach |= reach << (e ? 0 : v);
+      eq |= e;
+    }
+    g.canSum[l] = (reach >> hv) & 1;
+    g.hasEqual[l] = (int32_t)eq;
+  }
+}
+
+void removeSlot(LaneGroup& g, int l, int k){
+  int last = --g.looseCount[l];
+  g.looseRank[k][l] = g.looseRank[last][l];
+  g.looseRank[last][l] = 0;
+}
+
+void clearTable(LaneGroup& g, int l){
+  for (int k=0; k<g.looseCount[l]; ++k) g.looseRank[k][l] = 0;
+  g.looseCount[l] = 0;
+  for (int v=0; v<14; ++v) { g.buildCount[v][l] = 0; g.buildCards[v][l] = 0; }
+  g.buildsLeft[l] = 0;
+}
+
+bool handsEmpty(const LaneGroup& g, int l, int n){
+  for (int p=0; p<n; ++p) if (g.hand[p][l]) return false;
+  return true;
+}
+
+// mirrors the rollout loop head: deal when everyone is out of cards, stop when we can't
+void dealOrFinish(LaneGroup& g, int l, int n){
+  if (!handsEmpty(g, l, n)) return;
+  if (g.stockCount[l] < 4*n) { g.active[l] = false; return; }
+  for (int p=0; p<n; ++p)
+    for (int i=0; i<4; ++i) g.hand[p][l] |= 1ull << g.stock[--g.stockCount[l]][l];
+}
+
+void loadLane(LaneGroup& g, int l, const GameState& gs, uint32_t seed){
+  const int n = gs.numPlayers;
+  for (int p=0; p<4; ++p) {
+    g.hand[p][l] = 0;
+    g.score[p][l] = 0;
+  }
+  for (int p=0; p<n; ++p) {
+    for (const Card& c : gs.players[p].hand) g.hand[p][l] |= 1ull << cardId(c);
+    const auto& P = gs.players[p];
+    g.score[p][l] = P.capturedCardPoints + P.buildBonus + P.sweepBonus;
+  }
+  for (int k=0; k<kMaxSlots; ++k) g.looseRank[k][l] = 0;
+  g.looseCount[l] = (int32_t)gs.table.loose.size();
+  for (int k=0; k<g.looseCount[l]; ++k) {
+    g.looseRank[k][l] = RankValue(gs.table.loose[k].rank);
+  }
+  for (int v=0; v<14; ++v) { g.buildCount[v][l] = 0; g.buildCards[v][l] = 0; }
+  g.buildsLeft[l] = 0;
+  for (const Build& b : gs.table.builds) {
+    if (b.value < 0 || b.value > 13) continue;
+    g.buildCount[b.value][l]++;
+    g.buildCards[b.value][l] += (uint8_t)b.cards.size();
+    g.buildsLeft[l]++;
+  }
+  g.stockCount[l] = (int32_t)gs.stock.size();
+  for (int k=0; k<g.stockCount[l]; ++k) g.stock[k][l] = (uint8_t)cardId(gs.stock[k]);
+  g.current[l] = gs.current;
+  g.lastCapture[l] = gs.lastCaptureBy;
+  g.rng[l] = RolloutRng(seed);
+  g.active[l] = true;
+  dealOrFinish(g, l, n);
+}
+
+void idleLane(LaneGroup& g, int l){
+  for (int k=0; k<kMaxSlots; ++k) g.looseRank[k][l] = 0;
+  g.looseCount[l] = 0;
+  g.hv[l] = 0;
+  g.active[l] = false;
+}
+
+// Capture with the picked card. The variants LegalMoves emits for one card are: every
+// subset of the non-equal loose cards summing to hv (plus all equal-rank cards), one
+// more for "equal-rank cards only" if there are any, or a single builds-only capture
+// when nothing else matches. Count them with a subset-sum DP and backtrack to the r-th.
+void resolveCapture(LaneGroup& g, int l){
+  const int hv = g.hv[l];
+  const int cur = g.current[l];
+  const int n = g.looseCount[l];
+
+  int slot[kMaxSlots], val[kMaxSlots], m = 0;
+  for (int k=0; k<n; ++k) {
+    int v = g.looseRank[k][l];
+    if (v < hv) { slot[m] = k; val[m] = v; m++; }
+  }
+  uint32_t ways[kMaxSlots + 1][14];
+  std::memset(ways[0], 0, sizeof(ways[0]));
+  ways[0][0] = 1;
+  for (int i=0; i<m; ++i)
+    for (int t=0; t<=hv; ++t)
+      ways[i+1][t] = ways[i][t] + (t >= val[i] ? ways[i][t - val[i]] : 0);
+
+  const uint32_t subsets = ways[m][hv];
+  const bool eq = g.hasEqual[l] != 0;
+  const uint32_t variants = subsets + (eq || subsets == 0 ? 1u : 0u);
+  uint32_t r = g.rng[l].Below(variants);
+
+  bool take[kMaxSlots] = {};
+  if (r < subsets) {
+    int t = hv;
+    for (int i=m; i>0; --i) {
+      if (r < ways[i-1][t]) continue;
+      r -= ways[i-1][t];
+      take[slot[i-1]] = true;
+      t -= val[i-1];
+    }
+  }
+  if (eq) for (int k=0; k<n; ++k) if (g.looseRank[k][l] == hv) take[k] = true;
+
+  int points = 1; // the played card
+  for (int k=n-1; k>=0; --k) if (take[k]) { removeSlot(g, l, k); points++; }
+  if (g.buildCount[hv][l]) {
+    points += g.buildCards[hv][l] + g.buildCount[hv][l]; // cards + build bonus
+    g.buildsLeft[l] -= g.buildCount[hv][l];
+    g.buildCount[hv][l] = 0;
+    g.buildCards[hv][l] = 0;
+  }
+  if (g.looseCount[l] == 0 && g.buildsLeft[l] == 0) points++; // sweep
+  g.score[cur][l] += points;
+  g.lastCapture[l] = cur;
+}
+
+void stepLane(LaneGroup& g, int l, int numPlayers){
+  const int cur = g.current[l];
+  const int card = g.pick[l];
+  if (card < 0) { g.current[l] = (cur + 1) % numPlayers; return; }
+  g.hand[cur][l] &= ~(1ull << card);
+
+  const int hv = g.hv[l];
+  if (g.canSum[l] || g.hasEqual[l] || g.buildCount[hv][l]) {
+    resolveCapture(g, l);
+  } else {
+    int k = g.looseCount[l]++;
+    g.looseRank[k][l] = hv;
+  }
+
+  if (handsEmpty(g, l, numPlayers) && g.stockCount[l] == 0 && g.lastCapture[l] >= 0) {
+    g.score[g.lastCapture[l]][l] += g.looseCount[l];
+    clearTable(g, l);
+  }
+  g.current[l] = (cur + 1) % numPlayers;
+  dealOrFinish(g, l, numPlayers);
+}
+
+} // namespace
+
+RolloutStats BatchRollouts(const GameState& start, int games, uint32_t seed){
+  const int n = start.numPlayers;
+  RolloutStats st = makeStats(n);
+  if (n < 1 || n > 4) return st;
+
+  auto g = std::make_unique<LaneGroup>();
+  for (int base=0; base<games; base+=kLanes) {
+    const int lanes = std::min(kLanes, games - base);
+    for (int l=0; l<kLanes; ++l) {
+      if (l < lanes) loadLane(*g, l, start, gameSeed(seed, base + l));
+      else idleLane(*g, l);
+    }
+
+    while (true) {
+      int slots = 0; bool any = false;
+      for (int l=0; l<kLanes; ++l) {
+        g->pick[l] = -1;
+        if (!g->active[l]) { g->hv[l] = 0; continue; }
+        any = true;
+        const uint64_t hand = g->hand[g->current[l]][l];
+        if (hand) {
+          // r-th set bit of the hand mask
+          uint64_t h = hand;
+          for (uint32_t r = g->rng[l].Below((uint32_t)std::popcount(hand)); r; --r) h &= h - 1;
+          g->pick[l] = std::countr_zero(h);
+        }
+        g->hv[l] = g->pick[l] < 0 ? 0 : idValue(g->pick[l]);
+        slots = std::max(slots, (int)g->looseCount[l]);
+      }
+      if (!any) break;
+
+      detectCaptures(*g, slots);
+      for (int l=0; l<kLanes; ++l) if (g->active[l]) stepLane(*g, l, n);
+    }
+
+    for (int l=0; l<lanes; ++l) {
+      int score[4];
+      for (int p=0; p<4; ++p) score[p] = g->score[p][l];
+      recordGame(st, score, n);
+    }
+  }
+  return st;
+}
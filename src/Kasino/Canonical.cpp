@@ -0,0 +1,199 @@
+#include "Kasino/Canonical.h"
+#include "Kasino/GameLogic.h"
+#include <algorithm>
+
+// ---------- keys
+
+static uint64_t splitmix64(uint64_t x){
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+struct ZobristTable {
+  uint64_t card[14][NumLocations];
+  uint64_t build[5][16];
+  ZobristTable() {
+    uint64_t seed = 0x4B6173696E6Full; // "Kasino"
+    for (auto& r : card) for (auto& k : r) k = splitmix64(seed++);
+    for (auto& o : build) for (auto& k : o) k = splitmix64(seed++);
+  }
+};
+
+static const ZobristTable& keys(){
+  static const ZobristTable z;
+  return z;
+}
+
+static uint64_t cardKey(const Card& c, int loc){
+  if (loc == LocGone) return 0;
+  return keys().card[RankValue(c.rank)][loc];
+}
+
+static uint64_t buildKeyFor(const Build& b){
+  int v = b.value < 0 ? 0 : (b.value > 15 ? 15 : b.value);
+  return keys().build[b.ownerPlayer + 1][v];
+}
+
+// ---------- PositionHash
+
+void PositionHash::MoveCard(const Card& c, int fromLoc, int toLoc){
+  suitHash[static_cast<int>(c.suit)] ^= cardKey(c, fromLoc) ^ cardKey(c, toLoc);
+}
+
+void PositionHash::SyncScalars(const GameState& gs){
+  uint64_t h = splitmix64((uint64_t)gs.numPlayers);
+  h = splitmix64(h ^ (uint64_t)gs.current);
+  h = splitmix64(h ^ (uint64_t)(gs.lastCaptureBy + 1));
+  for (const auto& p : gs.players) {
+    h = splitmix64(h ^ (uint64_t)(uint32_t)p.capturedCardPoints);
+    h = splitmix64(h ^ ((uint64_t)(uint32_t)p.buildBonus << 32 | (uint32_t)p.sweepBonus));
+  }
+  scalarKey = h;
+}
+
+void PositionHash::Reset(const GameState& gs){
+  suitHash = {};
+  buildKey = 0;
+  for (int p=0; p<(int)gs.players.size(); ++p)
+    for (const Card& c : gs.players[p].hand) MoveCard(c, LocGone, LocHand(p));
+  for (const Card& c : gs.table.loose) MoveCard(c, LocGone, LocLoose);
+  for (const Build& b : gs.table.builds) {
+    for (const Card& c : b.cards) MoveCard(c, LocGone, LocBuild(b.ownerPlayer, b.value));
+    buildKey += buildKeyFor(b);
+  }
+  for (int i=0; i<(int)gs.stock.size(); ++i) MoveCard(gs.stock[i], LocGone, LocStock(i));
+  SyncScalars(gs);
+}
+
+uint64_t PositionHash::Key() const {
+  std::array<uint64_t, 4> s = suitHash;
+  std::sort(s.begin(), s.end());
+  uint64_t h = scalarKey ^ splitmix64(buildKey);
+  for (uint64_t v : s) h = splitmix64(h ^ v);
+  return h;
+}
+
+std::array<Suit, 4> PositionHash::SuitOrder() const {
+  std::array<int, 4> order = {0, 1, 2, 3};
+  std::stable_sort(order.begin(), order.end(), [this](int a, int b){ return suitHash[a] < suitHash[b]; });
+  std::array<Suit, 4> map{};
+  for (int i=0; i<4; ++i) map[order[i]] = static_cast<Suit>(i);
+  return map;
+}
+
+// ---------- incremental versions of the GameLogic entry points
+
+bool ApplyMove(GameState& gs, const Move& mv, PositionHash& hash){
+  const auto& hand = gs.CurPlayer().hand;
+  if (std::find(hand.begin(), hand.end(), mv.handCard) == hand.end()) return false;
+
+  const auto& L = gs.table.loose;
+  const auto& B = gs.table.builds;
+  const int cur = gs.current;
+
+  // work on a copy so a rejected move leaves `hash` untouched
+  PositionHash h = hash;
+
+  // Does this move empty the last hand with no stock left? Then ApplyMove sweeps the
+  // table to the last capturer and every table card (and the played one) drops out.
+  int handsLeft = 0;
+  for (const auto& p : gs.players) handsLeft += (int)p.hand.size();
+  const int lastCapture = mv.type == MoveType::Capture ? cur : gs.lastCaptureBy;
+  const bool sweep = handsLeft == 1 && gs.stock.empty() && lastCapture >= 0;
+
+  if (sweep) {
+    if (mv.type == MoveType::ExtendBuild &&
+        (mv.captureBuildIdx.size() != 1 || mv.captureBuildIdx[0] < 0 || mv.captureBuildIdx[0] >= (int)B.size() ||
+         B[mv.captureBuildIdx[0]].ownerPlayer != cur)) return false;
+    h.MoveCard(mv.handCard, LocHand(cur), LocGone);
+    for (const Card& c : L) h.MoveCard(c, LocLoose, LocGone);
+    for (const Build& b : B)
+      for (const Card& c : b.cards) h.MoveCard(c, LocBuild(b.ownerPlayer, b.value), LocGone);
+    h.buildKey = 0;
+  } else {
+    switch (mv.type) {
+    case MoveType::Capture: {
+      h.MoveCard(mv.handCard, LocHand(cur), LocGone);
+      for (int li : mv.captureLooseIdx) h.MoveCard(L[li], LocLoose, LocGone);
+      std::vector<int> bidx = mv.captureBuildIdx;
+      std::sort(bidx.begin(), bidx.end());
+      bidx.erase(std::unique(bidx.begin(), bidx.end()), bidx.end());
+      for (int bi : bidx) {
+        if (bi < 0 || bi >= (int)B.size()) continue;
+        for (const Card& c : B[bi].cards) h.MoveCard(c, LocBuild(B[bi].ownerPlayer, B[bi].value), LocGone);
+        h.buildKey -= buildKeyFor(B[bi]);
+      }
+    } break;
+
+    case MoveType::Build: {
+      Build nb; nb.ownerPlayer = cur; nb.value = mv.buildTargetValue;
+      const int to = LocBuild(cur, nb.value);
+      h.MoveCard(mv.handCard, LocHand(cur), to);
+      for (int li : mv.buildUseLooseIdx) h.MoveCard(L[li], LocLoose, to);
+      h.buildKey += buildKeyFor(nb);
+    } break;
+
+    case MoveType::ExtendBuild: {
+      if (mv.captureBuildIdx.size()!=1) return false;
+      int bi = mv.captureBuildIdx[0];
+      if (bi < 0 || bi >= (int)B.size() || B[bi].ownerPlayer != cur) return false;
+      Build nb; nb.ownerPlayer = cur; nb.value = mv.buildTargetValue;
+      const int from = LocBuild(cur, B[bi].value), to = LocBuild(cur, nb.value);
+      for (const Card& c : B[bi].cards) h.MoveCard(c, from, to);
+      h.MoveCard(mv.handCard, LocHand(cur), to);
+      h.buildKey += buildKeyFor(nb) - buildKeyFor(B[bi]);
+    } break;
+
+    case MoveType::Trail:
+      h.MoveCard(mv.handCard, LocHand(cur), LocLoose);
+      break;
+    }
+  }
+
+  if (!ApplyMove(gs, mv)) return false;
+  h.SyncScalars(gs);
+  hash = h;
+  return true;
+}
+
+bool DealNextHands(GameState& gs, PositionHash& hash){
+  if (gs.stock.size() < (size_t)(4*gs.numPlayers)) return false;
+  // DealNextHands pops from the back: player 0 gets the top four, and so on
+  int top = (int)gs.stock.size() - 1;
+  for (int p=0; p<gs.numPlayers; ++p)
+    for (int i=0; i<4; ++i, --top) hash.MoveCard(gs.stock[top], LocStock(top), LocHand(p));
+  DealNextHands(gs);
+  hash.SyncScalars(gs);
+  return true;
+}
+
+void StartRound(GameState& gs, PositionHash& hash, int numPlayers, uint32_t shuffleSeed){
+  StartRound(gs, numPlayers, shuffleSeed);
+  hash.Reset(gs);
+}
+
+uint64_t CanonicalHash(const GameState& gs){
+  PositionHash h; h.Reset(gs);
+  return h.Key();
+}
+
+// ---------- relabeling
+
+GameState Canonicalize(const GameState& gs, const PositionHash& hash){
+  const auto map = hash.SuitOrder();
+  auto remap = [&map](std::vector<Card>& v){ for (Card& c : v) c = RemapCard(c, map); };
+
+  GameState out = gs;
+  for (auto& p : out.players) { remap(p.hand); remap(p.pile); }
+  remap(out.table.loose);
+  for (auto& b : out.table.builds) remap(b.cards);
+  remap(out.stock);
+  return out;
+}
+
+GameState Canonicalize(const GameState& gs){
+  PositionHash h; h.Reset(gs);
+  return Canonicalize(gs, h);
+}
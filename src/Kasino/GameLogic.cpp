@@ -1,4 +1,5 @@
 #include "Kasino/GameLogic.h"
+#include "core/Profiler.h"
 #include <algorithm>
 #include <numeric>
 #include <set>
@@ -13,6 +14,39 @@ int CardSumValue(const std::vector<Card>& v){
   int s=0; for (auto& c: v) s += RankValue(c.rank); return s;
 }
 
+// FNV-1a
+static void hashBytes(uint64_t& h, uint64_t v, int bytes){
+  for (int i=0; i<bytes; ++i) { h ^= (v >> (8*i)) & 0xff; h *= 0x100000001B3ull; }
+}
+
+static void hashCards(uint64_t& h, const std::vector<Card>& v){
+  hashBytes(h, v.size(), 2);
+  for (const Card& c : v) hashBytes(h, (uint64_t)RankValue(c.rank) << 2 | static_cast<uint64_t>(c.suit), 1);
+}
+
+uint64_t StateChecksum(const GameState& gs){
+  uint64_t h = 0xCBF29CE484222325ull;
+  hashBytes(h, (uint32_t)gs.numPlayers, 1);
+  hashBytes(h, (uint32_t)gs.current, 1);
+  hashBytes(h, (uint32_t)(gs.lastCaptureBy + 1), 1);
+  for (const auto& p : gs.players) {
+    hashCards(h, p.hand);
+    hashCards(h, p.pile);
+    hashBytes(h, (uint32_t)p.capturedCardPoints, 4);
+    hashBytes(h, (uint32_t)p.buildBonus, 4);
+    hashBytes(h, (uint32_t)p.sweepBonus, 4);
+  }
+  hashCards(h, gs.table.loose);
+  hashBytes(h, gs.table.builds.size(), 2);
+  for (const auto& b : gs.table.builds) {
+    hashBytes(h, (uint32_t)b.value, 1);
+    hashBytes(h, (uint32_t)(b.ownerPlayer + 1), 1);
+    hashCards(h, b.cards);
+  }
+  hashCards(h, gs.stock);
+  return h;
+}
+
 // generate all index subsets of loose cards that sum to target (no duplicates)
 static void genSumCombos(const std::vector<Card>& loose, int target, size_t start, std::vector<int>& cur, std::vector<std::vector<int>>& out){
   int sum=0; for (int i:cur) sum += RankValue(loose[i].rank);
@@ -67,6 +101,7 @@ void AdvanceTurn(GameState& gs){
 // ---------- move gen
 
 std::vector<Move> LegalMoves(const GameState& gs){
+  EN_PROFILE_ZONE("LegalMoves");
   std::vector<Move> out;
 
   const auto& P = gs.CurPlayer();
@@ -159,6 +194,34 @@ std::vector<Move> LegalMoves(const GameState& gs){
   return out;
 }
 
+static bool sameIndices(std::vector<int> a, std::vector<int> b){
+  std::sort(a.begin(), a.end()); std::sort(b.begin(), b.end());
+  return a==b;
+}
+
+static bool sameMove(const Move& a, const Move& b){
+  if (a.type!=b.type || !(a.handCard==b.handCard)) return false;
+  switch (a.type) {
+  case MoveType::Capture: return sameIndices(a.captureLooseIdx, b.captureLooseIdx) && sameIndices(a.captureBuildIdx, b.captureBuildIdx);
+  case MoveType::Build: return a.buildTargetValue==b.buildTargetValue && sameIndices(a.buildUseLooseIdx, b.buildUseLooseIdx);
+  case MoveType::ExtendBuild: return a.buildTargetValue==b.buildTargetValue && a.captureBuildIdx==b.captureBuildIdx;
+  default: return true;
+  }
+}
+
+int EncodeMove(const GameState& gs, const Move& mv){
+  auto moves = LegalMoves(gs);
+  for (size_t i=0; i<moves.size(); ++i) if (sameMove(moves[i], mv)) return (int)i;
+  return -1;
+}
+
+bool DecodeMove(const GameState& gs, int code, Move& out){
+  auto moves = LegalMoves(gs);
+  if (code < 0 || code >= (int)moves.size()) return false;
+  out = std::move(moves[code]);
+  return true;
+}
+
 // ---------- apply move
 
 static void giveCard(std::vector<Card>& from, std::vector<Card>& to, const Card& c){
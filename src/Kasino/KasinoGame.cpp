@@ -3,8 +3,11 @@
 #include "app/Game.h"
 #include "core/Factory.h"
 #include "core/Log.h"
+#include "core/Profiler.h"
 #include "gfx/Render2D.h"
+#include "gfx/ViewportUtil.h"
 #include "input/InputSystem.h"
+#include "ui/ProfilerOverlay.h"
 #include "ui/UISystem.h"
 #include "Kasino/GameLogic.h"
 #include "Kasino/Scoring.h"
@@ -14,6 +17,7 @@
 #include <array>
 #include <cctype>
 #include <cmath>
+#include <initializer_list>
 #include <optional>
 #include <random>
 #include <set>
@@ -35,6 +39,8 @@ constexpr float kAiAnimDuration = 0.3f;
 constexpr float kDealAnimDuration = 0.35f;
 constexpr float kDealDelayStep = 0.12f;
 
+constexpr const char *kTraceFileName = "kasino_trace.json";
+
 const std::string kMainMenuTitleText = "KASINO";
 const std::string kMainMenuSubtitleText = "CLASSIC TABLE PLAY";
 const std::string kMainMenuFooterText = "CHOOSE AN OPTION TO BEGIN";
@@ -47,11 +53,11 @@ constexpr float kButtonsFooterSpacingFactor = 2.4f;
 constexpr float kButtonVerticalSpacingFactor = 1.75f;
 constexpr float kMainMenuBottomMargin = 48.f;
 
-constexpr const char *kSettingsParagraph1 =
+const std::string kSettingsParagraph1 =
     "Resume closes this menu and keeps the current round active.";
-constexpr const char *kSettingsParagraph2 =
+const std::string kSettingsParagraph2 =
     "Main Menu ends the match in progress and returns to the title screen.";
-constexpr const char *kSettingsParagraph3 =
+const std::string kSettingsParagraph3 =
     "Use the volume slider below to adjust audio. Press ESC or tap Settings to reopen this menu.";
 
 const std::array<const char *, 20> kHowToPlayLines = {
@@ -90,23 +96,6 @@ constexpr float kVolumeHandleHeight = 30.f;
 constexpr float kSettingsMainMenuButtonHeight = 44.f;
 constexpr float kSettingsMainMenuButtonSpacing = 24.f;
 
-float lineAdvanceForStyle(const ui::TextStyle &style) {
-  return style.scale * (5.0f + style.lineSpacing);
-}
-
-float blockHeightForLines(const std::vector<std::string> &lines,
-                          const ui::TextStyle &style) {
-  if (lines.empty()) {
-    return 0.f;
-  }
-  float baseHeight = style.scale * 5.0f;
-  if (lines.size() == 1) {
-    return baseHeight;
-  }
-  return baseHeight +
-         static_cast<float>(lines.size() - 1) * lineAdvanceForStyle(style);
-}
-
 template <size_t N>
 std::string joinLines(const std::array<const char *, N> &lines) {
   std::string result;
@@ -119,77 +108,7 @@ std::string joinLines(const std::array<const char *, N> &lines) {
   return result;
 }
 
-std::vector<std::string> wrapText(const std::string &text,
-                                  const ui::TextStyle &style,
-                                  float maxWidth) {
-  std::vector<std::string> wrapped;
-  if (text.empty()) {
-    return wrapped;
-  }
-
-  std::stringstream ss(text);
-  std::string paragraph;
-  bool processedAny = false;
-  while (std::getline(ss, paragraph)) {
-    processedAny = true;
-    if (paragraph.empty()) {
-      wrapped.emplace_back();
-      continue;
-    }
-
-    std::istringstream words(paragraph);
-    std::string word;
-    std::string currentLine;
-    while (words >> word) {
-      std::string candidate =
-          currentLine.empty() ? word : currentLine + " " + word;
-      float width = ui::MeasureText(candidate, style).x;
-      if (maxWidth <= 0.f || width <= maxWidth) {
-        currentLine = std::move(candidate);
-      } else {
-        if (!currentLine.empty()) {
-          wrapped.push_back(currentLine);
-        }
-        currentLine = word;
-      }
-    }
-
-    if (!currentLine.empty()) {
-      wrapped.push_back(currentLine);
-    } else if (wrapped.empty() || !wrapped.back().empty()) {
-      wrapped.emplace_back();
-    }
-  }
-
-  if (!processedAny) {
-    return wrapped;
-  }
-
-  while (!wrapped.empty() && wrapped.back().empty()) {
-    wrapped.pop_back();
-  }
-  return wrapped;
-}
-
-float drawWrappedLines(const std::vector<std::string> &lines, glm::vec2 pos,
-                       const ui::TextStyle &style) {
-  if (lines.empty()) {
-    return 0.f;
-  }
-
-  float y = pos.y;
-  float advance = lineAdvanceForStyle(style);
-  for (size_t i = 0; i < lines.size(); ++i) {
-    if (!lines[i].empty()) {
-      ui::DrawText(lines[i], glm::vec2{pos.x, y}, style);
-    }
-    if (i + 1 < lines.size()) {
-      y += advance;
-    }
-  }
-
-  return blockHeightForLines(lines, style);
-}
+const std::string kHowToPlayText = joinLines(kHowToPlayLines);
 
 struct PreviewScoreResult {
   std::vector<ScoreLine> lines;
@@ -202,6 +121,15 @@ PreviewScoreResult computePreviewScores(const GameState &state) {
   return result;
 }
 
+// m_CardCache keys: what is drawn in the top byte, then everything its pixels depend on
+enum CompositeKind : uint64_t { kCompositeCardFace = 1, kCompositeCardBack = 2, kCompositeBuild = 3 };
+
+uint64_t compositeKey(CompositeKind kind, uint64_t content, std::initializer_list<bool> flags) {
+  uint64_t bits = 0;
+  for (bool flag : flags) bits = (bits << 1) | (flag ? 1u : 0u);
+  return (uint64_t)kind << 56 | content << 16 | bits;
+}
+
 }  // namespace
 glm::mat4 KasinoGame::buildCardTransform(const Rect &rect, float rotation) {
   glm::vec2 size(rect.w, rect.h);
@@ -224,11 +152,18 @@ bool KasinoGame::OnStart() {
   }
 
   loadCardTextures();
+  Render2D::SetDeferred(true);
+  SetRedrawMode(RedrawMode::OnDemand);
+  if (!m_CardCache.Init()) {
+    EN_WARN("Card composite cache unavailable; cards draw layer by layer");
+  }
 
   m_Window->SetResizeCallback([this](int fbW, int fbH, float) {
     (void)fbW;
     (void)fbH;
-    // Camera logical size stays constant; rendering already handles resize.
+    // Camera logical size stays constant, but baked cards are at the old pixel scale
+    m_CardCache.Clear();
+    ++m_SceneVersion;
   });
 
   m_Input = std::make_unique<InputSystem>(m_Window->Events());
@@ -287,48 +222,55 @@ bool KasinoGame::OnStart() {
 }
 
 void KasinoGame::loadCardTextures() {
-  m_CardTextures.clear();
+  m_CardSprites.fill(Sprite{});
+  m_CardBackSprite = Sprite{};
 
   const std::array<Suit, 4> suits = {Suit::Clubs,
 				     Suit::Diamonds,
 				     Suit::Hearts,
 				     Suit::Spades};
 
+  // 214x227 faces (216x229 padded): 9 per row, 6 rows -> a single 2048x1376 page,
+  // with room left for the built-in font. The page is a texture-array layer, so
+  // cards, flat quads and text all batch without texture slots.
+  constexpr uint32_t kAtlasW = 2048, kAtlasH = 1376, kAtlasLayers = 2;
+  TextureAtlas atlas(kAtlasW, kAtlasH);
+  atlas.SetTextureArray(Render2D::EnableTextureArray(kAtlasW, kAtlasH, kAtlasLayers));
+  std::array<int, 52> faceIds;
+  faceIds.fill(-1);
   for (Suit suit : suits) {
     for (int value = RankValue(Rank::Ace);
          value <= RankValue(Rank::King); ++value) {
       Rank rank = static_cast<Rank>(value);
       Card card(rank, suit);
-      std::string key = cardTextureKey(card);
       std::string path = cardTexturePath(card);
 
-      auto texture = Factory::CreateTexture2D();
-      if (!texture) {
-        EN_ERROR("Failed to create texture for card {} from {}", key, path);
+      int id = atlas.AddFromFile(path, false);
+      if (id < 0) {
+        EN_ERROR("Failed to load texture for card {} from {}", card.ToString(), path);
         continue;
       }
-
-      if (texture->LoadFromFile(path.c_str(), false)) {
-        m_CardTextures[key] = texture;
-      } else {
-        EN_ERROR("Failed to load texture for card {} from {}", key, path);
-      }
+      faceIds[cardSpriteIndex(card)] = id;
     }
   }
 
   const std::string backPath =
       "Resources/Cards/Standard/rect_cards/individual/card back/card_back_rect_1.png";
-  auto backTexture = Factory::CreateTexture2D();
-  if (backTexture && backTexture->LoadFromFile(backPath.c_str(), true)) {
-    m_CardBackTexture = backTexture;
-  } else {
-    m_CardBackTexture.reset();
+  int backId = atlas.AddFromFile(backPath, true);
+  if (backId < 0)
     EN_ERROR("Failed to load card back texture: {}", backPath);
+
+  if (!atlas.Build()) {
+    EN_ERROR("Failed to upload card atlas");
+    return;
   }
+  for (size_t i = 0; i < faceIds.size(); ++i)
+    m_CardSprites[i] = atlas.Get(faceIds[i]);
+  m_CardBackSprite = atlas.Get(backId);
 }
 
-std::string KasinoGame::cardTextureKey(const Card &card) const {
-  return card.ToString();
+int KasinoGame::cardSpriteIndex(const Card &card) {
+  return static_cast<int>(card.suit) * 13 + RankValue(card.rank) - 1;
 }
 
 std::string KasinoGame::cardTexturePath(const Card &card) const {
@@ -368,8 +310,9 @@ std::string KasinoGame::cardSuitFolder(Suit suit) const {
 
 void KasinoGame::OnStop() {
   m_Input.reset();
-  m_CardTextures.clear();
-  m_CardBackTexture.reset();
+  m_CardCache.Shutdown();
+  m_CardSprites.fill(Sprite{});
+  m_CardBackSprite = Sprite{};
   Render2D::Shutdown();
 }
 
@@ -584,6 +527,7 @@ void KasinoGame::updateMainMenuLayout() {
 }
 
 void KasinoGame::updateLayout() {
+  EN_PROFILE_FUNCTION();
   float width = m_Camera.LogicalWidth();
   float height = m_Camera.LogicalHeight();
   float margin = 16.f;
@@ -839,8 +783,7 @@ void KasinoGame::updatePromptLayout() {
     ui::TextStyle style;
     style.scale = 2.6f;
     float textMaxWidth = boxWidth - 32.f;
-    auto howLines = wrapText(joinLines(kHowToPlayLines), style, textMaxWidth);
-    float textHeight = blockHeightForLines(howLines, style);
+    float textHeight = ui::LayoutText(kHowToPlayText, style, textMaxWidth).size.y;
     float contentBottom = kPromptTextStart + textHeight;
     float requiredHeight =
         contentBottom + buttonSpacing + buttonHeight + buttonBottomPadding;
@@ -871,14 +814,14 @@ void KasinoGame::updatePromptLayout() {
     ui::TextStyle secondary;
     secondary.scale = 3.f;
     float totalTextHeight = 0.f;
-    totalTextHeight += blockHeightForLines(
-        wrapText(kSettingsParagraph1, primary, textMaxWidth), primary);
+    totalTextHeight +=
+        ui::LayoutText(kSettingsParagraph1, primary, textMaxWidth).size.y;
     totalTextHeight += paragraphSpacing;
-    totalTextHeight += blockHeightForLines(
-        wrapText(kSettingsParagraph2, secondary, textMaxWidth), secondary);
+    totalTextHeight +=
+        ui::LayoutText(kSettingsParagraph2, secondary, textMaxWidth).size.y;
     totalTextHeight += paragraphSpacing;
-    totalTextHeight += blockHeightForLines(
-        wrapText(kSettingsParagraph3, secondary, textMaxWidth), secondary);
+    totalTextHeight +=
+        ui::LayoutText(kSettingsParagraph3, secondary, textMaxWidth).size.y;
     settingsParagraphHeight = totalTextHeight;
     ui::TextStyle volumeLabelStyle;
     volumeLabelStyle.scale = kVolumeLabelScale;
@@ -898,9 +841,9 @@ void KasinoGame::updatePromptLayout() {
     ui::TextStyle descStyle;
     descStyle.scale = 3.f;
     float textMaxWidth = boxWidth - 32.f;
-    auto descLines = wrapText(difficultyDescription(m_MenuDifficulty), descStyle,
-                              textMaxWidth);
-    float descHeight = blockHeightForLines(descLines, descStyle);
+    float descHeight = ui::LayoutText(difficultyDescription(m_MenuDifficulty),
+                                      descStyle, textMaxWidth)
+                           .size.y;
     mainMenuSettingsDescHeight = descHeight;
     float optionBottom =
         kMainMenuSettingsOptionTop + kMainMenuSettingsOptionHeight;
@@ -2001,10 +1944,33 @@ void KasinoGame::PlayEventSound(const Ref<IAudioBuffer> &buffer) {
   }
 }
 void KasinoGame::OnUpdate(float dt) {
+  EN_PROFILE_ZONE("KasinoGame::OnUpdate");
   if (!m_Input)
     return;
 
+  // F3: profiler overlay, F4: dump the profiler rings as a Chrome trace
+  if (m_Input->WasKeyPressed(Key::F3)) {
+    m_ShowProfiler = !m_ShowProfiler;
+  }
+  if (m_Input->WasKeyPressed(Key::F4)) {
+    if (Profiler::WriteChromeTrace(kTraceFileName)) {
+      EN_INFO("profiler trace written to {}", kTraceFileName);
+    } else {
+      EN_WARN("could not write profiler trace {}", kTraceFileName);
+    }
+  }
+
   bool escapePressed = m_Input->WasKeyPressed(Key::Escape);
+  const bool inputActive = escapePressed ||
+                           m_Input->WasMousePressed(MouseButton::Left) ||
+                           m_Input->WasMouseReleased(MouseButton::Left) ||
+                           m_Input->IsMouseDown(MouseButton::Left);
+  const bool wasAnimating =
+      !m_DealQueue.empty() || m_IsDealing || m_PendingMove.has_value();
+  const Phase phaseBefore = m_Phase;
+  const PromptMode promptBefore = m_PromptMode;
+  const bool showPromptBefore = m_ShowPrompt;
+  const uint64_t hoverBefore = hoverSignature();
   if (escapePressed) {
     if (m_ShowPrompt && m_PromptMode == PromptMode::Settings) {
       m_AdjustingVolume = false;
@@ -2174,9 +2140,49 @@ void KasinoGame::OnUpdate(float dt) {
     }
   }
 
+  // Retained regions (drawScene) re-record only when something they draw may have
+  // changed; a mouse move that doesn't change any hover state costs nothing
+  const glm::vec2 viewSize{m_Camera.LogicalWidth(), m_Camera.LogicalHeight()};
+  const bool animating =
+      !m_DealQueue.empty() || m_IsDealing || m_PendingMove.has_value();
+  if (inputActive || wasAnimating || animating || m_Phase != phaseBefore ||
+      m_PromptMode != promptBefore || m_ShowPrompt != showPromptBefore ||
+      viewSize != m_LastViewSize) {
+    ++m_SceneVersion;
+  }
+  m_LastViewSize = viewSize;
+  if (hoverSignature() != hoverBefore) {
+    ++m_HoverVersion;
+  }
+
   m_Input->BeginFrame();
 }
 
+bool KasinoGame::WantsRedraw() const {
+  if (!m_DealQueue.empty() || m_IsDealing || m_PendingMove || m_AdjustingVolume ||
+      m_ShowProfiler) {
+    return true;
+  }
+  // an AI seat to move starts its turn on the next update
+  return !m_ShowPrompt && m_Phase == Phase::Playing &&
+         m_State.current >= 0 && m_State.current < m_State.numPlayers &&
+         m_State.current < static_cast<int>(m_IsAiPlayer.size()) &&
+         m_IsAiPlayer[m_State.current] && !m_State.RoundOver();
+}
+
+uint64_t KasinoGame::hoverSignature() const {
+  // FNV-1a over everything the retained regions read for hover highlights
+  uint64_t h = 1469598103934665603ull;
+  auto mix = [&h](uint64_t v) { h = (h ^ v) * 1099511628211ull; };
+  mix(static_cast<uint64_t>(m_HoveredAction + 1));
+  for (int idx : m_HoveredLoose) mix(static_cast<uint64_t>(idx) + 0x100);
+  for (int idx : m_HoveredBuilds) mix(static_cast<uint64_t>(idx) + 0x200);
+  mix(m_SettingsButtonHovered ? 1 : 0);
+  mix(m_ConfirmButtonRect.Contains(m_LastMousePos.x, m_LastMousePos.y) ? 1 : 0);
+  mix(m_CancelButtonRect.Contains(m_LastMousePos.x, m_LastMousePos.y) ? 1 : 0);
+  return h;
+}
+
 void KasinoGame::drawCardFace(const Card &card, const Rect &r,
                               bool isCurrent, bool selected, bool legal,
                               bool hovered) {
@@ -2186,9 +2192,41 @@ void KasinoGame::drawCardFace(const Card &card, const Rect &r,
 void KasinoGame::drawCardFace(const Card &card, const Rect &r,
                               float rotation, bool isCurrent, bool selected,
                               bool legal, bool hovered) {
+  const bool textured = (bool)m_CardSprites[cardSpriteIndex(card)];
+  // the flat fallback has a border, and rank/suit labels only when upright
+  const bool labels = !textured && rotation == 0.f;
+  const Rect bounds =
+      textured ? r : Rect{r.x - 2.f, r.y - 2.f, r.w + 4.f, r.h + 4.f};
+  const uint64_t key =
+      compositeKey(kCompositeCardFace, (uint64_t)cardSpriteIndex(card),
+                   {labels, isCurrent, selected, legal, hovered});
+  const Sprite *baked = m_CardCache.Get(
+      key, glm::vec2{bounds.w, bounds.h}, [=, this](const glm::vec2 &origin) {
+        const Rect local{origin.x + (r.x - bounds.x), origin.y + (r.y - bounds.y),
+                         r.w, r.h};
+        drawCardFaceLayers(card, local, 0.f, labels, isCurrent, selected,
+                           legal, hovered);
+      });
+  if (baked) {
+    drawComposite(*baked, bounds, rotation);
+    return;
+  }
+  drawCardFaceLayers(card, r, rotation, labels, isCurrent, selected, legal,
+                     hovered);
+}
+
+void KasinoGame::drawCardFaceLayers(const Card &card, const Rect &r,
+                                    float rotation, bool labels,
+                                    bool isCurrent, bool selected, bool legal,
+                                    bool hovered) {
+  // same geometry as buildCardTransform, but as sprite records (no matrices)
+  auto cardQuad = [&](const Rect &rect, const glm::vec4 &color,
+                      const Sprite *image = nullptr) {
+    return Render2D::SpriteDesc{glm::vec2{rect.x, rect.y},
+                                glm::vec2{rect.w, rect.h}, rotation, color,
+                                image};
+  };
   Rect borderRect{r.x - 2.f, r.y - 2.f, r.w + 4.f, r.h + 4.f};
-  glm::mat4 borderTransform = buildCardTransform(borderRect, rotation);
-  glm::mat4 cardTransform = buildCardTransform(r, rotation);
 
   glm::vec4 borderColor = glm::vec4(0.05f, 0.05f, 0.05f, 1.0f);
 
@@ -2199,27 +2237,34 @@ void KasinoGame::drawCardFace(const Card &card, const Rect &r,
   }
 
   bool drewTexture = false;
-  auto textureIt = m_CardTextures.find(cardTextureKey(card));
-  if (textureIt != m_CardTextures.end() && textureIt->second) {
-    Render2D::DrawQuad(cardTransform, textureIt->second, 1.0f, baseTint);
+  const Sprite &face = m_CardSprites[cardSpriteIndex(card)];
+  nextLayer();
+  if (face) {
+    const Render2D::SpriteDesc quad = cardQuad(r, baseTint, &face);
+    Render2D::DrawQuads({&quad, 1});
     drewTexture = true;
   } else {
-
-      Render2D::DrawQuad(borderTransform, borderColor);
-    Render2D::DrawQuad(cardTransform, baseTint);
+    const std::array<Render2D::SpriteDesc, 2> quads = {
+        cardQuad(borderRect, borderColor), cardQuad(r, baseTint)};
+    Render2D::DrawQuads(quads);
   }
+  nextLayer();
 
+  // highlights share a layer: one submission for all of them
+  std::array<Render2D::SpriteDesc, 3> highlights;
+  size_t highlightCount = 0;
   if (legal)
-    Render2D::DrawQuad(cardTransform,
-                       glm::vec4(0.2f, 0.45f, 0.9f, 0.25f));
+    highlights[highlightCount++] =
+        cardQuad(r, glm::vec4(0.2f, 0.45f, 0.9f, 0.25f));
   if (hovered)
-    Render2D::DrawQuad(cardTransform,
-                       glm::vec4(0.95f, 0.55f, 0.25f, 0.4f));
+    highlights[highlightCount++] =
+        cardQuad(r, glm::vec4(0.95f, 0.55f, 0.25f, 0.4f));
   if (selected)
-    Render2D::DrawQuad(cardTransform,
-                       glm::vec4(0.95f, 0.85f, 0.2f, 0.45f));
+    highlights[highlightCount++] =
+        cardQuad(r, glm::vec4(0.95f, 0.85f, 0.2f, 0.45f));
+  Render2D::DrawQuads({highlights.data(), highlightCount});
 
-  if (!drewTexture && rotation == 0.f) {
+  if (!drewTexture && labels) {
     auto rankString = [&]() {
       switch (card.rank) {
       case Rank::Ace:
@@ -2267,15 +2312,35 @@ void KasinoGame::drawCardBack(const Rect &r, bool isCurrent) {
 }
 
 void KasinoGame::drawCardBack(const Rect &r, bool isCurrent, float rotation) {
+  const bool textured = (bool)m_CardBackSprite;
+  const Rect bounds =
+      textured ? r : Rect{r.x - 2.f, r.y - 2.f, r.w + 4.f, r.h + 4.f};
+  const Sprite *baked = m_CardCache.Get(
+      compositeKey(kCompositeCardBack, 0, {isCurrent}),
+      glm::vec2{bounds.w, bounds.h}, [=, this](const glm::vec2 &origin) {
+        drawCardBackLayers(Rect{origin.x + (r.x - bounds.x),
+                                origin.y + (r.y - bounds.y), r.w, r.h},
+                           isCurrent, 0.f);
+      });
+  if (baked) {
+    drawComposite(*baked, bounds, rotation);
+    return;
+  }
+  drawCardBackLayers(r, isCurrent, rotation);
+}
+
+void KasinoGame::drawCardBackLayers(const Rect &r, bool isCurrent,
+                                    float rotation) {
   Rect borderRect{r.x - 2.f, r.y - 2.f, r.w + 4.f, r.h + 4.f};
   glm::mat4 borderTransform = buildCardTransform(borderRect, rotation);
   glm::mat4 cardTransform = buildCardTransform(r, rotation);
 
   glm::vec4 borderColor = glm::vec4(0.05f, 0.05f, 0.05f, 1.0f);
 
-  if (m_CardBackTexture) {
-    Render2D::DrawQuad(cardTransform, m_CardBackTexture, 1.0f,
-                       glm::vec4(1.0f));
+  nextLayer();
+  if (m_CardBackSprite) {
+    Render2D::DrawQuad(cardTransform, m_CardBackSprite, glm::vec4(1.0f));
+    nextLayer();
     if (isCurrent) {
       Render2D::DrawQuad(cardTransform,
                          glm::vec4(0.95f, 0.75f, 0.35f, 0.35f));
@@ -2314,6 +2379,26 @@ void KasinoGame::drawCardBack(const Rect &r, bool isCurrent, float rotation) {
 
 void KasinoGame::drawBuildFace(const Build &build, const Rect &r,
                                bool legal, bool hovered, bool selected) {
+  const Rect bounds{r.x - 2.f, r.y - 2.f, r.w + 4.f, r.h + 4.f};
+  const uint64_t owner = (uint64_t)std::max(build.ownerPlayer, 0) %
+                         m_PlayerColors.size();
+  const uint64_t key =
+      compositeKey(kCompositeBuild, (uint64_t)build.value << 8 | owner,
+                   {legal, hovered, selected});
+  const Sprite *baked = m_CardCache.Get(
+      key, glm::vec2{bounds.w, bounds.h}, [=, this](const glm::vec2 &origin) {
+        drawBuildFaceLayers(build, Rect{origin.x + 2.f, origin.y + 2.f, r.w, r.h},
+                            legal, hovered, selected);
+      });
+  if (baked) {
+    drawComposite(*baked, bounds, 0.f);
+    return;
+  }
+  drawBuildFaceLayers(build, r, legal, hovered, selected);
+}
+
+void KasinoGame::drawBuildFaceLayers(const Build &build, const Rect &r,
+                                     bool legal, bool hovered, bool selected) {
   int ownerIndex = build.ownerPlayer >= 0 ? build.ownerPlayer : 0;
   glm::vec4 ownerColor =
       m_PlayerColors[ownerIndex % m_PlayerColors.size()];
@@ -2339,6 +2424,20 @@ void KasinoGame::drawBuildFace(const Build &build, const Rect &r,
            glm::vec4(0.05f, 0.05f, 0.05f, 1.0f));
 }
 
+// A baked composite from m_CardCache: one premultiplied quad, on a layer of its own
+// like the card faces it stands in for.
+void KasinoGame::drawComposite(const Sprite &sprite, const Rect &bounds,
+                               float rotation) {
+  nextLayer();
+  Render2D::SetBlendMode(BlendMode::Premultiplied);
+  const Render2D::SpriteDesc quad{glm::vec2{bounds.x, bounds.y},
+                                  glm::vec2{bounds.w, bounds.h}, rotation,
+                                  glm::vec4(1.0f), &sprite};
+  Render2D::DrawQuads({&quad, 1});
+  Render2D::SetBlendMode(BlendMode::Alpha);
+  nextLayer();
+}
+
 void KasinoGame::drawScoreboard() {
     float width = m_Camera.LogicalWidth();
     Rect bar{0.f, 0.f, width, m_ScoreboardHeight};
@@ -2391,9 +2490,9 @@ void KasinoGame::drawScoreboard() {
     const float rowSpacing = 3.f;
     const float headerSpacing = 10.f;
 
-    std::string roundLabel = "ROUND " + std::to_string(m_RoundNumber);
-    std::string turnText   = "TURN P" + std::to_string(m_State.current + 1);
-    std::string deckText   = "DECK " + std::to_string((int)m_State.stock.size());
+    const std::string& roundLabel = m_ScoreboardText.round.Text(m_RoundNumber);
+    const std::string& turnText   = m_ScoreboardText.turn.Text(m_State.current + 1);
+    const std::string& deckText   = m_ScoreboardText.deck.Text((int)m_State.stock.size());
 
     // 3 equal slots in available area
     float L0 = columnAreaLeft;
@@ -2470,7 +2569,8 @@ void KasinoGame::drawScoreboard() {
         float curY = y0 + 10.f;
         float textMax = std::max(0.f, cellW - 16.f);
 
-        std::string playerLabel = "PLAYER " + std::to_string(i + 1);
+        ScoreboardText::Seat& seatText = m_ScoreboardText.seats[i % m_ScoreboardText.seats.size()];
+        const std::string& playerLabel = seatText.player.Text(i + 1);
         float pxLabel = clampFitPx(playerLabel, 3.5f, textMax);
         ui::DrawText(playerLabel, glm::vec2{innerX, curY}, pxLabel, color);
         curY += ui::MeasureText(playerLabel, pxLabel).y + 3.f;
@@ -2488,14 +2588,14 @@ void KasinoGame::drawScoreboard() {
             }
         }
 
-        std::string totalText = "TOTAL " + std::to_string(total);
+        const std::string& totalText = seatText.total.Text(total);
         float pxTotal = clampFitPx(totalText, 3.0f, textMax);
         ui::DrawText(totalText, glm::vec2{innerX, curY}, pxTotal,
                      glm::vec4(0.95f, 0.95f, 0.95f, 1.0f));
         curY += ui::MeasureText(totalText, pxTotal).y + 3.f;
 
-        auto drawStat = [&](const std::string& label, int value) {
-            std::string text = label + " +" + std::to_string(value);
+        auto drawStat = [&](ui::NumberLabel& label, int value) {
+            const std::string& text = label.Text(value);
             float px = clampFitPx(text, 2.6f, textMax);
             ui::DrawText(text, glm::vec2{innerX, curY}, px,
                          glm::vec4(0.9f, 0.94f, 0.92f, 1.0f));
@@ -2514,9 +2614,9 @@ void KasinoGame::drawScoreboard() {
             sweepBonus = player.sweepBonus;
         }
 
-        drawStat("CARDS", cardPoints);
-        drawStat("BUILDS", buildBonus);
-        drawStat("SWEEPS", sweepBonus);
+        drawStat(seatText.cards, cardPoints);
+        drawStat(seatText.builds, buildBonus);
+        drawStat(seatText.sweeps, sweepBonus);
     }
 
     // ===== SETTINGS GEAR (DRAW LAST) =====
@@ -2646,7 +2746,8 @@ void KasinoGame::drawHands() {
       };
 
       if (anim) {
-        float t = anim->progress;
+        float t = anim->progress +
+                  m_RenderAlpha * GetFrameTiming().FixedStep / kDealAnimDuration;
         if (t < 0.f)
           t = 0.f;
         if (t > 1.f)
@@ -2778,7 +2879,10 @@ void KasinoGame::drawTable() {
       for (const auto &pt : targetCenters) targetCenter += pt;
       targetCenter /= static_cast<float>(targetCenters.size());
 
-      float t = std::clamp(m_PendingMove->progress, 0.f, 1.f);
+      float t = std::clamp(m_PendingMove->progress +
+                               m_RenderAlpha * GetFrameTiming().FixedStep /
+                                   kAiAnimDuration,
+                           0.f, 1.f);
       glm::vec2 currentCenter = glm::mix(startCenter, targetCenter, t);
       Rect cardRect{currentCenter.x - m_CardWidth * 0.5f,
                     currentCenter.y - m_CardHeight * 0.5f, m_CardWidth,
@@ -3034,8 +3138,8 @@ void KasinoGame::drawPromptOverlay() {
     float descX = m_PromptBoxRect.x + 16.f;
     float descY = m_PromptBoxRect.y + kMainMenuSettingsDescriptionTop;
     float descMaxWidth = m_PromptBoxRect.w - 32.f;
-    auto descLines = wrapText(desc, descStyle, descMaxWidth);
-    drawWrappedLines(descLines, glm::vec2{descX, descY}, descStyle);
+    ui::DrawTextLayout(ui::LayoutText(desc, descStyle, descMaxWidth),
+                       glm::vec2{descX, descY}, descStyle.color);
 
     drawVolumeControls();
   } else if (m_PromptMode == PromptMode::HowToPlay) {
@@ -3045,8 +3149,8 @@ void KasinoGame::drawPromptOverlay() {
     float textX = m_PromptBoxRect.x + 16.f;
     float textY = m_PromptBoxRect.y + kPromptTextStart;
     float maxWidth = m_PromptBoxRect.w - 32.f;
-    auto howLines = wrapText(joinLines(kHowToPlayLines), howStyle, maxWidth);
-    drawWrappedLines(howLines, glm::vec2{textX, textY}, howStyle);
+    ui::DrawTextLayout(ui::LayoutText(kHowToPlayText, howStyle, maxWidth),
+                       glm::vec2{textX, textY}, howStyle.color);
   } else if (m_PromptMode == PromptMode::Settings) {
     float textX = m_PromptBoxRect.x + 16.f;
     float textY = m_PromptBoxRect.y + kPromptTextStart;
@@ -3060,18 +3164,19 @@ void KasinoGame::drawPromptOverlay() {
     secondaryStyle.scale = 3.f;
     secondaryStyle.color = glm::vec4(0.8f, 0.85f, 0.9f, 1.0f);
 
-    auto paragraph1 = wrapText(kSettingsParagraph1, primaryStyle, maxWidth);
-    float height1 = drawWrappedLines(paragraph1, glm::vec2{textX, textY},
-                                     primaryStyle);
-    textY += height1 + paragraphSpacing;
+    const ui::TextLayout &paragraph1 =
+        ui::LayoutText(kSettingsParagraph1, primaryStyle, maxWidth);
+    ui::DrawTextLayout(paragraph1, glm::vec2{textX, textY}, primaryStyle.color);
+    textY += paragraph1.size.y + paragraphSpacing;
 
-    auto paragraph2 = wrapText(kSettingsParagraph2, secondaryStyle, maxWidth);
-    float height2 = drawWrappedLines(paragraph2, glm::vec2{textX, textY},
-                                     secondaryStyle);
-    textY += height2 + paragraphSpacing;
+    const ui::TextLayout &paragraph2 =
+        ui::LayoutText(kSettingsParagraph2, secondaryStyle, maxWidth);
+    ui::DrawTextLayout(paragraph2, glm::vec2{textX, textY},
+                       secondaryStyle.color);
+    textY += paragraph2.size.y + paragraphSpacing;
 
-    auto paragraph3 = wrapText(kSettingsParagraph3, secondaryStyle, maxWidth);
-    drawWrappedLines(paragraph3, glm::vec2{textX, textY}, secondaryStyle);
+    ui::DrawTextLayout(ui::LayoutText(kSettingsParagraph3, secondaryStyle, maxWidth),
+                       glm::vec2{textX, textY}, secondaryStyle.color);
 
     drawVolumeControls();
 
@@ -3132,16 +3237,48 @@ void KasinoGame::drawPromptOverlay() {
   }
 }
 
+// Render2D runs deferred: within a layer quads are grouped by texture, so anything that
+// overlaps something with a different texture (card art vs. flat quads) starts a new
+// layer. Cards take two layers each (face, then overlays/labels).
+void KasinoGame::nextLayer() { Render2D::SetLayer(++m_DrawLayer); }
+
+// Replays the region's draw list, re-recording it first if the version moved on.
+void KasinoGame::drawRetained(Render2D::DrawList &list, uint64_t version,
+                              void (KasinoGame::*draw)()) {
+  if (!list.IsCurrent(version)) {
+    Render2D::BeginDrawList(list, version);
+    (this->*draw)();
+    Render2D::EndDrawList();
+  }
+  Render2D::SubmitDrawList(list);
+  m_DrawLayer = Render2D::GetLayer();
+}
+
 void KasinoGame::drawScene() {
+  EN_PROFILE_FUNCTION();
+  m_DrawLayer = 0;
+  Render2D::SetLayer(0);
   if (m_Phase == Phase::MainMenu) {
     drawMainMenu();
   } else {
-    drawTable();
-    drawActionPanel();
-    drawHands();
-    drawScoreboard();
-  }
+    // hands don't show hover state, the other regions do
+    const uint64_t hoverVersion = (m_SceneVersion << 32) | (m_HoverVersion & 0xFFFFFFFFu);
+    drawRetained(m_TableList, hoverVersion, &KasinoGame::drawTable);
+    nextLayer();
+    drawRetained(m_ActionPanelList, hoverVersion, &KasinoGame::drawActionPanel);
+    nextLayer();
+    drawRetained(m_HandsList, m_SceneVersion, &KasinoGame::drawHands);
+    nextLayer();
+    drawRetained(m_ScoreboardList, hoverVersion, &KasinoGame::drawScoreboard);
+  }
+  nextLayer();
   drawPromptOverlay();
+
+  if (m_ShowProfiler) {
+    nextLayer();
+    float width = m_Camera.LogicalWidth();
+    ui::DrawProfilerOverlay(glm::vec2{8.f, 8.f}, std::min(360.f, width - 16.f));
+  }
 }
 
 void KasinoGame::drawMainMenu() {
@@ -3202,4 +3339,24 @@ void KasinoGame::drawMainMenu() {
            glm::vec4(0.75f, 0.8f, 0.85f, 1.0f));
 }
 
-void KasinoGame::OnRender() { drawScene(); }
+void KasinoGame::OnRender(float alpha) {
+  m_RenderAlpha = alpha;
+  if (!m_DealQueue.empty() || m_PendingMove) {
+    // interpolated positions move even on frames without an update step
+    ++m_SceneVersion;
+  }
+
+  // cards missed last frame are baked before anything is drawn; the retained regions
+  // then re-record with the baked quads
+  auto [fbW, fbH] = m_Window->GetFramebufferSize();
+  auto [lw, lh] = m_Window->GetLogicalSize();
+  m_CardCache.SetPixelScale(
+      (float)ComputePixelPerfectViewport((int)fbW, (int)fbH, (int)lw, (int)lh).scale);
+  if (m_CardCache.BakePending(m_Camera)) {
+    ++m_SceneVersion;
+  }
+  drawScene();
+  if (m_CardCache.HasPending()) {
+    RequestRedraw();
+  }
+}
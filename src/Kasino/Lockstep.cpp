@@ -0,0 +1,182 @@
+#include "Kasino/Lockstep.h"
+#include "Kasino/GameLogic.h"
+
+enum : uint8_t { kMsgHello = 1, kMsgMove = 2, kMsgChecksum = 3 };
+
+static void put16(uint8_t* p, uint32_t v){ p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static void put32(uint8_t* p, uint32_t v){ put16(p, v); put16(p + 2, v >> 16); }
+static uint32_t get16(const uint8_t* p){ return p[0] | (p[1] << 8); }
+static uint32_t get32(const uint8_t* p){ return get16(p) | (get16(p + 2) << 16); }
+
+static uint32_t fold32(uint64_t h){ return (uint32_t)(h ^ (h >> 32)); }
+
+// ---------- loopback
+
+void LoopbackTransport::Send(const uint8_t* data, size_t size){
+  std::lock_guard<std::mutex> g(m_Out->lock);
+  m_Out->queue.emplace_back(data, data + size);
+  m_Out->bytes += size;
+}
+
+bool LoopbackTransport::Receive(std::vector<uint8_t>& out){
+  std::lock_guard<std::mutex> g(m_In->lock);
+  if (m_In->queue.empty()) return false;
+  out = std::move(m_In->queue.front());
+  m_In->queue.pop_front();
+  return true;
+}
+
+std::pair<Ref<LoopbackTransport>, Ref<LoopbackTransport>> LoopbackTransport::CreatePair(){
+  auto ab = CreateRef<Channel>();
+  auto ba = CreateRef<Channel>();
+  return { CreateRef<LoopbackTransport>(ab, ba), CreateRef<LoopbackTransport>(ba, ab) };
+}
+
+// ---------- session
+
+LockstepSession::LockstepSession(const LockstepConfig& cfg) : m_Config(cfg) {
+  if (m_Config.seatPeer.empty())
+    for (int s=0; s<m_Config.numPlayers; ++s) m_Config.seatPeer.push_back(s % m_Config.numPeers);
+  m_Peers.resize(m_Config.numPeers);
+  m_SeedShares.assign(m_Config.numPeers, 0);
+  m_HaveShare.assign(m_Config.numPeers, false);
+}
+
+void LockstepSession::AddPeer(int peer, Ref<ILockstepTransport> transport){
+  if (peer < 0 || peer >= m_Config.numPeers || peer == m_Config.localPeer) return;
+  m_Peers[peer] = std::move(transport);
+}
+
+void LockstepSession::broadcast(const uint8_t* data, size_t size){
+  for (auto& t : m_Peers) if (t) t->Send(data, size);
+}
+
+void LockstepSession::Start(uint32_t seedShare){
+  m_SeedShares[m_Config.localPeer] = seedShare;
+  m_HaveShare[m_Config.localPeer] = true;
+  uint8_t msg[6] = { kMsgHello, (uint8_t)m_Config.localPeer };
+  put32(msg + 2, seedShare);
+  broadcast(msg, sizeof(msg));
+  Poll();
+}
+
+void LockstepSession::Poll(){
+  std::vector<uint8_t> msg;
+  for (int p=0; p<(int)m_Peers.size(); ++p) {
+    if (!m_Peers[p]) continue;
+    while (m_Peers[p]->Receive(msg)) onMessage(p, msg);
+  }
+
+  if (!m_Started) {
+    for (bool have : m_HaveShare) if (!have) return;
+    uint32_t seed = 0;
+    for (uint32_t s : m_SeedShares) seed ^= s;
+    StartRound(m_State, m_Config.numPlayers, seed ? seed : 1u); // 0 would mean "random"
+    m_Turn = 0;
+    m_Started = true;
+  }
+
+  // moves that arrived ahead of a slower link; after a desync nothing more is applied
+  while (m_DesyncTurn < 0) {
+    auto it = m_PendingMoves.find(m_Turn);
+    if (it == m_PendingMoves.end()) break;
+    auto [peer, code] = it->second;
+    m_PendingMoves.erase(it);
+    const int seat = m_State.current;
+    if (m_Config.seatPeer[seat] != peer || !applyCode(seat, code)) {
+      // a peer played out of turn or an illegal code: the states can't agree anymore
+      if (m_DesyncTurn < 0) { m_DesyncTurn = m_Turn; if (OnDesync) OnDesync(m_Turn); }
+      break;
+    }
+  }
+  // repeats and moves for turns we already played can never apply; don't keep them all match
+  if (Desynced()) m_PendingMoves.clear();
+  else if (!m_PendingMoves.empty())
+    std::erase_if(m_PendingMoves, [this](const auto& kv){ return (int16_t)(kv.first - m_Turn) < 0; });
+}
+
+void LockstepSession::onMessage(int peer, const std::vector<uint8_t>& msg){
+  if (msg.empty()) return;
+  switch (msg[0]) {
+  case kMsgHello:
+    if (msg.size() < 6 || msg[1] != peer) return;
+    m_SeedShares[peer] = get32(msg.data() + 2);
+    m_HaveShare[peer] = true;
+    break;
+  case kMsgMove:
+    if (msg.size() < 5) return;
+    m_PendingMoves[(uint16_t)get16(msg.data() + 1)] = { peer, (int)get16(msg.data() + 3) };
+    break;
+  case kMsgChecksum:
+    if (msg.size() < 7) return;
+    compareChecksum((uint16_t)get16(msg.data() + 1), get32(msg.data() + 3));
+    break;
+  default:
+    break;
+  }
+}
+
+bool LockstepSession::IsLocalTurn() const {
+  if (!m_Started || m_State.RoundOver() || Desynced()) return false;
+  return m_Config.seatPeer[m_State.current] == m_Config.localPeer;
+}
+
+bool LockstepSession::SubmitLocalMove(const Move& mv){
+  if (!IsLocalTurn()) return false;
+  const int code = EncodeMove(m_State, mv);
+  if (code < 0 || code > 0xffff) return false;
+  uint8_t msg[5] = { kMsgMove };
+  put16(msg + 1, m_Turn);
+  put16(msg + 3, (uint32_t)code);
+  broadcast(msg, sizeof(msg)); // before applying, so peers see it ahead of our checksum
+  applyCode(m_State.current, code);
+  Poll();
+  return true;
+}
+
+bool LockstepSession::applyCode(int seat, int code){
+  Move mv;
+  if (!DecodeMove(m_State, code, mv) || !ApplyMove(m_State, mv)) return false;
+  // same rule on every peer: when all hands are out, deal from the stock
+  if (m_State.HandsEmpty()) DealNextHands(m_State);
+  m_Turn++;
+  if (OnMoveApplied) OnMoveApplied(seat, mv);
+  afterTurn();
+  return true;
+}
+
+void LockstepSession::afterTurn(){
+  const int every = m_Config.checksumInterval > 0 ? m_Config.checksumInterval : 1;
+  if (m_Turn % every != 0 && !m_State.RoundOver()) return;
+
+  const uint32_t hash = fold32(StateChecksum(m_State));
+  m_LocalChecksums[m_Turn] = hash;
+  uint8_t msg[7] = { kMsgChecksum };
+  put16(msg + 1, m_Turn);
+  put32(msg + 3, hash);
+  broadcast(msg, sizeof(msg));
+
+  // a remote checksum for this turn may already be waiting
+  auto it = m_RemoteChecksums.find(m_Turn);
+  if (it != m_RemoteChecksums.end()) {
+    uint32_t remote = it->second;
+    m_RemoteChecksums.erase(it);
+    compareChecksum(m_Turn, remote);
+  }
+
+  // keep a bounded history; peers are never more than a few turns apart
+  if (m_LocalChecksums.size() > 64)
+    std::erase_if(m_LocalChecksums, [this, every](const auto& kv){ return (uint16_t)(m_Turn - kv.first) > 32 * every; });
+}
+
+void LockstepSession::compareChecksum(uint16_t turn, uint32_t remote){
+  auto it = m_LocalChecksums.find(turn);
+  if (it == m_LocalChecksums.end()) {
+    if ((int16_t)(turn - m_Turn) > 0 || !m_Started) m_RemoteChecksums[turn] = remote; // we're behind
+    return;
+  }
+  if (it->second != remote && m_DesyncTurn < 0) {
+    m_DesyncTurn = turn;
+    if (OnDesync) OnDesync(turn);
+  }
+}
@@ -0,0 +1,73 @@
+#include "Kasino/Search.h"
+#include "Kasino/GameLogic.h"
+#include <algorithm>
+#include <utility>
+
+static float marginFor(const SearchValue& v, int player, int numPlayers){
+  float best = -1e30f;
+  for (int p=0; p<numPlayers && p<4; ++p)
+    if (p != player) best = std::max(best, v.meanScore[p]);
+  return v.meanScore[player] - best;
+}
+
+static int bestIndex(const std::vector<float>& margins){
+  if (margins.empty()) return -1;
+  return (int)(std::max_element(margins.begin(), margins.end()) - margins.begin());
+}
+
+void MoveSearch::Evaluate(const GameState& gs, const PositionHash& hash, const std::vector<Move>& moves,
+                          const SearchConfig& cfg, std::vector<float>& margins){
+  margins.resize(moves.size(), 0.0f);
+  for (size_t i=0; i<moves.size(); ++i) {
+    GameState child = gs;
+    PositionHash h = hash;
+    if (!ApplyMove(child, moves[i], h)) { margins[i] -= 1e6f; continue; }
+
+    const uint64_t key = h.Key();
+    SearchValue fresh;
+    const SearchValue* v = m_Cache.Probe(key);
+    if (!v) {
+      const uint32_t seed = cfg.seed ^ (uint32_t)key ^ (uint32_t)(key >> 32);
+      RolloutStats st = BatchRollouts(child, cfg.gamesPerMove, seed);
+      for (int p=0; p<child.numPlayers && p<4; ++p)
+        fresh.meanScore[p] = st.games ? (float)st.totalScore[p] / (float)st.games : 0.0f;
+      m_Cache.Store(key, fresh);
+      v = &fresh;
+    }
+    margins[i] += marginFor(*v, gs.current, gs.numPlayers);
+  }
+}
+
+int MoveSearch::Choose(const GameState& gs, const std::vector<Move>& moves, const SearchConfig& cfg){
+  PositionHash hash; hash.Reset(gs);
+  std::vector<float> margins;
+  Evaluate(gs, hash, moves, cfg, margins);
+  return bestIndex(margins);
+}
+
+int MoveSearch::ChooseHidden(const GameState& gs, const std::vector<Move>& moves, const SearchConfig& cfg){
+  std::vector<float> margins;
+  for (int w=0; w<std::max(cfg.worlds, 1); ++w) {
+    GameState world = Determinize(gs, gs.current, cfg.seed + (uint32_t)w * 0x9E3779B9u);
+    PositionHash hash; hash.Reset(world);
+    Evaluate(world, hash, moves, cfg, margins);
+  }
+  return bestIndex(margins);
+}
+
+GameState Determinize(const GameState& gs, int viewer, uint32_t seed){
+  GameState out = gs;
+  std::vector<Card> hidden;
+  for (int p=0; p<(int)gs.players.size(); ++p)
+    if (p != viewer) hidden.insert(hidden.end(), gs.players[p].hand.begin(), gs.players[p].hand.end());
+  hidden.insert(hidden.end(), gs.stock.begin(), gs.stock.end());
+
+  RolloutRng rng(seed);
+  for (size_t i=hidden.size(); i>1; --i) std::swap(hidden[i-1], hidden[rng.Below((uint32_t)i)]);
+
+  size_t k = 0;
+  for (int p=0; p<(int)out.players.size(); ++p)
+    if (p != viewer) for (Card& c : out.players[p].hand) c = hidden[k++];
+  for (Card& c : out.stock) c = hidden[k++];
+  return out;
+}
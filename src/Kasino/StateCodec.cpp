@@ -0,0 +1,420 @@
+#include "Kasino/StateCodec.h"
+#include "Kasino/GameLogic.h"
+
+namespace {
+
+constexpr uint8_t kMagic0 = 'K';
+constexpr uint8_t kMagic1 = 'S';
+constexpr uint8_t kEdit = 0;
+constexpr uint8_t kReplace = 1;
+constexpr int kMaxRuns = 64;
+
+struct Writer {
+  uint8_t* p;
+  uint8_t* end;
+  bool ok = true;
+
+  void U8(uint32_t v) { if (p < end) *p++ = (uint8_t)v; else ok = false; }
+  void U16(uint32_t v) { U8(v & 0xff); U8(v >> 8); }
+  void U32(uint32_t v) { U16(v & 0xffff); U16(v >> 16); }
+  void Var(int32_t v) { // zigzag LEB128
+    uint32_t z = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+    while (z >= 0x80) { U8((z & 0x7f) | 0x80); z >>= 7; }
+    U8(z);
+  }
+  void CardByte(const Card& c) { U8((uint32_t)RankValue(c.rank) << 2 | static_cast<uint32_t>(c.suit)); }
+};
+
+struct Reader {
+  const uint8_t* p;
+  const uint8_t* end;
+  bool ok = true;
+
+  uint32_t U8() { if (p < end) return *p++; ok = false; return 0; }
+  uint32_t U16() { uint32_t lo = U8(); return lo | (U8() << 8); }
+  uint32_t U32() { uint32_t lo = U16(); return lo | (U16() << 16); }
+  int32_t Var() {
+    uint32_t z = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      uint32_t b = U8();
+      z |= (b & 0x7f) << shift;
+      if (!(b & 0x80)) break;
+    }
+    return (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+  }
+  Card CardByte() {
+    uint32_t b = U8();
+    int r = (int)(b >> 2);
+    if (r < 1 || r > 13) { ok = false; r = 1; }
+    return Card(static_cast<Rank>(r), static_cast<Suit>(b & 3));
+  }
+};
+
+uint32_t checksum32(const GameState& gs) {
+  uint64_t h = StateChecksum(gs);
+  return (uint32_t)(h ^ (h >> 32));
+}
+
+void putCards(Writer& w, const std::vector<Card>& v) {
+  w.U8((uint32_t)v.size());
+  for (const Card& c : v) w.CardByte(c);
+}
+
+bool getCards(Reader& r, std::vector<Card>& v) {
+  uint32_t n = r.U8();
+  if (n > 52) return false;
+  v.clear();
+  for (uint32_t i=0; i<n; ++i) v.push_back(r.CardByte());
+  return r.ok;
+}
+
+void putBuild(Writer& w, const Build& b) {
+  w.U8((uint32_t)b.value);
+  w.U8((uint32_t)(b.ownerPlayer + 1));
+  putCards(w, b.cards);
+}
+
+// what GameLogic can produce: a card's value, owned by a seat or by nobody (-1)
+bool validBuild(const Build& b, int numPlayers) {
+  return b.value >= 1 && b.value <= 13 && b.ownerPlayer >= -1 && b.ownerPlayer < numPlayers;
+}
+
+bool getBuild(Reader& r, Build& b, int numPlayers) {
+  b.value = (int)r.U8();
+  b.ownerPlayer = (int)r.U8() - 1;
+  return validBuild(b, numPlayers) && getCards(r, b.cards);
+}
+
+int* scoreField(PlayerState& p, int f) {
+  return f == 0 ? &p.capturedCardPoints : f == 1 ? &p.buildBonus : &p.sweepBonus;
+}
+int scoreField(const PlayerState& p, int f) {
+  return f == 0 ? p.capturedCardPoints : f == 1 ? p.buildBonus : p.sweepBonus;
+}
+
+// ---------- sequence diff
+//
+// Walk base and target together: equal elements are kept, anything else in base is
+// removed, and whatever is left of target once base runs out is appended. That's a
+// valid encoding for any pair of sequences, and the minimal one for the edits moves
+// actually make (take cards out, push cards on the end).
+
+struct Run { uint8_t start, len; };
+
+template<class T, class Same>
+int diffRuns(const std::vector<T>& base, const std::vector<T>& target, Same same, Run* runs, size_t& keptOut) {
+  int nruns = 0;
+  size_t j = 0;
+  for (size_t i=0; i<base.size(); ++i) {
+    if (j < target.size() && same(base[i], target[j])) { ++j; continue; }
+    if (nruns > 0 && runs[nruns-1].start + runs[nruns-1].len == i) runs[nruns-1].len++;
+    else {
+      if (nruns == kMaxRuns) return -1;
+      runs[nruns++] = Run{(uint8_t)i, 1};
+    }
+  }
+  keptOut = j;
+  return nruns;
+}
+
+// in-place removal of validated, ascending runs
+template<class T>
+bool removeRuns(std::vector<T>& v, const Run* runs, int nruns) {
+  size_t write = 0, read = 0;
+  for (int k=0; k<nruns; ++k) {
+    if (runs[k].start < read || runs[k].start + runs[k].len > v.size()) return false;
+    while (read < runs[k].start) { if (write != read) v[write] = std::move(v[read]); ++write; ++read; }
+    read += runs[k].len;
+  }
+  while (read < v.size()) { if (write != read) v[write] = std::move(v[read]); ++write; ++read; }
+  v.resize(write);
+  return true;
+}
+
+void putCardsDiff(Writer& w, const std::vector<Card>& base, const std::vector<Card>& target) {
+  Run runs[kMaxRuns];
+  size_t kept = 0;
+  int nruns = diffRuns(base, target, [](const Card& a, const Card& b){ return a == b; }, runs, kept);
+  const size_t editCost = nruns < 0 ? SIZE_MAX : 3 + 2 * (size_t)nruns + (target.size() - kept);
+  if (editCost > 2 + target.size()) {
+    w.U8(kReplace);
+    putCards(w, target);
+    return;
+  }
+  w.U8(kEdit);
+  w.U8((uint32_t)nruns);
+  for (int k=0; k<nruns; ++k) { w.U8(runs[k].start); w.U8(runs[k].len); }
+  w.U8((uint32_t)(target.size() - kept));
+  for (size_t j=kept; j<target.size(); ++j) w.CardByte(target[j]);
+}
+
+bool getRuns(Reader& r, Run* runs, int& nruns) {
+  nruns = (int)r.U8();
+  if (nruns > kMaxRuns) return false;
+  for (int k=0; k<nruns; ++k) { runs[k].start = (uint8_t)r.U8(); runs[k].len = (uint8_t)r.U8(); }
+  return r.ok;
+}
+
+bool applyCardsDiff(Reader& r, std::vector<Card>& v) {
+  const uint32_t tag = r.U8();
+  if (tag == kReplace) return getCards(r, v);
+  if (tag != kEdit) return false;
+  Run runs[kMaxRuns];
+  int nruns = 0;
+  if (!getRuns(r, runs, nruns) || !removeRuns(v, runs, nruns)) return false;
+  uint32_t add = r.U8();
+  if (v.size() + add > 52) return false;
+  for (uint32_t i=0; i<add; ++i) v.push_back(r.CardByte());
+  return r.ok;
+}
+
+// a base build survives into target if target still starts with its cards
+bool sameBuild(const Build& a, const Build& b) {
+  if (a.cards.empty() || b.cards.size() < a.cards.size()) return false;
+  for (size_t i=0; i<a.cards.size(); ++i) if (!(a.cards[i] == b.cards[i])) return false;
+  return true;
+}
+
+void putBuildsDiff(Writer& w, const std::vector<Build>& base, const std::vector<Build>& target) {
+  Run runs[kMaxRuns];
+  size_t kept = 0;
+  int nruns = diffRuns(base, target, sameBuild, runs, kept);
+  if (nruns < 0) {
+    w.U8(kReplace);
+    w.U8((uint32_t)target.size());
+    for (const Build& b : target) putBuild(w, b);
+    return;
+  }
+  w.U8(kEdit);
+  w.U8((uint32_t)nruns);
+  for (int k=0; k<nruns; ++k) { w.U8(runs[k].start); w.U8(runs[k].len); }
+
+  // surviving builds in order, to find the ones that changed
+  int mods = 0;
+  {
+    size_t j = 0;
+    for (size_t i=0; i<base.size() && j<kept; ++i) {
+      if (!sameBuild(base[i], target[j])) continue;
+      const Build& a = base[i];
+      const Build& b = target[j];
+      if (a.value != b.value || a.ownerPlayer != b.ownerPlayer || a.cards.size() != b.cards.size()) mods++;
+      ++j;
+    }
+  }
+  w.U8((uint32_t)mods);
+  {
+    size_t j = 0;
+    for (size_t i=0; i<base.size() && j<kept; ++i) {
+      if (!sameBuild(base[i], target[j])) continue;
+      const Build& a = base[i];
+      const Build& b = target[j];
+      if (a.value != b.value || a.ownerPlayer != b.ownerPlayer || a.cards.size() != b.cards.size()) {
+        w.U8((uint32_t)j);
+        w.U8((uint32_t)b.value);
+        w.U8((uint32_t)(b.ownerPlayer + 1));
+        w.U8((uint32_t)(b.cards.size() - a.cards.size()));
+        for (size_t c=a.cards.size(); c<b.cards.size(); ++c) w.CardByte(b.cards[c]);
+      }
+      ++j;
+    }
+  }
+
+  w.U8((uint32_t)(target.size() - kept));
+  for (size_t j=kept; j<target.size(); ++j) putBuild(w, target[j]);
+}
+
+bool applyBuildsDiff(Reader& r, std::vector<Build>& v, int numPlayers) {
+  const uint32_t tag = r.U8();
+  if (tag == kReplace) {
+    uint32_t n = r.U8();
+    if (n > 52) return false;
+    v.resize(n);
+    for (auto& b : v) if (!getBuild(r, b, numPlayers)) return false;
+    return r.ok;
+  }
+  if (tag != kEdit) return false;
+
+  Run runs[kMaxRuns];
+  int nruns = 0;
+  if (!getRuns(r, runs, nruns) || !removeRuns(v, runs, nruns)) return false;
+
+  uint32_t mods = r.U8();
+  for (uint32_t m=0; m<mods; ++m) {
+    uint32_t idx = r.U8();
+    if (!r.ok || idx >= v.size()) return false;
+    Build& b = v[idx];
+    b.value = (int)r.U8();
+    b.ownerPlayer = (int)r.U8() - 1;
+    if (!validBuild(b, numPlayers)) return false;
+    uint32_t add = r.U8();
+    if (b.cards.size() + add > 52) return false;
+    for (uint32_t c=0; c<add; ++c) b.cards.push_back(r.CardByte());
+  }
+
+  uint32_t add = r.U8();
+  if (v.size() + add > 52) return false;
+  for (uint32_t i=0; i<add && r.ok; ++i) {
+    v.emplace_back();
+    if (!getBuild(r, v.back(), numPlayers)) return false;
+  }
+  return r.ok;
+}
+
+void putHeader(Writer& w, StateBlobKind kind) {
+  w.U8(kMagic0); w.U8(kMagic1); w.U8(StateCodecVersion); w.U8(static_cast<uint8_t>(kind));
+}
+
+bool getHeader(Reader& r, StateBlobKind& kind) {
+  if (r.U8() != kMagic0 || r.U8() != kMagic1) return false;
+  if (r.U8() != StateCodecVersion) return false;
+  uint32_t k = r.U8();
+  if (k > 1) return false;
+  kind = static_cast<StateBlobKind>(k);
+  return r.ok;
+}
+
+bool decodeSnapshotBody(Reader& r, GameState& gs) {
+  int n = (int)r.U8();
+  if (n < 1 || n > 4) return false;
+  gs.numPlayers = n;
+  gs.current = (int)r.U8();
+  gs.lastCaptureBy = (int)r.U8() - 1;
+  if (gs.current >= n || gs.lastCaptureBy >= n) return false;
+  gs.players.resize(n);
+  for (auto& p : gs.players) {
+    p.capturedCardPoints = r.Var();
+    p.buildBonus = r.Var();
+    p.sweepBonus = r.Var();
+    if (!getCards(r, p.hand) || !getCards(r, p.pile)) return false;
+  }
+  if (!getCards(r, gs.table.loose)) return false;
+  uint32_t nb = r.U8();
+  if (nb > 52) return false;
+  gs.table.builds.resize(nb);
+  for (auto& b : gs.table.builds) if (!getBuild(r, b, n)) return false;
+  return getCards(r, gs.stock);
+}
+
+} // namespace
+
+// ---------- snapshot
+
+size_t EncodeSnapshot(const GameState& gs, uint8_t* out, size_t cap){
+  Writer w{out, out + cap};
+  putHeader(w, StateBlobKind::Snapshot);
+  w.U8((uint32_t)gs.numPlayers);
+  w.U8((uint32_t)gs.current);
+  w.U8((uint32_t)(gs.lastCaptureBy + 1));
+  for (const auto& p : gs.players) {
+    w.Var(p.capturedCardPoints);
+    w.Var(p.buildBonus);
+    w.Var(p.sweepBonus);
+    putCards(w, p.hand);
+    putCards(w, p.pile);
+  }
+  putCards(w, gs.table.loose);
+  w.U8((uint32_t)gs.table.builds.size());
+  for (const auto& b : gs.table.builds) putBuild(w, b);
+  putCards(w, gs.stock);
+  return w.ok ? (size_t)(w.p - out) : 0;
+}
+
+bool DecodeSnapshot(const uint8_t* data, size_t size, GameState& out){
+  Reader r{data, data + size};
+  StateBlobKind kind;
+  if (!getHeader(r, kind) || kind != StateBlobKind::Snapshot) return false;
+  return decodeSnapshotBody(r, out) && r.ok;
+}
+
+// ---------- delta
+
+size_t EncodeDelta(const GameState& base, const GameState& target, uint8_t* out, size_t cap){
+  // a different table size is a new game, not a change
+  if (base.numPlayers != target.numPlayers || base.players.size() != target.players.size())
+    return EncodeSnapshot(target, out, cap);
+
+  const int n = target.numPlayers;
+  Writer w{out, out + cap};
+  putHeader(w, StateBlobKind::Delta);
+  w.U32(checksum32(base));
+  w.U32(checksum32(target));
+  w.U8((uint32_t)target.current);
+  w.U8((uint32_t)(target.lastCaptureBy + 1));
+
+  uint32_t scoreMask = 0;
+  for (int p=0; p<n; ++p)
+    for (int f=0; f<3; ++f)
+      if (scoreField(base.players[p], f) != scoreField(target.players[p], f)) scoreMask |= 1u << (p*3 + f);
+  w.U16(scoreMask);
+  for (int p=0; p<n; ++p)
+    for (int f=0; f<3; ++f)
+      if (scoreMask & (1u << (p*3 + f))) w.Var(scoreField(target.players[p], f) - scoreField(base.players[p], f));
+
+  // containers: hands, piles, loose, stock, then builds
+  auto cards = [&](const GameState& gs, int i) -> const std::vector<Card>& {
+    if (i < n) return gs.players[i].hand;
+    if (i < 2*n) return gs.players[i - n].pile;
+    return i == 2*n ? gs.table.loose : gs.stock;
+  };
+  auto sameBuilds = [](const std::vector<Build>& a, const std::vector<Build>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i=0; i<a.size(); ++i)
+      if (a[i].value != b[i].value || a[i].ownerPlayer != b[i].ownerPlayer || a[i].cards != b[i].cards) return false;
+    return true;
+  };
+
+  uint32_t changed = 0;
+  for (int i=0; i<2*n+2; ++i) if (cards(base, i) != cards(target, i)) changed |= 1u << i;
+  if (!sameBuilds(base.table.builds, target.table.builds)) changed |= 1u << (2*n + 2);
+  w.U16(changed);
+  for (int i=0; i<2*n+2; ++i) if (changed & (1u << i)) putCardsDiff(w, cards(base, i), cards(target, i));
+  if (changed & (1u << (2*n + 2))) putBuildsDiff(w, base.table.builds, target.table.builds);
+
+  return w.ok ? (size_t)(w.p - out) : 0;
+}
+
+bool ApplyDelta(const uint8_t* data, size_t size, GameState& gs){
+  Reader r{data, data + size};
+  StateBlobKind kind;
+  if (!getHeader(r, kind) || kind != StateBlobKind::Delta) return false;
+  const uint32_t baseHash = r.U32();
+  const uint32_t resultHash = r.U32();
+  if (!r.ok || baseHash != checksum32(gs)) return false; // wrong base: untouched
+
+  const int n = gs.numPlayers;
+  gs.current = (int)r.U8();
+  gs.lastCaptureBy = (int)r.U8() - 1;
+  if (gs.current >= n || gs.lastCaptureBy >= n) return false;
+
+  const uint32_t scoreMask = r.U16();
+  for (int p=0; p<n; ++p)
+    for (int f=0; f<3; ++f)
+      if (scoreMask & (1u << (p*3 + f))) *scoreField(gs.players[p], f) += r.Var();
+
+  const uint32_t changed = r.U16();
+  for (int i=0; i<2*n+2; ++i) {
+    if (!(changed & (1u << i))) continue;
+    std::vector<Card>& v = i < n ? gs.players[i].hand
+                         : i < 2*n ? gs.players[i - n].pile
+                         : i == 2*n ? gs.table.loose : gs.stock;
+    if (!applyCardsDiff(r, v)) return false;
+  }
+  if ((changed & (1u << (2*n + 2))) && !applyBuildsDiff(r, gs.table.builds, n)) return false;
+
+  return r.ok && checksum32(gs) == resultHash;
+}
+
+bool DecodeState(const uint8_t* data, size_t size, GameState& state){
+  if (size < 4) return false;
+  if (data[3] == static_cast<uint8_t>(StateBlobKind::Delta)) return ApplyDelta(data, size, state);
+  return DecodeSnapshot(data, size, state);
+}
+
+void ReserveState(GameState& gs, int numPlayers){
+  if ((int)gs.players.size() < numPlayers) gs.players.reserve(numPlayers);
+  for (auto& p : gs.players) { p.hand.reserve(52); p.pile.reserve(52); }
+  gs.table.loose.reserve(52);
+  gs.table.builds.reserve(26);
+  for (auto& b : gs.table.builds) b.cards.reserve(52);
+  gs.stock.reserve(52);
+}
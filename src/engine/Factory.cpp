@@ -16,8 +16,16 @@
 #include "gfx/glad/GLShader.h"
 #include "gfx/glad/GLVertexArray.h"
 #include "gfx/glad/GLTexture2D.h"
+#include "gfx/glad/GLTextureArray.h"
+#include "gfx/glad/GLRenderTarget.h"
 #include "gfx/glad/GLRendererAPI.h"
 
+#include "window/null/NullWindow.h"
+#ifdef KASINO_HAS_EGL
+  #include "window/egl/EglWindow.h"
+#endif
+#include "gfx/null/NullGraphics.h"
+
 #include "audio/null/NullAudioDevice.h"
 #include "audio/miniaudio/MiniaudioDevice.h"
 
@@ -34,6 +42,14 @@ Scope<IWindow> Factory::CreateWindow() {
   switch(s_Desc.window_api){
   case WindowAPI::GLFW:
     return CreateScope<GlfwWindow>(s_Desc);
+  case WindowAPI::None:
+    return CreateScope<NullWindow>(s_Desc);
+#ifdef KASINO_HAS_EGL
+  case WindowAPI::Offscreen:
+    return CreateScope<EglWindow>(s_Desc);
+#endif
+  default:
+    break;
   }
 
   // static_assert(false, "No window backend selected");
@@ -44,6 +60,10 @@ Scope<IGraphicsDevice> Factory::CreateGraphicsDevice() {
   switch(s_Desc.graphics_api){
   case GraphicsAPI::OpenGL:
     return CreateScope<GLDevice>(s_Desc);
+  case GraphicsAPI::None:
+    return CreateScope<NullDevice>(s_Desc);
+  default:
+    break;
   }
 
   return nullptr;
@@ -62,6 +82,10 @@ Ref<IShader> Factory::CreateShader(const std::string& filepath){
   switch(s_Desc.graphics_api){
   case GraphicsAPI::OpenGL:
     return CreateRef<GLShader>(filepath);
+  case GraphicsAPI::None:
+    return CreateRef<NullShader>(filepath);
+  default:
+    break;
   }
 
   return nullptr;
@@ -70,6 +94,10 @@ Ref<IBuffer> Factory::CreateBuffer(BufferType type){
   switch(s_Desc.graphics_api){
   case GraphicsAPI::OpenGL:
     return CreateRef<GLBuffer>(type);
+  case GraphicsAPI::None:
+    return CreateRef<NullBuffer>(type);
+  default:
+    break;
   }
 
   return nullptr;
@@ -78,14 +106,24 @@ Ref<IVertexArray> Factory::CreateVertexArray(){
   switch(s_Desc.graphics_api){
   case GraphicsAPI::OpenGL:
     return CreateRef<GLVertexArray>();
+  case GraphicsAPI::None:
+    return CreateRef<NullVertexArray>();
+  default:
+    break;
   }
 
   return nullptr;
 }
 
 std::shared_ptr<ITexture2D>   Factory::CreateTexture2D()   { 
-  switch(s_Desc.graphics_api){ case GraphicsAPI::OpenGL: return std::make_shared<GLTexture2D>(); default: return nullptr; } 
+  switch(s_Desc.graphics_api){ case GraphicsAPI::OpenGL: return std::make_shared<GLTexture2D>(); case GraphicsAPI::None: return std::make_shared<NullTexture2D>(); default: return nullptr; } 
+}
+std::shared_ptr<ITextureArray> Factory::CreateTextureArray() {
+  switch(s_Desc.graphics_api){ case GraphicsAPI::OpenGL: return std::make_shared<GLTextureArray>(); case GraphicsAPI::None: return std::make_shared<NullTextureArray>(); default: return nullptr; }
+}
+Ref<IRenderTarget> Factory::CreateRenderTarget() {
+  switch(s_Desc.graphics_api){ case GraphicsAPI::OpenGL: return CreateRef<GLRenderTarget>(); case GraphicsAPI::None: return CreateRef<NullRenderTarget>(); default: return nullptr; }
 }
 std::unique_ptr<RendererAPI>  Factory::CreateRendererAPI() { 
-  switch(s_Desc.graphics_api){ case GraphicsAPI::OpenGL: return std::make_unique<GLRendererAPI>(); default: return nullptr; } 
+  switch(s_Desc.graphics_api){ case GraphicsAPI::OpenGL: return std::make_unique<GLRendererAPI>(); case GraphicsAPI::None: return std::make_unique<NullRendererAPI>(); default: return nullptr; } 
 }
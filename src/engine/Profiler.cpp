@@ -0,0 +1,162 @@
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+std::atomic<bool> Profiler::s_Enabled{true};
+
+namespace {
+
+constexpr size_t kRingSize = 1u << 14;   // zones kept per thread
+
+struct ThreadRing {
+  uint32_t ThreadId = 0;
+  uint16_t Depth = 0;                    // owner thread only
+  std::atomic<uint64_t> Head{0};         // zones ever written; slot = Head % kRingSize
+  std::array<Profiler::Zone, kRingSize> Zones{};
+};
+
+std::mutex g_RingsMutex;
+std::vector<std::unique_ptr<ThreadRing>> g_Rings;   // kept after a thread exits
+uint32_t g_NextThreadId = 1;
+
+ThreadRing& localRing() {
+  thread_local ThreadRing* ring = nullptr;
+  if (!ring) {
+    auto owned = std::make_unique<ThreadRing>();
+    ring = owned.get();
+    std::lock_guard<std::mutex> lock(g_RingsMutex);
+    ring->ThreadId = g_NextThreadId++;
+    g_Rings.push_back(std::move(owned));
+  }
+  return *ring;
+}
+
+void copyRing(const ThreadRing& ring, std::vector<Profiler::Zone>& out) {
+  const uint64_t head = ring.Head.load(std::memory_order_acquire);
+  const uint64_t count = std::min<uint64_t>(head, kRingSize);
+  for (uint64_t i = head - count; i < head; ++i) out.push_back(ring.Zones[i % kRingSize]);
+}
+
+std::mutex g_FrameMutex;
+Profiler::FrameSummary g_Frames;
+const ThreadRing* g_FrameRing = nullptr;
+uint64_t g_FrameBeginNs = 0;
+uint64_t g_LastFrameBeginNs = 0;
+uint64_t g_LastFrameEndNs = 0;
+
+void writeEscaped(std::FILE* f, const char* s) {
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\') std::fputc('\\', f);
+    std::fputc(*s, f);
+  }
+}
+
+}  // namespace
+
+void Profiler::SetEnabled(bool enable) { s_Enabled.store(enable, std::memory_order_relaxed); }
+
+uint64_t Profiler::NowNs() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::Record(const char* name, uint64_t startNs, uint64_t endNs, uint16_t depth) {
+  ThreadRing& ring = localRing();
+  const uint64_t head = ring.Head.load(std::memory_order_relaxed);
+  ring.Zones[head % kRingSize] = Zone{ name, startNs, endNs, ring.ThreadId, depth };
+  ring.Head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::BeginFrame() {
+  const ThreadRing* ring = &localRing();
+  std::lock_guard<std::mutex> lock(g_FrameMutex);
+  g_FrameRing = ring;
+  g_FrameBeginNs = NowNs();
+}
+
+void Profiler::EndFrame() {
+  const uint64_t now = NowNs();
+  std::lock_guard<std::mutex> lock(g_FrameMutex);
+  if (g_FrameBeginNs == 0) return;
+  g_LastFrameBeginNs = g_FrameBeginNs;
+  g_LastFrameEndNs = now;
+  g_FrameBeginNs = 0;
+
+  g_Frames.FrameMs[g_Frames.Head] = (float)(now - g_LastFrameBeginNs) * 1e-6f;
+  g_Frames.Head = (g_Frames.Head + 1) % FrameHistory;
+  g_Frames.Count = std::min(g_Frames.Count + 1, FrameHistory);
+  ++g_Frames.Frames;
+}
+
+Profiler::FrameSummary Profiler::GetFrameSummary() {
+  std::lock_guard<std::mutex> lock(g_FrameMutex);
+  return g_Frames;
+}
+
+std::vector<Profiler::Zone> Profiler::LastFrameZones() {
+  const ThreadRing* ring;
+  uint64_t begin, end;
+  {
+    std::lock_guard<std::mutex> lock(g_FrameMutex);
+    ring = g_FrameRing;
+    begin = g_LastFrameBeginNs;
+    end = g_LastFrameEndNs;
+  }
+  std::vector<Zone> zones;
+  if (!ring || end == 0) return zones;
+
+  copyRing(*ring, zones);
+  zones.erase(std::remove_if(zones.begin(), zones.end(),
+                             [&](const Zone& z) { return z.StartNs < begin || z.StartNs >= end; }),
+              zones.end());
+  std::sort(zones.begin(), zones.end(),
+            [](const Zone& a, const Zone& b) { return a.StartNs < b.StartNs; });
+  return zones;
+}
+
+std::vector<Profiler::Zone> Profiler::Snapshot() {
+  std::vector<Zone> zones;
+  std::lock_guard<std::mutex> lock(g_RingsMutex);
+  for (const auto& ring : g_Rings) copyRing(*ring, zones);
+  return zones;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) {
+  const std::vector<Zone> zones = Snapshot();
+  std::FILE* f = std::fopen(path.c_str(), "w");
+  if (!f) return false;
+
+  std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+  bool first = true;
+  for (const Zone& z : zones) {
+    if (!z.Name) continue;
+    std::fputs(first ? "" : ",\n", f);
+    first = false;
+    std::fputs("{\"name\":\"", f);
+    writeEscaped(f, z.Name);
+    // complete events; timestamps in microseconds
+    std::fprintf(f, "\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                 (double)z.StartNs * 1e-3, (double)(z.EndNs - z.StartNs) * 1e-3, z.ThreadId);
+  }
+  std::fputs("\n]}\n", f);
+  return std::fclose(f) == 0;
+}
+
+ProfileScope::ProfileScope(const char* name)
+  : m_Name(name), m_Start(0), m_Active(Profiler::IsEnabled()) {
+  if (!m_Active) return;
+  ++localRing().Depth;
+  m_Start = Profiler::NowNs();
+}
+
+ProfileScope::~ProfileScope() {
+  if (!m_Active) return;
+  const uint64_t end = Profiler::NowNs();
+  ThreadRing& ring = localRing();
+  Profiler::Record(m_Name, m_Start, end, --ring.Depth);
+}
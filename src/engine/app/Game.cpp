@@ -3,6 +3,13 @@
 #include "gfx/ViewportUtil.h"
 #include "core/Log.h"
 #include "audio/SoundSystem.h"
+#include "ui/UISystem.h"
+#include "core/Profiler.h"
+#include "gfx/ImageIO.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -72,6 +79,10 @@ void Game::Run() {
 #ifdef __EMSCRIPTEN__
   emscripten_set_main_loop_arg(&Game::EmscriptenMainLoop, this, 0, true);
 #else
+  if (m_ThreadedRendering) {
+    m_RenderThread = CreateScope<RenderThread>(*m_Window);
+    if (!m_RenderThread->Start()) m_RenderThread.reset();
+  }
   while (m_Running && !m_Window->ShouldClose()) {
     runFrame();
   }
@@ -97,12 +108,42 @@ void Game::runFrame() {
   }
 
   using clock = std::chrono::high_resolution_clock;
+  const bool onDemand = m_RedrawMode == RedrawMode::OnDemand;
+  if (onDemand && !redrawDue(clock::now())) {
+    // nothing scheduled: sleep in the event wait until input or the next timer
+    double timeout = kMaxIdleWait;
+    if (m_RedrawDeadline != clock::time_point::max()) {
+      double untilDeadline =
+          std::chrono::duration<double>(m_RedrawDeadline - clock::now()).count();
+      timeout = std::clamp(untilDeadline, 0.0, kMaxIdleWait);
+    }
+    EN_PROFILE_ZONE("Game::waitEvents");
+    m_Window->WaitEvents(timeout);
+  } else {
+    m_Window->PollEvents();
+  }
+  SoundSystem::Update();
+
   auto now = clock::now();
-  float dt = std::chrono::duration<float>(now - m_LastFrameTime).count();
-  m_LastFrameTime = now;
+  const uint64_t generation = m_Window->Events().Generation();
+  const bool eventsArrived = generation != m_EventGeneration;
+  m_EventGeneration = generation;
 
-  m_Window->PollEvents();
-  SoundSystem::Update();
+  if (onDemand && !eventsArrived && !redrawDue(now) && m_Running &&
+      !m_Window->ShouldClose()) {
+    ++m_FrameStats.SkippedFrames;
+    m_WasIdle = true;
+    m_LastFrameTime = now;
+    return;
+  }
+
+  // coming back from idle the wait isn't simulation time; one step handles the input
+  const float step = m_Timing.FixedStep;
+  float dt = m_WasIdle ? step : std::chrono::duration<float>(now - m_LastFrameTime).count();
+  m_LastFrameTime = now;
+  m_WasIdle = false;
+  m_RedrawRequested = false;
+  if (m_RedrawDeadline <= now) m_RedrawDeadline = clock::time_point::max();
 
   if (!m_Running || m_Window->ShouldClose()) {
     m_Running = false;
@@ -113,23 +154,138 @@ void Game::runFrame() {
     return;
   }
 
-  RenderCommand::SetClearColor(0.5f, 0.3f, 0.1f, 1.0f);
-  RenderCommand::Clear();
+  EN_PROFILE_FRAME_BEGIN();
+  {
+    EN_PROFILE_ZONE("Game::runFrame");
+    // threaded: everything below that reaches GL is recorded and runs next frame
+    if (m_RenderThread) RenderCommand::SetRecording(&m_RenderThread->Recording());
+    RenderCommand::SetClearColor(0.5f, 0.3f, 0.1f, 1.0f);
+    RenderCommand::Clear();
 
-  OnUpdate(dt);
+    uint32_t steps = 0;
+    if (m_Timing.Deterministic) {
+      OnUpdate(step);
+      steps = 1;
+      m_Accumulator = 0.0f;
+    } else {
+      m_Accumulator += dt;
+      while (m_Accumulator >= step && steps < (uint32_t)m_Timing.MaxCatchUpSteps) {
+        OnUpdate(step);
+        m_Accumulator -= step;
+        ++steps;
+      }
+      if (m_Accumulator >= step) {
+        // too far behind (loading, tab switch, debugger): drop it instead of spiralling
+        m_FrameStats.DroppedSteps += (uint32_t)(m_Accumulator / step);
+        m_Accumulator = std::fmod(m_Accumulator, step);
+      }
+      if (onDemand && eventsArrived && steps == 0) {
+        // input woke us less than a step after the last frame and nothing else will
+        // wake us to handle it: step now, running at most one step ahead of the clock
+        OnUpdate(step);
+        m_Accumulator = 0.0f;
+        steps = 1;
+      }
+    }
+    m_FrameStats.Steps += steps;
+    const float alpha = m_Accumulator / step;
 
-  m_Device->BeginFrame(m_fbWidth, m_fbHeight);
+    IGraphicsDevice* device = m_Device.get();
+    RenderCommand::Enqueue([device, w = m_fbWidth, h = m_fbHeight] { device->BeginFrame(w, h); });
 
-  m_Camera.Update();
-  Render2D::BeginScene(m_Camera);
-  OnRender();
-  Render2D::EndScene();
+    m_Camera.Update();
+    Render2D::BeginScene(m_Camera);
+    OnRender(alpha);
+    Render2D::EndScene();
+    ui::TrimTextLayoutCache();
+
+    RenderCommand::Enqueue([device] { device->EndFrame(); });
+
+    if (m_RenderThread) {
+      RenderCommand::SetRecording(nullptr);
+      m_RenderThread->Submit();
+    }
+  }
+  EN_PROFILE_FRAME_END();
+
+  ++m_FrameStats.Frames;
+  paceFrame(now);
+}
+
+RenderThread::Stats Game::GetRenderThreadStats() const {
+  return m_RenderThread ? m_RenderThread->GetStats() : m_RenderThreadStats;
+}
+
+void Game::stopRenderThread() {
+  if (!m_RenderThread) return;
+  // the last frame executes, then the context comes back for OnStop and Shutdown
+  m_RenderThread->Stop();
+  m_RenderThreadStats = m_RenderThread->GetStats();
+  m_RenderThread.reset();
+}
+
+bool Game::ReadFrame(Image& out) const {
+  return m_Device && m_Device->ReadPixels(out.Pixels, out.Width, out.Height);
+}
+
+void Game::SetRedrawMode(RedrawMode mode) {
+  m_RedrawMode = mode;
+  m_RedrawRequested = true;
+}
+
+void Game::RequestRedraw() {
+  m_RedrawRequested = true;
+  if (m_Window) m_Window->PostEmptyEvent();
+}
+
+void Game::RequestRedrawIn(float seconds) {
+  using clock = std::chrono::high_resolution_clock;
+  auto when = clock::now() + std::chrono::duration_cast<clock::duration>(
+                                 std::chrono::duration<float>(std::max(seconds, 0.0f)));
+  m_RedrawDeadline = std::min(m_RedrawDeadline, when);
+}
 
-  m_Device->EndFrame();
+bool Game::redrawDue(std::chrono::high_resolution_clock::time_point now) const {
+  return m_RedrawRequested || WantsRedraw() || m_RedrawDeadline <= now;
+}
+
+void Game::SetFrameTiming(const FrameTiming& timing) {
+  m_Timing = timing;
+  m_Timing.FixedStep = std::max(m_Timing.FixedStep, 1.0f / 1000.0f);
+  m_Timing.MaxCatchUpSteps = std::max(m_Timing.MaxCatchUpSteps, 1);
+  m_Timing.SpinSeconds = std::max(m_Timing.SpinSeconds, 0.0f);
+  m_Accumulator = 0.0f;
+}
+
+void Game::paceFrame(std::chrono::high_resolution_clock::time_point frameStart) {
+  using clock = std::chrono::high_resolution_clock;
+  const auto frameEnd = clock::now();
+  m_FrameStats.LastFrameMs =
+      std::chrono::duration<float, std::milli>(frameEnd - frameStart).count();
+  if (m_Timing.TargetFps <= 0.0f) return;
+
+  const auto target = frameStart + std::chrono::duration_cast<clock::duration>(
+                                       std::chrono::duration<float>(1.0f / m_Timing.TargetFps));
+  if (frameEnd > target) {
+    const float overMs = std::chrono::duration<float, std::milli>(frameEnd - target).count();
+    ++m_FrameStats.LateFrames;
+    m_FrameStats.WorstOverrunMs = std::max(m_FrameStats.WorstOverrunMs, overMs);
+    EN_CORE_TRACE("late frame: {:.2f} ms over the {:.1f} fps budget", overMs, m_Timing.TargetFps);
+    return;
+  }
+
+#ifndef __EMSCRIPTEN__
+  // sleep is coarse (often 1 ms+), so spin through the last SpinSeconds
+  const auto spinFrom = target - std::chrono::duration_cast<clock::duration>(
+                                     std::chrono::duration<float>(m_Timing.SpinSeconds));
+  if (clock::now() < spinFrom) std::this_thread::sleep_until(spinFrom);
+  while (clock::now() < target) std::this_thread::yield();
+#endif
 }
 
 void Game::handleStop() {
   if (m_OnStopCalled) return;
   m_OnStopCalled = true;
+  stopRenderThread();
   OnStop();
 }
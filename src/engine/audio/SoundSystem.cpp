@@ -1,5 +1,6 @@
 #include "audio/SoundSystem.h"
 #include "core/Log.h"
+#include "core/Profiler.h"
 #include <algorithm>
 
 namespace {
@@ -43,6 +44,7 @@ void SoundSystem::Shutdown() {
 }
 
 void SoundSystem::Update() {
+    EN_PROFILE_FUNCTION();
     if (!g_device) return;
     g_device->Update();
     // prune finished one-shots
@@ -0,0 +1,158 @@
+#include "gfx/CompositeCache.h"
+#include "core/Factory.h"
+#include "core/Log.h"
+#include "core/Profiler.h"
+#include "gfx/Camera2D.h"
+#include "gfx/Render2D.h"
+#include "gfx/RenderCommand.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+static constexpr uint32_t kGap = 1; // transparent texels between entries, against bleeding
+
+bool CompositeCache::Init(uint32_t pageSize, uint32_t pageCount) {
+  Shutdown();
+  m_PageSize = pageSize;
+  for (uint32_t i = 0; i < pageCount; ++i) {
+    Ref<IRenderTarget> target = Factory::CreateRenderTarget();
+    if (!target || !target->Create(pageSize, pageSize)) {
+      EN_CORE_ERROR("CompositeCache: could not create a {}x{} page", pageSize, pageSize);
+      break;
+    }
+    m_Pages.push_back(Page{ std::move(target) });
+  }
+  return !m_Pages.empty();
+}
+
+void CompositeCache::Shutdown() {
+  m_Pages.clear();
+  m_Entries.clear();
+  m_Pending.clear();
+}
+
+void CompositeCache::SetPixelScale(float scale) {
+  if (scale <= 0.0f || scale == m_Scale) return;
+  m_Scale = scale;
+  Clear();
+}
+
+const Sprite* CompositeCache::Get(uint64_t key, const glm::vec2& size, DrawFn draw) {
+  if (m_Pages.empty()) return nullptr;
+  const Key k{ key, (uint32_t)std::ceil(size.x * m_Scale), (uint32_t)std::ceil(size.y * m_Scale) };
+  auto [it, inserted] = m_Entries.try_emplace(k);
+  if (it->second.baked) return &it->second.sprite;
+  if (inserted) m_Pending.push_back(Pending{ k, size, std::move(draw) });
+  return nullptr;
+}
+
+bool CompositeCache::place(uint32_t w, uint32_t h, int& pageIdx, uint32_t& x, uint32_t& y) {
+  if (w > m_PageSize || h > m_PageSize) return false;
+
+  // same shelves as TextureAtlas, except that every page stays open
+  for (size_t i = 0; i < m_Pages.size(); ++i) {
+    Page& p = m_Pages[i];
+    if (p.shelfX + w > m_PageSize) {
+      p.shelfY += p.shelfH;
+      p.shelfX = 0;
+      p.shelfH = 0;
+    }
+    if (p.shelfY + h > m_PageSize) continue;
+    pageIdx = (int)i;
+    x = p.shelfX; y = p.shelfY;
+    p.shelfX += w;
+    p.shelfH = std::max(p.shelfH, h);
+    return true;
+  }
+  return false;
+}
+
+void CompositeCache::evict() {
+  for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+    if (it->second.baked) it = m_Entries.erase(it);
+    else ++it;
+  }
+  bool used = false;
+  for (Page& p : m_Pages) {
+    if (p.shelfX || p.shelfY) p.dirty = used = true;
+    p.shelfX = p.shelfY = p.shelfH = 0;
+  }
+  if (used) ++m_Stats.Evictions;
+}
+
+void CompositeCache::Clear() {
+  evict();
+  // queued draws and too-big markers were sized for the old scale
+  m_Entries.clear();
+  m_Pending.clear();
+}
+
+bool CompositeCache::BakePending(const Camera2D& camera) {
+  if (m_Pending.empty()) return false;
+  EN_PROFILE_ZONE("CompositeCache::BakePending");
+
+  // place everything first; if the pages are full, start over on empty ones
+  bool evicted = false;
+  for (size_t i = 0; i < m_Pending.size(); ++i) {
+    Pending& p = m_Pending[i];
+    if (place(p.key.w + kGap, p.key.h + kGap, p.page, p.x, p.y)) continue;
+    if (!evicted && p.key.w + kGap <= m_PageSize && p.key.h + kGap <= m_PageSize) {
+      evict();
+      evicted = true;
+      for (Pending& q : m_Pending) q.page = -1;
+      i = (size_t)-1;
+      continue;
+    }
+    p.page = -1;
+  }
+
+  // what didn't fit goes back to unqueued so the next Get asks again; only entries
+  // larger than a page keep their record, which holds them on the fallback for good
+  for (const Pending& p : m_Pending) {
+    if (p.page >= 0) continue;
+    if (p.key.w + kGap <= m_PageSize && p.key.h + kGap <= m_PageSize) m_Entries.erase(p.key);
+  }
+
+  Render2D::EndScene();
+  const float invScale = 1.0f / m_Scale;
+  for (size_t pageIdx = 0; pageIdx < m_Pages.size(); ++pageIdx) {
+    Page& page = m_Pages[pageIdx];
+    auto first = std::find_if(m_Pending.begin(), m_Pending.end(),
+                              [&](const Pending& p) { return p.page == (int)pageIdx; });
+    if (first == m_Pending.end()) continue;
+
+    Ref<IRenderTarget> target = page.target;
+    RenderCommand::Enqueue([target, clear = page.dirty] { target->Begin(clear); });
+    page.dirty = false;
+
+    // y = 0 at the bottom row, which is where textures start: sprites come out upright
+    const float size = (float)m_PageSize * invScale;
+    Render2D::BeginScene(glm::ortho(0.0f, size, 0.0f, size, -1.0f, 1.0f));
+    for (auto it = first; it != m_Pending.end(); ++it) {
+      if (it->page != (int)pageIdx) continue;
+      it->draw(glm::vec2{ (float)it->x, (float)it->y } * invScale);
+
+      Entry& entry = m_Entries[it->key];
+      const float inv = 1.0f / (float)m_PageSize;
+      entry.sprite.Texture = target->Texture();
+      entry.sprite.UV = { it->x * inv, it->y * inv, (it->x + it->key.w) * inv, (it->y + it->key.h) * inv };
+      entry.sprite.Size = { (float)it->key.w, (float)it->key.h };
+      entry.baked = true;
+      ++m_Stats.Bakes;
+    }
+    Render2D::EndScene();
+    RenderCommand::Enqueue([target] { target->End(); });
+  }
+  m_Pending.clear();
+
+  Render2D::BeginScene(camera);
+  return true;
+}
+
+CompositeCache::Stats CompositeCache::GetStats() const {
+  Stats s = m_Stats;
+  s.Entries = (uint32_t)std::count_if(m_Entries.begin(), m_Entries.end(),
+                                      [](const auto& e) { return e.second.baked; });
+  return s;
+}
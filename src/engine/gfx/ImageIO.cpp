@@ -0,0 +1,122 @@
+#include "gfx/ImageIO.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size) {
+  static const std::array<uint32_t, 256> table = [] {
+    std::array<uint32_t, 256> t{};
+    for (uint32_t n = 0; n < 256; ++n) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      t[n] = c;
+    }
+    return t;
+  }();
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+void putBE32(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back((uint8_t)(v >> 24));
+  out.push_back((uint8_t)(v >> 16));
+  out.push_back((uint8_t)(v >> 8));
+  out.push_back((uint8_t)v);
+}
+
+void putChunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& data) {
+  putBE32(out, (uint32_t)data.size());
+  const size_t start = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data.begin(), data.end());
+  putBE32(out, crc32(0, out.data() + start, out.size() - start));
+}
+
+}  // namespace
+
+bool WritePNG(const std::string& path, const Image& image) {
+  if (image.Width <= 0 || image.Height <= 0 ||
+      image.Pixels.size() < (size_t)image.Width * image.Height * 4)
+    return false;
+
+  std::vector<uint8_t> ihdr;
+  putBE32(ihdr, (uint32_t)image.Width);
+  putBE32(ihdr, (uint32_t)image.Height);
+  ihdr.insert(ihdr.end(), {8, 6, 0, 0, 0});   // 8 bit, RGBA, deflate, no filter, no interlace
+
+  // scanlines, each behind a "no filter" byte
+  const size_t stride = (size_t)image.Width * 4;
+  std::vector<uint8_t> raw;
+  raw.reserve((stride + 1) * image.Height);
+  for (int y = 0; y < image.Height; ++y) {
+    raw.push_back(0);
+    const uint8_t* row = image.Pixels.data() + (size_t)y * stride;
+    raw.insert(raw.end(), row, row + stride);
+  }
+
+  // zlib stream of stored deflate blocks (at most 65535 bytes each)
+  std::vector<uint8_t> idat = {0x78, 0x01};
+  uint32_t a = 1, b = 0;
+  for (size_t off = 0; off < raw.size();) {
+    const size_t n = std::min<size_t>(raw.size() - off, 65535);
+    const bool last = off + n == raw.size();
+    idat.push_back(last ? 1 : 0);
+    idat.push_back((uint8_t)n);
+    idat.push_back((uint8_t)(n >> 8));
+    idat.push_back((uint8_t)~n);
+    idat.push_back((uint8_t)(~n >> 8));
+    idat.insert(idat.end(), raw.begin() + off, raw.begin() + off + n);
+    for (size_t i = off; i < off + n; ++i) {
+      a = (a + raw[i]) % 65521;
+      b = (b + a) % 65521;
+    }
+    off += n;
+  }
+  putBE32(idat, (b << 16) | a);
+
+  std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  putChunk(png, "IHDR", ihdr);
+  putChunk(png, "IDAT", idat);
+  putChunk(png, "IEND", {});
+
+  std::FILE* f = std::fopen(path.c_str(), "wb");
+  if (!f) return false;
+  const bool ok = std::fwrite(png.data(), 1, png.size(), f) == png.size();
+  return std::fclose(f) == 0 && ok;
+}
+
+bool ReadImage(const std::string& path, Image& out) {
+  stbi_set_flip_vertically_on_load(0);
+  int w = 0, h = 0, n = 0;
+  unsigned char* data = stbi_load(path.c_str(), &w, &h, &n, 4);
+  if (!data) return false;
+  out.Width = w;
+  out.Height = h;
+  out.Pixels.assign(data, data + (size_t)w * h * 4);
+  stbi_image_free(data);
+  return true;
+}
+
+ImageDiff CompareImages(const Image& a, const Image& b, int tolerance) {
+  ImageDiff diff;
+  if (a.Width != b.Width || a.Height != b.Height) {
+    diff.SizeMismatch = true;
+    return diff;
+  }
+  const size_t pixels = (size_t)a.Width * a.Height;
+  for (size_t i = 0; i < pixels; ++i) {
+    int worst = 0;
+    for (int c = 0; c < 4; ++c)
+      worst = std::max(worst, std::abs((int)a.Pixels[i * 4 + c] - (int)b.Pixels[i * 4 + c]));
+    diff.MaxDelta = std::max(diff.MaxDelta, worst);
+    if (worst > tolerance) ++diff.Differing;
+  }
+  return diff;
+}
@@ -2,21 +2,54 @@
 #include "core/Factory.h"
 #include "gfx/RenderCommand.h"
 #include "gfx/Camera2D.h"
+#include "core/Log.h"
+#include "core/Profiler.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <cstdio>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KASINO_RENDER2D_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define KASINO_RENDER2D_NEON 1
+#include <arm_neon.h>
+#endif
+
 // ==================== Static storage ====================
 
 Ref<IVertexArray> Render2D::s_VAO;
 Ref<IBuffer>      Render2D::s_VBO;
 Ref<IBuffer>      Render2D::s_IBO;
 Ref<IShader>      Render2D::s_Shader;
+int               Render2D::s_ShaderViewProj = -1;
+Ref<IVertexArray> Render2D::s_InstanceVAO;
+Ref<IBuffer>      Render2D::s_InstanceVBO;
+Ref<IBuffer>      Render2D::s_UnitQuadVBO;
+Ref<IShader>      Render2D::s_InstanceShader;
+int               Render2D::s_InstanceViewProj = -1;
+bool              Render2D::s_UseInstancing = false;
 Ref<ITexture2D>   Render2D::s_WhiteTexture;
+glm::vec4         Render2D::s_WhiteUV(0.0f, 0.0f, 1.0f, 1.0f);
+glm::vec4         Render2D::s_GlyphUV[128] = {};
+bool              Render2D::s_GlyphEmpty[128] = {};
+std::vector<uint32_t> Render2D::s_FontPixels;
+uint32_t          Render2D::s_FontWidth = 0;
+uint32_t          Render2D::s_FontHeight = 0;
+
+Ref<ITextureArray>                   Render2D::s_TextureArray;
+Ref<IShader>                         Render2D::s_ArrayShader;
+int                                  Render2D::s_ArrayViewProj = -1;
+std::vector<Render2D::ArrayTexture>  Render2D::s_ArrayTextures;
+uint32_t                             Render2D::s_ArrayLayerCount = 0;
+bool                                 Render2D::s_BatchArray = false;
 
 std::vector<Render2D::QuadVertex> Render2D::s_CPUBuffer;
+std::vector<Render2D::QuadInstance> Render2D::s_Instances;
 uint32_t Render2D::s_QuadCount = 0;
 
 Ref<ITexture2D> Render2D::s_TextureSlots[Render2D::MaxTexSlots] = {};
@@ -24,7 +57,21 @@ uint32_t        Render2D::s_TextureSlotCount = 0;
 
 glm::mat4 Render2D::s_ViewProj(1.0f);
 
+uint16_t  Render2D::s_Layer = 0;
+BlendMode Render2D::s_Blend = BlendMode::Alpha;
+BlendMode Render2D::s_ActiveBlend = BlendMode::Alpha;
+bool      Render2D::s_Deferred = false;
+std::vector<Render2D::QuadInstance> Render2D::s_Queue;
+std::vector<Render2D::QueuedQuad>   Render2D::s_QueueKeys;
+std::vector<Ref<ITexture2D>>        Render2D::s_QueueTextures;
+std::vector<uint32_t>               Render2D::s_ListTexIds;
+
+Render2D::DrawList* Render2D::s_Recording = nullptr;
+uint16_t            Render2D::s_RecordLayer = 0;
+BlendMode           Render2D::s_RecordBlend = BlendMode::Alpha;
+
 Render2D::Statistics Render2D::s_Stats{};
+std::atomic<uint32_t> Render2D::s_StreamStalls{0};
 bool Render2D::s_Initialized = false;
 
 // ==================== Public API ====================
@@ -37,8 +84,10 @@ bool Render2D::Initialize() {
   s_IBO    = Factory::CreateBuffer(BufferType::Index);
   #ifdef __EMSCRIPTEN__
   s_Shader = Factory::CreateShader("Data/Shaders/basicEs.glsl");
+  s_InstanceShader = Factory::CreateShader("Data/Shaders/instancedEs.glsl");
   #else
   s_Shader = Factory::CreateShader("Data/Shaders/basic.glsl");
+  s_InstanceShader = Factory::CreateShader("Data/Shaders/instanced.glsl");
   #endif
 
   // std::string log;
@@ -49,53 +98,63 @@ bool Render2D::Initialize() {
   s_Shader->Bind();
   int samplers[MaxTexSlots]; for (int i=0; i<(int)MaxTexSlots; ++i) samplers[i] = i;
   s_Shader->SetIntArray("uTextures", samplers, (int)MaxTexSlots);
+  s_ShaderViewProj = s_Shader->GetUniform("uViewProj");
+  if (s_InstanceShader && s_InstanceShader->IsValid()) {
+    s_InstanceShader->Bind();
+    s_InstanceShader->SetIntArray("uTextures", samplers, (int)MaxTexSlots);
+    s_InstanceViewProj = s_InstanceShader->GetUniform("uViewProj");
+  } else {
+    EN_CORE_WARN("[Render2D] instanced shader unavailable, using per-vertex quads");
+    s_InstanceShader.reset();
+  }
 
-  // CPU staging
-  s_CPUBuffer.clear();
-  s_CPUBuffer.resize(MaxVertices);
-
-  // GPU buffers
-  s_VBO->SetData(nullptr, sizeof(QuadVertex) * MaxVertices, /*dynamic*/true);
-
-  // Build index buffer once
-  std::vector<uint32_t> indices(MaxIndices);
-  uint32_t offset = 0;
+  // Build index buffer once; 16-bit, since a batch never passes 4 * MaxQuads vertices
+  static_assert(MaxQuads * 4 <= 0x10000, "batch vertices must fit 16-bit indices");
+  std::vector<uint16_t> indices(MaxIndices);
+  uint16_t offset = 0;
   for (uint32_t i = 0; i < MaxIndices; i += 6) {
-    indices[i + 0] = offset + 0;
-    indices[i + 1] = offset + 1;
-    indices[i + 2] = offset + 2;
-    indices[i + 3] = offset + 0;
-    indices[i + 4] = offset + 2;
-    indices[i + 5] = offset + 3;
+    indices[i + 0] = (uint16_t)(offset + 0);
+    indices[i + 1] = (uint16_t)(offset + 1);
+    indices[i + 2] = (uint16_t)(offset + 2);
+    indices[i + 3] = (uint16_t)(offset + 0);
+    indices[i + 4] = (uint16_t)(offset + 2);
+    indices[i + 5] = (uint16_t)(offset + 3);
     offset += 4;
   }
-  s_IBO->SetData(indices.data(), indices.size() * sizeof(uint32_t), /*dynamic*/false);
+  s_IBO->SetData(indices.data(), indices.size() * sizeof(uint16_t), /*dynamic*/false);
 
-  // Vertex layout (Hazel order)
+  // Vertex layout: attribute pointers are set per flush (BindVertexLayout), since the
+  // data lands at a different offset of the streaming buffer each time
   s_VAO->Bind();
-  s_VBO->Bind();
   s_IBO->Bind(); // bind EBO while VAO bound (critical)
-  // aPos (vec3)
-  s_VAO->EnableAttrib(0, 3, 0x1406/*GL_FLOAT*/, false, sizeof(QuadVertex), offsetof(QuadVertex, Position));
-  // aColor (vec4)
-  s_VAO->EnableAttrib(1, 4, 0x1406/*GL_FLOAT*/, false, sizeof(QuadVertex), offsetof(QuadVertex, Color));
-  // aUV (vec2)
-  s_VAO->EnableAttrib(2, 2, 0x1406/*GL_FLOAT*/, false, sizeof(QuadVertex), offsetof(QuadVertex, TexCoord));
-  // aTexIndex (float)
-  s_VAO->EnableAttrib(3, 1, 0x1406/*GL_FLOAT*/, false, sizeof(QuadVertex), offsetof(QuadVertex, TexIndex));
-  // aTiling (float)
-  s_VAO->EnableAttrib(4, 1, 0x1406/*GL_FLOAT*/, false, sizeof(QuadVertex), offsetof(QuadVertex, Tiling));
   s_VAO->Unbind();
 
-  // 1x1 white texture in slot 0
-  s_WhiteTexture = Factory::CreateTexture2D();
-  const uint32_t white = 0xFFFFFFFFu;
-  s_WhiteTexture->Create(1, 1, 4, &white);
+  // Instanced layout: unit quad corners per vertex, QuadInstance per instance
+  if (s_InstanceShader) {
+    static const glm::vec2 kCorners[4] = {
+      { 0.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f },
+    };
+    s_InstanceVAO = Factory::CreateVertexArray();
+    s_UnitQuadVBO = Factory::CreateBuffer(BufferType::Vertex);
+    s_InstanceVBO = Factory::CreateBuffer(BufferType::Vertex);
+    s_UnitQuadVBO->SetData(kCorners, sizeof(kCorners), /*dynamic*/false);
 
-  ResetStats();
-  StartBatch();
+    s_InstanceVAO->Bind();
+    s_IBO->Bind();
+    s_UnitQuadVBO->Bind();
+    s_InstanceVAO->EnableAttrib(0, 2, 0x1406/*GL_FLOAT*/, false, sizeof(glm::vec2), 0);
+    for (unsigned int i = 1; i <= 7; ++i) s_InstanceVAO->SetAttribDivisor(i, 1);
+    s_InstanceVAO->Unbind();
+  }
+
+  // White texture in slot 0, which also carries the built-in font
+  BuildWhiteTexture();
 
   s_Initialized = true;
+  SetInstancing(true);
+
+  ResetStats();
+  StartBatch();
   return true;
 }
 
@@ -111,8 +170,25 @@ void Render2D::Shutdown() {
   s_VAO.reset();
   s_VBO.reset();
   s_IBO.reset();
+  s_InstanceShader.reset();
+  s_InstanceVAO.reset();
+  s_InstanceVBO.reset();
+  s_UnitQuadVBO.reset();
+  s_UseInstancing = false;
   s_WhiteTexture.reset();
+  s_FontPixels.clear();
+  s_TextureArray.reset();
+  s_ArrayShader.reset();
+  s_ArrayTextures.clear();
+  s_ArrayLayerCount = 0;
+  s_BatchArray = false;
   s_CPUBuffer.clear();
+  s_Instances.clear();
+  s_Queue.clear();
+  s_QueueKeys.clear();
+  s_QueueTextures.clear();
+  s_ListTexIds.clear();
+  s_Recording = nullptr;
   s_QuadCount = 0;
   s_Initialized = false;
 }
@@ -121,40 +197,231 @@ void Render2D::BeginScene(const Camera2D& cam) { BeginScene(cam.ViewProj()); }
 
 void Render2D::BeginScene(const glm::mat4 &viewProj) {
   s_ViewProj = viewProj;
-  s_Shader->Bind();
-  s_Shader->SetMat4("uViewProj", s_ViewProj);
+  IShader* shader = s_UseInstancing ? s_InstanceShader.get() : s_Shader.get();
+  const int location = s_UseInstancing ? s_InstanceViewProj : s_ShaderViewProj;
+  RenderCommand::Enqueue([shader, location, viewProj] {
+    shader->Bind();
+    shader->SetMat4(location, viewProj);
+  });
+  s_Layer = 0;
+  s_Blend = BlendMode::Alpha;
+  if (s_ActiveBlend != BlendMode::Alpha) {
+    RenderCommand::SetBlendMode(BlendMode::Alpha);
+    s_ActiveBlend = BlendMode::Alpha;
+  }
   StartBatch();
 }
 
 void Render2D::EndScene() { Flush(); }
 
 void Render2D::Flush() {
+  EN_PROFILE_ZONE("Render2D::Flush");
+  if (s_QuadCount == 0 && s_QueueKeys.empty()) return;
+  RenderCommand::BeginGpuPass();
+  SubmitQueue();
+  FlushBatch();
+  RenderCommand::EndGpuPass();
+}
+
+void Render2D::FlushBatch() {
   if (s_QuadCount == 0) return;
 
-  const uint32_t vertCount  = s_QuadCount * 4;
-  const uint32_t indexCount = s_QuadCount * 6;
+  BatchDraw draw;
+  draw.Quads = s_QuadCount;
+  draw.Instanced = s_UseInstancing;
+  draw.Array = s_BatchArray;
+  draw.ViewProj = s_ViewProj;
+  draw.Bytes = s_UseInstancing ? sizeof(QuadInstance) * s_QuadCount
+                               : sizeof(QuadVertex) * s_QuadCount * 4;
+  draw.Data = s_UseInstancing ? (const void*)s_Instances.data() : (const void*)s_CPUBuffer.data();
+  if (RenderCommandList* list = RenderCommand::Recording()) {
+    // executed a frame later on the render thread; the staging arrays are reused by then
+    void* copy = list->Allocate(draw.Bytes);
+    std::memcpy(copy, draw.Data, draw.Bytes);
+    draw.Data = copy;
+  }
+  if (!s_BatchArray) {
+    draw.TextureCount = s_TextureSlotCount;
+    for (uint32_t i = 0; i < s_TextureSlotCount; ++i) draw.Textures[i] = std::move(s_TextureSlots[i]);
+  }
 
-  // Upload vertices
-  s_VBO->UpdateSubData(0, s_CPUBuffer.data(), sizeof(QuadVertex) * vertCount);
+  s_Stats.UploadBytes += (uint32_t)draw.Bytes;
+  s_Stats.TextureBinds += s_BatchArray ? 1 : s_TextureSlotCount;
+  s_Stats.DrawCalls++;
+
+  RenderCommand::Enqueue([draw = std::move(draw)] { DrawBatch(draw); });
+  StartBatch();
+}
+
+void Render2D::DrawBatch(const BatchDraw& draw) {
+  // Upload vertices (or one record per quad) into the streaming ring; never waits
+  IBuffer& vbo = draw.Instanced ? *s_InstanceVBO : *s_VBO;
+  const uint32_t stallsBefore = vbo.GetStreamStats().Stalls;
+  const size_t offset = vbo.Stream(draw.Data, draw.Bytes);
+  s_StreamStalls.fetch_add(vbo.GetStreamStats().Stalls - stallsBefore, std::memory_order_relaxed);
 
   // Bind textures used this batch
-  for (uint32_t i = 0; i < s_TextureSlotCount; ++i) {
-    s_TextureSlots[i]->Bind((int)i);
-    s_Stats.TextureBinds++;
+  if (draw.Array) {
+    s_TextureArray->Bind(0);
+  } else {
+    for (uint32_t i = 0; i < draw.TextureCount; ++i) draw.Textures[i]->Bind((int)i);
   }
 
   // Draw
-  s_VAO->Bind();     // ensure VAO (with attached EBO/attribs) is current
-  s_Shader->Bind();
-  s_Shader->SetMat4("uViewProj", s_ViewProj);
-  RenderCommand::DrawIndexed(*s_VAO, (int)indexCount);
+  if (draw.Array) {
+    s_InstanceVAO->Bind();
+    BindInstanceLayout(offset);
+    s_ArrayShader->Bind();
+    s_ArrayShader->SetMat4(s_ArrayViewProj, draw.ViewProj);
+    RenderCommand::DrawIndexedInstanced(*s_InstanceVAO, 6, draw.Quads, IndexType::U16);
+  } else if (draw.Instanced) {
+    s_InstanceVAO->Bind();
+    BindInstanceLayout(offset);
+    s_InstanceShader->Bind();
+    s_InstanceShader->SetMat4(s_InstanceViewProj, draw.ViewProj);
+    RenderCommand::DrawIndexedInstanced(*s_InstanceVAO, 6, draw.Quads, IndexType::U16);
+  } else {
+    s_VAO->Bind();     // ensure VAO (with attached EBO/attribs) is current
+    BindVertexLayout(offset);
+    s_Shader->Bind();
+    s_Shader->SetMat4(s_ShaderViewProj, draw.ViewProj);
+    RenderCommand::DrawIndexed(*s_VAO, draw.Quads * 6, IndexType::U16);
+  }
+}
 
-  s_Stats.DrawCalls++;
-  StartBatch();
+void Render2D::SetInstancing(bool enable) {
+  if (!s_Initialized) return;
+  Flush();
+  s_UseInstancing = enable && s_InstanceShader;
+
+  // CPU staging and GPU ring only for the active path; the ring holds a few full
+  // batches so a segment is normally long retired by the time we come back to it
+  if (s_UseInstancing) {
+    s_Instances.resize(MaxQuads);
+    std::vector<QuadVertex>().swap(s_CPUBuffer);
+  } else {
+    s_CPUBuffer.resize(MaxVertices);
+    std::vector<QuadInstance>().swap(s_Instances);
+  }
+  RenderCommand::Enqueue([instancing = s_UseInstancing] {
+    if (instancing) {
+      s_InstanceVBO->InitStreaming(sizeof(QuadInstance) * MaxQuads * 3);
+      s_VBO->SetData(nullptr, 0);
+    } else {
+      s_VBO->InitStreaming(sizeof(QuadVertex) * MaxVertices * 3);
+      if (s_InstanceVBO) s_InstanceVBO->SetData(nullptr, 0);
+    }
+  });
+  BeginScene(s_ViewProj);
+}
+
+bool Render2D::IsInstancing() { return s_UseInstancing; }
+
+// ==================== Texture array ====================
+
+bool Render2D::EnableTextureArray(uint32_t layerWidth, uint32_t layerHeight, uint32_t maxLayers) {
+  if (!s_Initialized || !s_InstanceShader) return false;
+  if (s_TextureArray) {
+    return s_TextureArray->Width() == layerWidth && s_TextureArray->Height() == layerHeight;
+  }
+
+  #ifdef __EMSCRIPTEN__
+  Ref<IShader> shader = Factory::CreateShader("Data/Shaders/instancedArrayEs.glsl");
+  #else
+  Ref<IShader> shader = Factory::CreateShader("Data/Shaders/instancedArray.glsl");
+  #endif
+  Ref<ITextureArray> array = Factory::CreateTextureArray();
+  if (!shader || !shader->IsValid() || !array ||
+      !array->Create(layerWidth, layerHeight, maxLayers)) {
+    EN_CORE_WARN("[Render2D] texture array {}x{}x{} unavailable, keeping texture slots",
+                 layerWidth, layerHeight, maxLayers);
+    return false;
+  }
+  Flush();
+  const int unit = 0;
+  shader->Bind();
+  shader->SetIntArray("uTextureArray", &unit, 1);
+  s_ArrayViewProj = shader->GetUniform("uViewProj");
+  (s_UseInstancing ? s_InstanceShader : s_Shader)->Bind();
+
+  s_ArrayShader = std::move(shader);
+  s_TextureArray = std::move(array);
+  s_ArrayTextures.clear();
+  s_ArrayLayerCount = 0;
+  return true;
 }
 
-void Render2D::ResetStats() { s_Stats = {}; }
-Render2D::Statistics Render2D::GetStats() { return s_Stats; }
+bool Render2D::AcceptsArrayLayer(uint32_t width, uint32_t height) {
+  return s_TextureArray && s_TextureArray->Width() == width &&
+         s_TextureArray->Height() == height && s_ArrayLayerCount < s_TextureArray->Layers();
+}
+
+bool Render2D::AddArrayLayer(const Ref<ITexture2D>& texture, const void* rgba) {
+  if (!texture || !rgba || !AcceptsArrayLayer(texture->Width(), texture->Height())) return false;
+  if (!s_TextureArray->SetLayer(s_ArrayLayerCount, rgba)) return false;
+  s_ArrayTextures.push_back({ texture, (float)s_ArrayLayerCount, { 0.0f, 0.0f, 1.0f, 1.0f } });
+  ++s_ArrayLayerCount;
+  return true;
+}
+
+const uint32_t* Render2D::FontPixels(uint32_t& width, uint32_t& height) {
+  width = s_FontWidth;
+  height = s_FontHeight;
+  return s_FontPixels.empty() ? nullptr : s_FontPixels.data();
+}
+
+bool Render2D::HasArrayFont() {
+  for (const ArrayTexture& e : s_ArrayTextures)
+    if (e.Texture == s_WhiteTexture) return true;
+  return false;
+}
+
+bool Render2D::SetArrayFont(const Sprite& sprite) {
+  if (!sprite || HasArrayFont()) return false;
+  for (const ArrayTexture& e : s_ArrayTextures) {
+    if (e.Texture != sprite.Texture) continue;
+    Flush();
+    const glm::vec2 offset = glm::vec2(sprite.UV.x, sprite.UV.y);
+    const glm::vec2 scale = glm::vec2(sprite.UV.z, sprite.UV.w) - offset;
+    s_ArrayTextures.push_back({ s_WhiteTexture, e.Layer, { offset, scale } });
+    return true;
+  }
+  return false;
+}
+
+const Render2D::ArrayTexture* Render2D::BatchTexture(const Ref<ITexture2D>& texture, float& texIndex) {
+  const ArrayTexture* entry = nullptr;
+  if (s_UseInstancing) {
+    for (const ArrayTexture& e : s_ArrayTextures)
+      if (e.Texture == texture) { entry = &e; break; }
+  }
+  if ((entry != nullptr) != s_BatchArray) {
+    if (s_QuadCount > 0) FlushBatch();
+    s_BatchArray = entry != nullptr;
+  }
+  texIndex = entry ? entry->Layer : GetTextureIndexOrAppend(texture);
+  return entry;
+}
+
+void Render2D::MapArrayUV(const ArrayTexture& entry, glm::vec4& uv) {
+  const glm::vec2 offset(entry.UVMap.x, entry.UVMap.y);
+  const glm::vec2 scale(entry.UVMap.z, entry.UVMap.w);
+  uv = glm::vec4(offset + glm::vec2(uv.x, uv.y) * scale, offset + glm::vec2(uv.z, uv.w) * scale);
+}
+
+void Render2D::ResetStats() {
+  s_Stats = {};
+  s_StreamStalls.store(0, std::memory_order_relaxed);
+}
+Render2D::Statistics Render2D::GetStats() {
+  Statistics stats = s_Stats;
+  stats.UploadStalls = s_StreamStalls.load(std::memory_order_relaxed);
+  const GpuTimings gpu = RenderCommand::GetGpuTimings();
+  stats.GpuFrameMs = gpu.FrameMs;
+  stats.GpuFlushMs = gpu.PassMs;
+  stats.GpuFlushes = gpu.Passes;
+  return stats;
+}
 
 // ==================== Draw API ====================
 
@@ -163,10 +430,13 @@ void Render2D::DrawQuad(const glm::vec2& pos, const glm::vec2& size, const glm::
 }
 
 void Render2D::DrawQuad(const glm::vec3& pos, const glm::vec2& size, const glm::vec4& color) {
-  glm::mat4 transform =
-    glm::translate(glm::mat4(1.0f), pos) *
-    glm::scale(glm::mat4(1.0f), glm::vec3(size, 1.0f));
-  DrawQuad(transform, color);
+  // axis-aligned: the record is the corner and the two edges, no matrix needed
+  QuadInstance q;
+  MakeQuad(glm::vec2(pos), size, 0.0f, q);
+  q.UVRect = s_WhiteUV;
+  q.Color  = PackColor(color);
+  q.Tiling = 1.0f;
+  Submit(q, s_WhiteTexture);
 }
 
 void Render2D::DrawQuad(const glm::vec2& pos, const glm::vec2& size, const Ref<ITexture2D>& tex,
@@ -176,36 +446,336 @@ void Render2D::DrawQuad(const glm::vec2& pos, const glm::vec2& size, const Ref<I
 
 void Render2D::DrawQuad(const glm::vec3& pos, const glm::vec2& size, const Ref<ITexture2D>& tex,
                         float tilingFactor, const glm::vec4& tint) {
-  glm::mat4 transform =
-    glm::translate(glm::mat4(1.0f), pos) *
-    glm::scale(glm::mat4(1.0f), glm::vec3(size, 1.0f));
-  DrawQuad(transform, tex, tilingFactor, tint);
+  if (!tex) { DrawQuad(pos, size, tint); return; }
+  QuadInstance q;
+  MakeQuad(glm::vec2(pos), size, 0.0f, q);
+  q.UVRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+  q.Color  = PackColor(tint);
+  q.Tiling = tilingFactor;
+  Submit(q, tex);
 }
 
 void Render2D::DrawQuad(const glm::mat4& transform, const glm::vec4& color) {
-  if (s_QuadCount >= MaxQuads) NextBatch();
-  PushQuad(transform, color, /*texIndex*/ 0.0f, /*tiling*/ 1.0f);
+  SubmitQuad(transform, color, s_WhiteTexture, /*tiling*/ 1.0f, s_WhiteUV);
 }
 
 void Render2D::DrawQuad(const glm::mat4& transform, const Ref<ITexture2D>& tex,
                         float tilingFactor, const glm::vec4& tint) {
-  if (s_QuadCount >= MaxQuads) NextBatch();
-  float texIndex = GetTextureIndexOrAppend(tex ? tex : s_WhiteTexture);
-  PushQuad(transform, tint, texIndex, tilingFactor);
+  if (!tex) { DrawQuad(transform, tint); return; }
+  SubmitQuad(transform, tint, tex, tilingFactor);
+}
+
+void Render2D::DrawQuad(const glm::vec2& pos, const glm::vec2& size, const Sprite& sprite,
+                        const glm::vec4& tint) {
+  const SpriteDesc desc{ pos, size, 0.0f, tint, &sprite };
+  QuadInstance q;
+  MakeSpriteQuad(desc, q);
+  Submit(q, SpriteTexture(desc));
+}
+
+void Render2D::DrawQuads(std::span<const SpriteDesc> sprites) {
+  const size_t count = sprites.size();
+  if (s_Recording || (!s_Deferred && !s_UseInstancing)) {
+    for (const SpriteDesc& s : sprites) {
+      QuadInstance q;
+      MakeSpriteQuad(s, q);
+      Submit(q, SpriteTexture(s));
+    }
+    return;
+  }
+
+  size_t i = 0;
+  if (s_Deferred) {
+    // one key prefix per run of equal textures
+    s_Queue.reserve(s_Queue.size() + count);
+    s_QueueKeys.reserve(s_QueueKeys.size() + count);
+    while (i < count) {
+      const Ref<ITexture2D>& tex = SpriteTexture(sprites[i]);
+      const uint64_t prefix = ((uint64_t)s_Layer << 48) | ((uint64_t)s_Blend << 44) |
+                              ((uint64_t)QueueTextureId(tex) << 32);
+      for (; i < count && SpriteTexture(sprites[i]) == tex; ++i) {
+        s_QueueKeys.push_back({ prefix | (uint32_t)s_QueueKeys.size(), (uint32_t)s_Queue.size() });
+        MakeSpriteQuad(sprites[i], s_Queue.emplace_back());
+      }
+    }
+    return;
+  }
+
+  // instanced: resolve the texture once per run, build the records in the staging array
+  while (i < count) {
+    if (s_QuadCount >= MaxQuads) NextBatch();
+    const Ref<ITexture2D>& tex = SpriteTexture(sprites[i]);
+    float texIndex;
+    const ArrayTexture* array = BatchTexture(tex, texIndex);
+    QuadInstance* dst = s_Instances.data() + s_QuadCount;
+    const size_t room = MaxQuads - s_QuadCount;
+    size_t n = 0;
+    for (; i < count && n < room && SpriteTexture(sprites[i]) == tex; ++i, ++n) {
+      MakeSpriteQuad(sprites[i], dst[n]);
+      dst[n].TexIndex = texIndex;
+      if (array) MapArrayUV(*array, dst[n].UVRect);
+    }
+    s_QuadCount += (uint32_t)n;
+    s_Stats.QuadCount += (uint32_t)n;
+  }
+}
+
+void Render2D::DrawQuad(const glm::mat4& transform, const Sprite& sprite, const glm::vec4& tint) {
+  if (!sprite.Texture) { DrawQuad(transform, tint); return; }
+  SubmitQuad(transform, tint, sprite.Texture, /*tiling*/ 1.0f, sprite.UV);
+}
+
+void Render2D::DrawGlyph(const glm::vec2& pos, float scale, char c, const glm::vec4& color) {
+  QuadInstance q;
+  if (!MakeGlyphQuad(pos, scale, c, q)) return;
+  q.Color = PackColor(color);
+  Submit(q, s_WhiteTexture);
+}
+
+bool Render2D::MakeGlyphQuad(const glm::vec2& pos, float scale, char c, QuadInstance& out) {
+  const unsigned char u = static_cast<unsigned char>(c) < 128 ? (unsigned char)c : '?';
+  if (s_GlyphEmpty[u]) return false;
+  const Glyph& g = glyphFor(c);
+  out.Origin   = pos;
+  out.AxisX    = { (float)g.width * scale, 0.0f };
+  out.AxisY    = { 0.0f, 5.0f * scale };
+  out.UVRect   = s_GlyphUV[u];
+  out.Color    = 0xFFFFFFFFu;
+  out.TexIndex = 0.0f;
+  out.Tiling   = 1.0f;
+  return true;
+}
+
+void Render2D::DrawGlyphQuads(const QuadInstance* quads, size_t count, const glm::vec2& offset,
+                              const glm::vec4& color) {
+  const uint32_t packed = PackColor(color);
+  if (s_Recording || s_Deferred || !s_UseInstancing) {
+    for (size_t i = 0; i < count; ++i) {
+      QuadInstance q = quads[i];
+      q.Origin += offset;
+      q.Color = packed;
+      Submit(q, s_WhiteTexture);
+    }
+    return;
+  }
+
+  // instanced: copy whole runs straight into the staging array, then patch
+  while (count > 0) {
+    if (s_QuadCount >= MaxQuads) NextBatch();
+    float slot;
+    const ArrayTexture* array = BatchTexture(s_WhiteTexture, slot);
+    const size_t n = std::min<size_t>(count, MaxQuads - s_QuadCount);
+    QuadInstance* dst = s_Instances.data() + s_QuadCount;
+    std::memcpy(dst, quads, n * sizeof(QuadInstance));
+    for (size_t i = 0; i < n; ++i) {
+      dst[i].Origin += offset;
+      dst[i].Color = packed;
+      dst[i].TexIndex = slot;
+      if (array) MapArrayUV(*array, dst[i].UVRect);
+    }
+    s_QuadCount += (uint32_t)n;
+    s_Stats.QuadCount += (uint32_t)n;
+    quads += n;
+    count -= n;
+  }
+}
+
+// ==================== Deferred submission ====================
+
+void Render2D::SetDeferred(bool enable) {
+  if (enable == s_Deferred) return;
+  Flush();
+  s_Deferred = enable;
+}
+
+bool Render2D::IsDeferred() { return s_Deferred; }
+
+void Render2D::SetLayer(uint16_t layer) { s_Layer = layer; }
+uint16_t Render2D::GetLayer() { return s_Layer; }
+
+void Render2D::SetBlendMode(BlendMode mode) {
+  s_Blend = mode;
+  // deferred: applied in SubmitQueue; recording: stored per quad
+  if (s_Deferred || s_Recording || mode == s_ActiveBlend) return;
+  FlushBatch();
+  RenderCommand::SetBlendMode(mode);
+  s_ActiveBlend = mode;
+}
+
+void Render2D::SubmitQueue() {
+  if (s_QueueKeys.empty()) return;
+
+  // keys are unique (submission order is the low word), so plain sort is stable enough
+  std::sort(s_QueueKeys.begin(), s_QueueKeys.end(),
+            [](const QueuedQuad& a, const QueuedQuad& b) { return a.Key < b.Key; });
+
+  for (const QueuedQuad& qq : s_QueueKeys) {
+    const BlendMode blend = (BlendMode)((qq.Key >> 44) & 0xF);
+    if (blend != s_ActiveBlend) {
+      FlushBatch();
+      RenderCommand::SetBlendMode(blend);
+      s_ActiveBlend = blend;
+    }
+    if (s_QuadCount >= MaxQuads) NextBatch();
+    QuadInstance q = s_Queue[qq.Index];
+    const ArrayTexture* array = BatchTexture(s_QueueTextures[(qq.Key >> 32) & 0xFFF], q.TexIndex);
+    if (array) MapArrayUV(*array, q.UVRect);
+    PushQuad(q);
+  }
+  // back to the current mode, or immediate quads after this would use the last key's
+  if (s_ActiveBlend != s_Blend) {
+    FlushBatch();
+    RenderCommand::SetBlendMode(s_Blend);
+    s_ActiveBlend = s_Blend;
+  }
+
+  s_Queue.clear();
+  s_QueueKeys.clear();
+  s_QueueTextures.clear();
+}
+
+// ==================== Retained draw lists ====================
+
+void Render2D::BeginDrawList(DrawList& list, uint64_t version) {
+  if (s_Recording) {
+    EN_CORE_WARN("[Render2D] BeginDrawList while recording; ending the previous list");
+    EndDrawList();
+  }
+  list.m_Quads.clear();
+  list.m_Keys.clear();
+  list.m_Textures.clear();
+  list.m_Version = version;
+  list.m_LayerSpan = 0;
+  list.m_Recorded = false;
+  s_Recording = &list;
+  s_RecordLayer = s_Layer;
+  s_RecordBlend = s_Blend;
+}
+
+void Render2D::EndDrawList() {
+  if (!s_Recording) return;
+  s_Recording->m_LayerSpan = (uint16_t)(s_Layer - s_RecordLayer);
+  s_Recording->m_Recorded = true;
+  s_Recording = nullptr;
+  s_Layer = s_RecordLayer;
+  s_Blend = s_RecordBlend;
+}
+
+void Render2D::SubmitDrawList(const DrawList& list) {
+  const uint16_t  baseLayer = s_Layer;
+  const BlendMode baseBlend = s_Blend;
+  const size_t    count     = list.m_Quads.size();
+
+  if (s_Recording || !s_Deferred) {
+    // into another list, or straight into the batch: blend changes flush there
+    for (size_t i = 0; i < count; ++i) {
+      const uint32_t key = list.m_Keys[i];
+      s_Layer = (uint16_t)(baseLayer + (key >> 16));
+      SetBlendMode((BlendMode)((key >> 12) & 0xF));
+      Submit(list.m_Quads[i], list.m_Textures[key & 0xFFF]);
+    }
+    SetBlendMode(baseBlend);
+  } else if (count > 0) {
+    // deferred: the records go into the queue as one block, only the keys are built
+    // make room first: QueueTextureId flushing halfway would strand the ids before it
+    if (s_QueueTextures.size() + list.m_Textures.size() > 0xFFF) SubmitQueue();
+    s_ListTexIds.resize(list.m_Textures.size());
+    for (size_t t = 0; t < list.m_Textures.size(); ++t)
+      s_ListTexIds[t] = QueueTextureId(list.m_Textures[t]);
+
+    const uint32_t first = (uint32_t)s_Queue.size();
+    s_Queue.insert(s_Queue.end(), list.m_Quads.begin(), list.m_Quads.end());
+    s_QueueKeys.reserve(s_QueueKeys.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+      const uint32_t key = list.m_Keys[i];
+      const uint64_t sortKey = ((uint64_t)(uint16_t)(baseLayer + (key >> 16)) << 48) |
+                               ((uint64_t)((key >> 12) & 0xF) << 44) |
+                               ((uint64_t)s_ListTexIds[key & 0xFFF] << 32) |
+                               (uint32_t)s_QueueKeys.size();
+      s_QueueKeys.push_back({ sortKey, first + (uint32_t)i });
+    }
+  }
+
+  s_Layer = (uint16_t)(baseLayer + list.m_LayerSpan);
 }
 
 // ==================== Internals ====================
 
+void Render2D::BindVertexLayout(size_t base) {
+  // Hazel order; VAO must be bound
+  s_VBO->Bind();
+  // aPos (vec2)
+  s_VAO->EnableAttrib(0, 2, 0x1406/*GL_FLOAT*/, false, sizeof(QuadVertex), base + offsetof(QuadVertex, Position));
+  // aColor (RGBA8 -> vec4)
+  s_VAO->EnableAttrib(1, 4, 0x1401/*GL_UNSIGNED_BYTE*/, true, sizeof(QuadVertex), base + offsetof(QuadVertex, Color));
+  // aUV (unorm16 -> vec2)
+  s_VAO->EnableAttrib(2, 2, 0x1403/*GL_UNSIGNED_SHORT*/, true, sizeof(QuadVertex), base + offsetof(QuadVertex, TexCoord));
+  // aTexIndex (byte -> float)
+  s_VAO->EnableAttrib(3, 1, 0x1401/*GL_UNSIGNED_BYTE*/, false, sizeof(QuadVertex), base + offsetof(QuadVertex, TexIndex));
+  // aTiling (8.8 ushort -> float, scaled in the shader)
+  s_VAO->EnableAttrib(4, 1, 0x1403/*GL_UNSIGNED_SHORT*/, false, sizeof(QuadVertex), base + offsetof(QuadVertex, Tiling));
+}
+
+void Render2D::BindInstanceLayout(size_t base) {
+  s_InstanceVBO->Bind();
+  s_InstanceVAO->EnableAttrib(1, 2, 0x1406/*GL_FLOAT*/, false, sizeof(QuadInstance), base + offsetof(QuadInstance, Origin));
+  s_InstanceVAO->EnableAttrib(2, 2, 0x1406/*GL_FLOAT*/, false, sizeof(QuadInstance), base + offsetof(QuadInstance, AxisX));
+  s_InstanceVAO->EnableAttrib(3, 2, 0x1406/*GL_FLOAT*/, false, sizeof(QuadInstance), base + offsetof(QuadInstance, AxisY));
+  s_InstanceVAO->EnableAttrib(4, 4, 0x1406/*GL_FLOAT*/, false, sizeof(QuadInstance), base + offsetof(QuadInstance, UVRect));
+  s_InstanceVAO->EnableAttrib(5, 4, 0x1401/*GL_UNSIGNED_BYTE*/, true, sizeof(QuadInstance), base + offsetof(QuadInstance, Color));
+  s_InstanceVAO->EnableAttrib(6, 1, 0x1406/*GL_FLOAT*/, false, sizeof(QuadInstance), base + offsetof(QuadInstance, TexIndex));
+  s_InstanceVAO->EnableAttrib(7, 1, 0x1406/*GL_FLOAT*/, false, sizeof(QuadInstance), base + offsetof(QuadInstance, Tiling));
+}
+
+void Render2D::BuildWhiteTexture() {
+  // 16x8 grid of 6x7 cells: each glyph's 5 rows at (1,1) inside its cell, transparent
+  // around it so nearest sampling never bleeds. Cell 0 ('\0') is solid white and is
+  // what flat-colored quads sample, keeping text and flat quads on one texture.
+  constexpr uint32_t cellW = 6, cellH = 7, cols = 16, rows = 8;
+  constexpr uint32_t texW = cellW * cols, texH = cellH * rows;
+  std::vector<uint32_t> pixels(texW * texH, 0u);
+
+  for (uint32_t y = 0; y < cellH; ++y)
+    for (uint32_t x = 0; x < cellW; ++x) pixels[y * texW + x] = 0xFFFFFFFFu;
+  s_WhiteUV = { 1.0f / texW, 1.0f / texH, (cellW - 1.0f) / texW, (cellH - 1.0f) / texH };
+
+  for (uint32_t c = 1; c < 128; ++c) {
+    const Glyph& g = glyphFor((char)c);
+    const uint32_t ox = (c % cols) * cellW + 1, oy = (c / cols) * cellH + 1;
+    bool lit = false;
+    for (int row = 0; row < 5; ++row) {
+      const char* rowStr = g.rows[row];
+      for (int col = 0; col < g.width && rowStr[col] != '\0'; ++col) {
+        if (rowStr[col] == ' ') continue;
+        pixels[(oy + row) * texW + ox + col] = 0xFFFFFFFFu;
+        lit = true;
+      }
+    }
+    s_GlyphEmpty[c] = !lit;
+    s_GlyphUV[c] = { (float)ox / texW, (float)oy / texH,
+                     (float)(ox + g.width) / texW, (float)(oy + 5) / texH };
+  }
+  s_GlyphEmpty[0] = true;
+
+  s_WhiteTexture = Factory::CreateTexture2D();
+  s_WhiteTexture->Create(texW, texH, 4, pixels.data());
+  // kept for atlases that copy the font into the texture array
+  s_FontPixels = std::move(pixels);
+  s_FontWidth = texW;
+  s_FontHeight = texH;
+}
+
 void Render2D::StartBatch() {
   s_QuadCount = 0;
   s_TextureSlotCount = 0;
+  s_BatchArray = false;
   // std::memset(s_TextureSlots, 0, sizeof(s_TextureSlots));
   std::fill(std::begin(s_TextureSlots), std::end(s_TextureSlots), Ref<ITexture2D>());
   s_TextureSlots[s_TextureSlotCount++] = s_WhiteTexture; // slot 0
 }
 
 void Render2D::NextBatch() {
-  Flush();
+  FlushBatch();
 }
 
 float Render2D::GetTextureIndexOrAppend(const Ref<ITexture2D>& texture) {
@@ -215,50 +785,160 @@ float Render2D::GetTextureIndexOrAppend(const Ref<ITexture2D>& texture) {
   }
   // Need a new slot
   if (s_TextureSlotCount >= MaxTexSlots) {
-    Flush();
+    FlushBatch();
   }
   s_TextureSlots[s_TextureSlotCount] = texture;
   return (float)(s_TextureSlotCount++);
 }
 
-void Render2D::PushQuad(const glm::mat4& transform,
-                        const glm::vec4& color,
-                        float texIndex,
-                        float tiling) {
-  // Quad in local space (Hazel canonical order)
-  static const glm::vec4 kPositions[4] = {
-    { 0.0f, 0.0f, 0.0f, 1.0f },
-    { 0.0f, 1.0f, 0.0f, 1.0f },
-    { 1.0f, 1.0f, 0.0f, 1.0f },
-    { 1.0f, 0.0f, 0.0f, 1.0f },
-  };
-  static const glm::vec2 kUV[4] = {
-    { 0.0f, 0.0f },
-    { 0.0f, 1.0f },
-    { 1.0f, 1.0f },
-    { 1.0f, 0.0f },
-  };
-
-  const uint32_t base = s_QuadCount * 4;
-  if (base + 3 >= s_CPUBuffer.size()) {
-    // extremely defensive; should not happen with correct MaxVerts
-    Flush();
+void Render2D::SubmitQuad(const glm::mat4& transform,
+                          const glm::vec4& color,
+                          const Ref<ITexture2D>& texture,
+                          float tiling,
+                          const glm::vec4& uvRect) {
+  // 2D affine part of the transform: column 3 is where local (0,0) lands, columns 0/1
+  // are the images of the unit edges. No need for four full mat4 * vec4.
+  QuadInstance q;
+  q.Origin   = { transform[3].x, transform[3].y };
+  q.AxisX    = { transform[0].x, transform[0].y };
+  q.AxisY    = { transform[1].x, transform[1].y };
+  q.UVRect   = uvRect;
+  q.Color    = PackColor(color);
+  q.Tiling   = tiling;
+  Submit(q, texture);
+}
+
+void Render2D::Submit(QuadInstance q, const Ref<ITexture2D>& texture) {
+  if (s_Recording) {
+    DrawList& list = *s_Recording;
+    uint32_t texId = 0;
+    while (texId < list.m_Textures.size() && list.m_Textures[texId] != texture) ++texId;
+    if (texId == list.m_Textures.size()) list.m_Textures.push_back(texture);
+    const uint32_t layer = (uint16_t)(s_Layer - s_RecordLayer);
+    list.m_Keys.push_back((layer << 16) | ((uint32_t)s_Blend << 12) | (texId & 0xFFF));
+    list.m_Quads.push_back(q);
+    return;
   }
 
-  QuadVertex* v = s_CPUBuffer.data() + base;
-  for (int i = 0; i < 4; ++i) {
-    glm::vec4 p = transform * kPositions[i];
-    v[i].Position = glm::vec3(p.x, p.y, p.z);
-    v[i].Color    = color;
-    v[i].TexCoord = kUV[i];
-    v[i].TexIndex = texIndex;
-    v[i].Tiling   = tiling;
+  if (s_Deferred) {
+    Enqueue(q, texture);
+    return;
+  }
+
+  if (s_QuadCount >= MaxQuads) NextBatch();
+  const ArrayTexture* array = BatchTexture(texture, q.TexIndex);
+  if (array) MapArrayUV(*array, q.UVRect);
+  PushQuad(q);
+}
+
+uint32_t Render2D::QueueTextureId(const Ref<ITexture2D>& texture) {
+  // texture id = index into this scene's texture list (usually 2-3 entries)
+  uint32_t texId = 0;
+  while (texId < s_QueueTextures.size() && s_QueueTextures[texId] != texture) ++texId;
+  if (texId == s_QueueTextures.size()) {
+    if (texId > 0xFFF) { // key space exhausted; draw what we have
+      SubmitQueue();
+      texId = 0;
+    }
+    s_QueueTextures.push_back(texture);
+  }
+  return texId;
+}
+
+void Render2D::Enqueue(const QuadInstance& q, const Ref<ITexture2D>& texture) {
+  const uint32_t texId = QueueTextureId(texture);
+  const uint64_t key = ((uint64_t)s_Layer << 48) | ((uint64_t)s_Blend << 44) |
+                       ((uint64_t)texId << 32) | (uint32_t)s_QueueKeys.size();
+  s_QueueKeys.push_back({ key, (uint32_t)s_Queue.size() });
+  s_Queue.push_back(q);
+}
+
+void Render2D::PushQuad(const QuadInstance& q) {
+  if (s_QuadCount >= MaxQuads) {
+    // extremely defensive; DrawQuad flushes before we get here
+    FlushBatch();
+  }
+
+  if (s_UseInstancing) {
+    s_Instances[s_QuadCount] = q;
+  } else {
+    // Quad in local space (Hazel canonical order): (0,0) (0,1) (1,1) (1,0)
+    const glm::vec2 p0 = q.Origin;
+    const glm::vec2 p1 = q.Origin + q.AxisY;
+    const glm::vec2 p2 = p1 + q.AxisX;
+    const glm::vec2 p3 = q.Origin + q.AxisX;
+    auto unorm16 = [](float f) { return (uint16_t)(std::clamp(f, 0.0f, 1.0f) * 65535.0f + 0.5f); };
+    const uint16_t u0 = unorm16(q.UVRect.x), v0 = unorm16(q.UVRect.y);
+    const uint16_t u1 = unorm16(q.UVRect.z), v1 = unorm16(q.UVRect.w);
+    const uint8_t slot = (uint8_t)(q.TexIndex + 0.5f);
+    const uint16_t tiling = (uint16_t)std::clamp(q.Tiling * 256.0f + 0.5f, 0.0f, 65535.0f);
+
+    QuadVertex* v = s_CPUBuffer.data() + s_QuadCount * 4;
+    v[0].Position = p0; v[0].TexCoord[0] = u0; v[0].TexCoord[1] = v0;
+    v[1].Position = p1; v[1].TexCoord[0] = u0; v[1].TexCoord[1] = v1;
+    v[2].Position = p2; v[2].TexCoord[0] = u1; v[2].TexCoord[1] = v1;
+    v[3].Position = p3; v[3].TexCoord[0] = u1; v[3].TexCoord[1] = v0;
+    for (int i = 0; i < 4; ++i) {
+      v[i].Color    = q.Color;
+      v[i].TexIndex = slot;
+      v[i].Pad      = 0;
+      v[i].Tiling   = tiling;
+    }
   }
 
   s_QuadCount++;
   s_Stats.QuadCount++;
 }
 
+void Render2D::MakeQuad(const glm::vec2& pos, const glm::vec2& size, float rotation,
+                        QuadInstance& q) {
+  if (rotation == 0.0f) {
+    q.Origin = pos;
+    q.AxisX  = { size.x, 0.0f };
+    q.AxisY  = { 0.0f, size.y };
+    return;
+  }
+  // rotate the edges about the center, as translate(center) * rotate * translate(-center)
+  const float c = std::cos(rotation), s = std::sin(rotation);
+  q.AxisX  = {  size.x * c, size.x * s };
+  q.AxisY  = { -size.y * s, size.y * c };
+  q.Origin = pos + size * 0.5f - (q.AxisX + q.AxisY) * 0.5f;
+}
+
+const Ref<ITexture2D>& Render2D::SpriteTexture(const SpriteDesc& s) {
+  return s.Image && s.Image->Texture ? s.Image->Texture : s_WhiteTexture;
+}
+
+void Render2D::MakeSpriteQuad(const SpriteDesc& s, QuadInstance& q) {
+  MakeQuad(s.Position, s.Size, s.Rotation, q);
+  q.UVRect   = s.Image && s.Image->Texture ? s.Image->UV : s_WhiteUV;
+  q.Color    = PackColor(s.Color);
+  q.TexIndex = 0.0f;
+  q.Tiling   = 1.0f;
+}
+
+uint32_t Render2D::PackColor(const glm::vec4& color) {
+  // clamp, scale and round all four channels at once, then narrow to bytes (r lowest)
+#if defined(KASINO_RENDER2D_SSE2)
+  __m128 c = _mm_loadu_ps(&color.x);
+  c = _mm_min_ps(_mm_max_ps(c, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+  __m128i i = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(c, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+  i = _mm_packs_epi32(i, i);
+  i = _mm_packus_epi16(i, i);
+  return (uint32_t)_mm_cvtsi128_si32(i);
+#elif defined(KASINO_RENDER2D_NEON)
+  float32x4_t c = vld1q_f32(&color.x);
+  c = vminq_f32(vmaxq_f32(c, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+  const uint32x4_t i = vcvtq_u32_f32(vmlaq_n_f32(vdupq_n_f32(0.5f), c, 255.0f));
+  const uint16x4_t h = vmovn_u32(i);
+  const uint8x8_t b = vmovn_u16(vcombine_u16(h, h));
+  return vget_lane_u32(vreinterpret_u32_u8(b), 0);
+#else
+  const glm::vec4 c = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+  return (uint32_t)c.r | ((uint32_t)c.g << 8) | ((uint32_t)c.b << 16) | ((uint32_t)c.a << 24);
+#endif
+}
+
 bool Rect::Contains(float px, float py) const {
   return px >= x && px <= x + w && py >= y && py <= y + h;
 }
@@ -268,59 +948,83 @@ glm::vec2 Rect::Center() const {
 }
 
 
+namespace {
+
+struct GlyphDef {
+  char c;
+  Glyph glyph;
+};
+
+constexpr GlyphDef kGlyphDefs[] = {
+  {'0', {3, {"###", "# #", "# #", "# #", "###"}}},
+  {'1', {3, {"  #", " ##", "  #", "  #", "  #"}}},
+  {'2', {3, {"###", "  #", "###", "#  ", "###"}}},
+  {'3', {3, {"###", "  #", " ##", "  #", "###"}}},
+  {'4', {3, {"# #", "# #", "###", "  #", "  #"}}},
+  {'5', {3, {"###", "#  ", "###", "  #", "###"}}},
+  {'6', {3, {"###", "#  ", "###", "# #", "###"}}},
+  {'7', {3, {"###", "  #", "  #", "  #", "  #"}}},
+  {'8', {3, {"###", "# #", "###", "# #", "###"}}},
+  {'9', {3, {"###", "# #", "###", "  #", "###"}}},
+  {'A', {3, {"###", "# #", "###", "# #", "# #"}}},
+  {'B', {3, {"## ", "# #", "## ", "# #", "## "}}},
+  {'C', {4, {" ###", "#   ", "#   ", "#   ", " ###"}}},
+  {'D', {3, {"## ", "# #", "# #", "# #", "## "}}},
+  {'E', {3, {"###", "#  ", "###", "#  ", "###"}}},
+  {'F', {3, {"###", "#  ", "###", "#  ", "#  "}}},
+  {'G', {4, {" ###", "#   ", "# ##", "#  #", " ###"}}},
+  {'H', {3, {"# #", "# #", "###", "# #", "# #"}}},
+  {'I', {3, {"###", " # ", " # ", " # ", "###"}}},
+  {'J', {3, {"###", "  #", "  #", "# #", "###"}}},
+  {'K', {3, {"# #", "# #", "## ", "# #", "# #"}}},
+  {'L', {3, {"#  ", "#  ", "#  ", "#  ", "###"}}},
+  {'M', {3, {"# #", "###", "# #", "# #", "# #"}}},
+  {'N', {4, {"# #", "## #", "# ##", "#  #", "#  #"}}},
+  {'O', {3, {"###", "# #", "# #", "# #", "###"}}},
+  {'P', {3, {"###", "# #", "###", "#  ", "#  "}}},
+  {'Q', {4, {" ## ", "#  #", "#  #", "# ##", " ###"}}},
+  {'R', {3, {"###", "# #", "###", "## ", "# #"}}},
+  {'S', {4, {" ###", "#   ", " ###", "   #", "### "}}},
+  {'T', {3, {"###", " # ", " # ", " # ", " # "}}},
+  {'U', {3, {"# #", "# #", "# #", "# #", "###"}}},
+  {'V', {3, {"# #", "# #", "# #", "# #", " # "}}},
+  {'W', {3, {"# #", "# #", "# #", "###", "# #"}}},
+  {'X', {3, {"# #", "# #", " # ", "# #", "# #"}}},
+  {'Y', {3, {"# #", "# #", " # ", " # ", " # "}}},
+  {' ', {2, {"  ", "  ", "  ", "  ", "  "}}},
+  {'-', {3, {"   ", "   ", "###", "   ", "   "}}},
+  {'+', {3, {"   ", " # ", "###", " # ", "   "}}},
+  {'/', {4, {"   #", "  # ", "  # ", " #  ", "#   "}}},
+  {'|', {3, {" # ", " # ", " # ", " # ", " # "}}},
+  {':', {1, {" ", "#", " ", "#", " "}}},
+  {'(', {3, {" # ", "#  ","#  ", "#  ", " # "}}},
+  {')', {3, {" # ", "  #", "  #","  #", " # "}}},
+  {'?', {3, {"###", "  #", " ##", "   ", " # "}}},
+  {'%', {4, {"    ", "#  #", "  # ", " #  ", "#  #"}}},
+  {'.', {1, {" ", " ", " ", " ", "#"}}},
+};
+
+// 128-entry lookup; lower case maps to upper case, anything unknown to '?'
+constexpr std::array<Glyph, 128> buildGlyphTable() {
+  std::array<Glyph, 128> table{};
+  Glyph fallback{};
+  for (const GlyphDef &d : kGlyphDefs)
+    if (d.c == '?') fallback = d.glyph;
+  for (Glyph &g : table) g = fallback;
+  for (const GlyphDef &d : kGlyphDefs) {
+    table[static_cast<unsigned char>(d.c)] = d.glyph;
+    if (d.c >= 'A' && d.c <= 'Z') table[d.c - 'A' + 'a'] = d.glyph;
+  }
+  return table;
+}
+
+constexpr std::array<Glyph, 128> kGlyphTable = buildGlyphTable();
+
+} // namespace
+
 const Glyph &glyphFor(char c) {
-  static const std::unordered_map<char, Glyph> font = {
-    {'0', {3, {"###", "# #", "# #", "# #", "###"}}},
-    {'1', {3, {"  #", " ##", "  #", "  #", "  #"}}},
-    {'2', {3, {"###", "  #", "###", "#  ", "###"}}},
-    {'3', {3, {"###", "  #", " ##", "  #", "###"}}},
-    {'4', {3, {"# #", "# #", "###", "  #", "  #"}}},
-    {'5', {3, {"###", "#  ", "###", "  #", "###"}}},
-    {'6', {3, {"###", "#  ", "###", "# #", "###"}}},
-    {'7', {3, {"###", "  #", "  #", "  #", "  #"}}},
-    {'8', {3, {"###", "# #", "###", "# #", "###"}}},
-    {'9', {3, {"###", "# #", "###", "  #", "###"}}},
-    {'A', {3, {"###", "# #", "###", "# #", "# #"}}},
-    {'B', {3, {"## ", "# #", "## ", "# #", "## "}}},
-    {'C', {4, {" ###", "#   ", "#   ", "#   ", " ###"}}},
-    {'D', {3, {"## ", "# #", "# #", "# #", "## "}}},
-    {'E', {3, {"###", "#  ", "###", "#  ", "###"}}},
-    {'F', {3, {"###", "#  ", "###", "#  ", "#  "}}},
-    {'G', {4, {" ###", "#   ", "# ##", "#  #", " ###"}}},
-    {'H', {3, {"# #", "# #", "###", "# #", "# #"}}},
-    {'I', {3, {"###", " # ", " # ", " # ", "###"}}},
-    {'J', {3, {"###", "  #", "  #", "# #", "###"}}},
-    {'K', {3, {"# #", "# #", "## ", "# #", "# #"}}},
-    {'L', {3, {"#  ", "#  ", "#  ", "#  ", "###"}}},
-    {'M', {3, {"# #", "###", "# #", "# #", "# #"}}},
-    {'N', {4, {"# #", "## #", "# ##", "#  #", "#  #"}}},
-    {'O', {3, {"###", "# #", "# #", "# #", "###"}}},
-    {'P', {3, {"###", "# #", "###", "#  ", "#  "}}},
-    {'Q', {4, {" ## ", "#  #", "#  #", "# ##", " ###"}}},
-    {'R', {3, {"###", "# #", "###", "## ", "# #"}}},
-    {'S', {4, {" ###", "#   ", " ###", "   #", "### "}}},
-    {'T', {3, {"###", " # ", " # ", " # ", " # "}}},
-    {'U', {3, {"# #", "# #", "# #", "# #", "###"}}},
-    {'V', {3, {"# #", "# #", "# #", "# #", " # "}}},
-    {'W', {3, {"# #", "# #", "# #", "###", "# #"}}},
-    {'X', {3, {"# #", "# #", " # ", "# #", "# #"}}},
-    {'Y', {3, {"# #", "# #", " # ", " # ", " # "}}},
-    {' ', {2, {"  ", "  ", "  ", "  ", "  "}}},
-    {'-', {3, {"   ", "   ", "###", "   ", "   "}}},
-    {'+', {3, {"   ", " # ", "###", " # ", "   "}}},
-    {'/', {4, {"   #", "  # ", "  # ", " #  ", "#   "}}},
-    {'|', {3, {" # ", " # ", " # ", " # ", " # "}}},
-    {':', {1, {" ", "#", " ", "#", " "}}},
-    {'(', {3, {" # ", "#  ","#  ", "#  ", " # "}}},
-    {')', {3, {" # ", "  #", "  #","  #", " # "}}},
-    {'?', {3, {"###", "  #", " ##", "   ", " # "}}},
-    {'%', {4, {"    ", "#  #", "  # ", " #  ", "#  #"}}},
-  };
-
-  auto upper = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
-  auto it = font.find(upper);
-  if (it != font.end()) return it->second;
-  return font.at('?');
+  const unsigned char u = static_cast<unsigned char>(c);
+  return kGlyphTable[u < 128 ? u : '?'];
 }
 
 glm::vec2 measureText(const std::string &text, float scale) {
@@ -1,18 +1,52 @@
 #include "gfx/RenderCommand.h"
 #include "gfx/Render2D.h"
 
+#include <mutex>
+
 std::unique_ptr<RendererAPI> RenderCommand::s_API;
+thread_local RenderCommandList* RenderCommand::s_Recording = nullptr;
+
+// GPU timings as of the last executed frame boundary; read from any thread
+static std::mutex s_GpuMutex;
+static GpuTimings s_GpuTimings;
+
+static void snapshotGpuTimings(const RendererAPI& api) {
+    std::lock_guard<std::mutex> lock(s_GpuMutex);
+    s_GpuTimings = api.GetGpuTimings();
+}
 
 void RenderCommand::Init(std::unique_ptr<RendererAPI> api) {
     s_API = std::move(api);
-    if (s_API) s_API->Init();
+    if (s_API) {
+        s_API->Init();
+        snapshotGpuTimings(*s_API);
+    }
 
     Render2D::Initialize();
 }
 
 void RenderCommand::Shutdown(){ Render2D::Shutdown(); s_API.reset();}
-void RenderCommand::SetViewport(int x,int y,int w,int h) { s_API->SetViewport(x,y,w,h); }
-void RenderCommand::SetClearColor(float r,float g,float b,float a){ s_API->SetClearColor(r,g,b,a); }
-void RenderCommand::Clear(){ s_API->Clear(); }
-void RenderCommand::EnableBlend(bool e){ s_API->EnableBlend(e); }
-void RenderCommand::DrawIndexed(const IVertexArray& vao, std::uint32_t n){ s_API->DrawIndexed(vao, n); }
+void RenderCommand::SetViewport(int x,int y,int w,int h) { Enqueue([=]{ s_API->SetViewport(x,y,w,h); }); }
+void RenderCommand::SetClearColor(float r,float g,float b,float a){ Enqueue([=]{ s_API->SetClearColor(r,g,b,a); }); }
+void RenderCommand::Clear(){ Enqueue([]{ s_API->Clear(); }); }
+void RenderCommand::EnableBlend(bool e){ Enqueue([=]{ s_API->EnableBlend(e); }); }
+void RenderCommand::SetBlendMode(BlendMode m){ Enqueue([=]{ s_API->SetBlendMode(m); }); }
+void RenderCommand::DrawIndexed(const IVertexArray& vao, std::uint32_t n, IndexType type){
+    Enqueue([vao = &vao, n, type]{ s_API->DrawIndexed(*vao, n, type); });
+}
+void RenderCommand::DrawIndexedInstanced(const IVertexArray& vao, std::uint32_t n, std::uint32_t instances,
+                                         IndexType type){
+    Enqueue([vao = &vao, n, instances, type]{ s_API->DrawIndexedInstanced(*vao, n, instances, type); });
+}
+void RenderCommand::BeginGpuFrame(){
+    Enqueue([]{ if (s_API) { s_API->BeginGpuFrame(); snapshotGpuTimings(*s_API); } });
+}
+void RenderCommand::EndGpuFrame(){
+    Enqueue([]{ if (s_API) { s_API->EndGpuFrame(); snapshotGpuTimings(*s_API); } });
+}
+void RenderCommand::BeginGpuPass(){ Enqueue([]{ if (s_API) s_API->BeginGpuPass(); }); }
+void RenderCommand::EndGpuPass(){ Enqueue([]{ if (s_API) s_API->EndGpuPass(); }); }
+GpuTimings RenderCommand::GetGpuTimings(){
+    std::lock_guard<std::mutex> lock(s_GpuMutex);
+    return s_API ? s_GpuTimings : GpuTimings{};
+}
@@ -0,0 +1,37 @@
+#include "gfx/RenderCommandList.h"
+
+#include <algorithm>
+#include <cassert>
+
+void* RenderCommandList::Allocate(std::size_t bytes, std::size_t align) {
+  assert(align <= kMaxAlign && (align & (align - 1)) == 0);
+  for (;;) {
+    if (m_Block == m_Blocks.size()) {
+      // big payloads (a full batch of vertices) get a block of their own, kept like the rest
+      const std::size_t size = std::max(kBlockSize, bytes);
+      m_Blocks.push_back({ std::make_unique<std::byte[]>(size), size });
+    }
+    Block& block = m_Blocks[m_Block];
+    const std::size_t start = (m_Offset + align - 1) & ~(align - 1);
+    if (start + bytes <= block.Size) {
+      m_Offset = start + bytes;
+      m_Used += bytes;
+      return block.Data.get() + start;
+    }
+    // doesn't fit: the rest of this block stays unused this frame
+    ++m_Block;
+    m_Offset = 0;
+  }
+}
+
+void RenderCommandList::Execute() {
+  for (const Command& c : m_Commands) c.Run(c.Object);
+}
+
+void RenderCommandList::Reset() {
+  for (const Command& c : m_Commands) c.Destroy(c.Object);
+  m_Commands.clear();
+  m_Block = 0;
+  m_Offset = 0;
+  m_Used = 0;
+}
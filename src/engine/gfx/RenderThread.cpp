@@ -0,0 +1,106 @@
+#include "gfx/RenderThread.h"
+#include "window/IWindow.h"
+#include "core/Log.h"
+#include "core/Profiler.h"
+
+#include <chrono>
+
+RenderThread::RenderThread(IWindow& window) : m_Window(window) {}
+
+RenderThread::~RenderThread() { Stop(); }
+
+bool RenderThread::Start() {
+  if (IsRunning()) return true;
+
+  m_Quit = false;
+  m_ContextState = 0;
+  m_Window.ReleaseContext();
+  m_Thread = std::thread([this] { threadMain(); });
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_Cv.wait(lock, [this] { return m_ContextState != 0; });
+  if (m_ContextState > 0) return true;
+
+  lock.unlock();
+  m_Thread.join();
+  m_Window.MakeContextCurrent();
+  EN_CORE_WARN("[RenderThread] context could not move to the render thread");
+  return false;
+}
+
+void RenderThread::Stop() {
+  if (!IsRunning()) return;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Quit = true;
+  }
+  m_Cv.notify_all();
+  m_Thread.join();
+  m_Window.MakeContextCurrent();
+}
+
+void RenderThread::Submit() {
+  using clock = std::chrono::steady_clock;
+  const auto waitStart = clock::now();
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    EN_PROFILE_ZONE("RenderThread::waitFrame");
+    m_Cv.wait(lock, [this] { return m_Pending == nullptr; });
+    m_Pending = &m_Lists[m_RecordIndex];
+    m_Stats.LastCommands = (uint32_t)m_Pending->CommandCount();
+    m_Stats.LastBytes = (uint32_t)m_Pending->BytesUsed();
+    m_Stats.LastWaitMs = std::chrono::duration<float, std::milli>(clock::now() - waitStart).count();
+  }
+  m_Cv.notify_all();
+  // the other list finished executing before the wait above returned
+  m_RecordIndex ^= 1;
+}
+
+void RenderThread::WaitIdle() {
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_Cv.wait(lock, [this] { return m_Pending == nullptr; });
+}
+
+RenderThread::Stats RenderThread::GetStats() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Stats;
+}
+
+void RenderThread::threadMain() {
+  const bool current = m_Window.MakeContextCurrent();
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_ContextState = current ? 1 : -1;
+  }
+  m_Cv.notify_all();
+  if (!current) return;
+
+  using clock = std::chrono::steady_clock;
+  for (;;) {
+    RenderCommandList* list = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Cv.wait(lock, [this] { return m_Pending != nullptr || m_Quit; });
+      if (!m_Pending) break;   // quitting with nothing left
+      list = m_Pending;
+    }
+
+    const auto start = clock::now();
+    {
+      EN_PROFILE_ZONE("RenderThread::execute");
+      list->Execute();
+      list->Reset();   // drops the frame's texture references here, with the context
+    }
+    const float ms = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Pending = nullptr;
+      m_Stats.LastExecuteMs = ms;
+      ++m_Stats.Frames;
+    }
+    m_Cv.notify_all();
+  }
+
+  m_Window.ReleaseContext();
+}
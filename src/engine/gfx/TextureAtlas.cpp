@@ -0,0 +1,127 @@
+#include "gfx/TextureAtlas.h"
+#include "core/Factory.h"
+#include "core/Log.h"
+#include "gfx/Render2D.h"
+
+#include <stb_image.h>
+#include <cstring>
+
+static constexpr uint32_t kPad = 1; // border around each image, filled from its edges
+
+TextureAtlas::TextureAtlas(uint32_t pageWidth, uint32_t pageHeight)
+  : m_PageW(pageWidth), m_PageH(pageHeight) {}
+
+int TextureAtlas::AddFromFile(const std::string& path, bool flipY) {
+  stbi_set_flip_vertically_on_load(flipY ? 1 : 0);
+  int w, h, n;
+  unsigned char* data = stbi_load(path.c_str(), &w, &h, &n, 4);
+  if (!data) {
+    EN_CORE_ERROR("TextureAtlas failed to load {}", path);
+    return -1;
+  }
+  int id = Add((uint32_t)w, (uint32_t)h, data, false);
+  stbi_image_free(data);
+  if (id < 0) EN_CORE_ERROR("TextureAtlas: {} ({}x{}) does not fit a page", path, w, h);
+  return id;
+}
+
+int TextureAtlas::Add(uint32_t w, uint32_t h, const uint8_t* rgba, bool flipY) {
+  if (m_Built || !rgba || w == 0 || h == 0) return -1;
+
+  int pageIdx; uint32_t x, y;
+  if (!place(w + 2 * kPad, h + 2 * kPad, pageIdx, x, y)) return -1;
+  Page& page = m_Pages[pageIdx];
+  x += kPad; y += kPad;
+
+  // copy rows, then extrude the edges into the padding
+  const size_t stride = (size_t)m_PageW * 4;
+  for (uint32_t row = 0; row < h; ++row) {
+    const uint8_t* src = rgba + (size_t)(flipY ? h - 1 - row : row) * w * 4;
+    uint8_t* dst = page.pixels.data() + (y + row) * stride + (size_t)x * 4;
+    std::memcpy(dst, src, (size_t)w * 4);
+    std::memcpy(dst - 4, dst, 4);
+    std::memcpy(dst + (size_t)w * 4, dst + (size_t)(w - 1) * 4, 4);
+  }
+  uint8_t* first = page.pixels.data() + y * stride + (size_t)(x - 1) * 4;
+  uint8_t* last  = page.pixels.data() + (y + h - 1) * stride + (size_t)(x - 1) * 4;
+  std::memcpy(first - stride, first, (size_t)(w + 2) * 4);
+  std::memcpy(last + stride, last, (size_t)(w + 2) * 4);
+
+  m_Entries.push_back({pageIdx, x, y, w, h});
+  return (int)m_Entries.size() - 1;
+}
+
+bool TextureAtlas::place(uint32_t w, uint32_t h, int& pageIdx, uint32_t& x, uint32_t& y) {
+  if (w > m_PageW || h > m_PageH) return false;
+
+  // shelves: fill left to right, open a new shelf below when the row is full, and a new
+  // page when the shelf would run off the bottom. Only the last page is open.
+  if (!m_Pages.empty()) {
+    Page& p = m_Pages.back();
+    if (p.shelfX + w > m_PageW) {
+      p.shelfY += p.shelfH;
+      p.shelfX = 0;
+      p.shelfH = 0;
+    }
+    if (p.shelfY + h <= m_PageH) {
+      pageIdx = (int)m_Pages.size() - 1;
+      x = p.shelfX; y = p.shelfY;
+      p.shelfX += w;
+      p.shelfH = std::max(p.shelfH, h);
+      p.usedH = std::max(p.usedH, y + h);
+      return true;
+    }
+  }
+
+  Page p;
+  p.pixels.assign((size_t)m_PageW * m_PageH * 4, 0);
+  p.shelfX = w; p.shelfH = h; p.usedH = h;
+  p.texture = Factory::CreateTexture2D();
+  m_Pages.push_back(std::move(p));
+  pageIdx = (int)m_Pages.size() - 1;
+  x = 0; y = 0;
+  return true;
+}
+
+bool TextureAtlas::Build() {
+  if (m_Built) return true;
+
+  // array layers all have the page size, so nothing gets trimmed
+  const bool toArray = m_TextureArray && Render2D::AcceptsArrayLayer(m_PageW, m_PageH);
+  int fontId = -1;
+  if (toArray && !Render2D::HasArrayFont()) {
+    uint32_t fontW, fontH;
+    if (const uint32_t* font = Render2D::FontPixels(fontW, fontH))
+      fontId = Add(fontW, fontH, reinterpret_cast<const uint8_t*>(font));
+  }
+
+  bool ok = true;
+  for (Page& p : m_Pages) {
+    if (toArray) p.usedH = m_PageH;
+    // rows past usedH are empty; pixels is row-major so the prefix is the trimmed image
+    if (!p.texture || !p.texture->Create(m_PageW, p.usedH, 4, p.pixels.data())) {
+      EN_CORE_ERROR("TextureAtlas failed to upload a {}x{} page", m_PageW, p.usedH);
+      p.texture.reset();
+      ok = false;
+    } else if (toArray && !Render2D::AddArrayLayer(p.texture, p.pixels.data())) {
+      EN_CORE_WARN("TextureAtlas: texture array full, page stays on a texture slot");
+    }
+    std::vector<uint8_t>().swap(p.pixels);
+  }
+  m_Built = true;
+
+  if (fontId >= 0) Render2D::SetArrayFont(Get(fontId));
+  return ok;
+}
+
+Sprite TextureAtlas::Get(int id) const {
+  Sprite s;
+  if (!m_Built || id < 0 || id >= (int)m_Entries.size()) return s;
+  const Entry& e = m_Entries[id];
+  const Page& p = m_Pages[e.page];
+  s.Texture = p.texture;
+  s.UV = { (float)e.x / m_PageW, (float)e.y / p.usedH,
+           (float)(e.x + e.w) / m_PageW, (float)(e.y + e.h) / p.usedH };
+  s.Size = { (float)e.w, (float)e.h };
+  return s;
+}
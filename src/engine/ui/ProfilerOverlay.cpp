@@ -0,0 +1,126 @@
+#include "ui/ProfilerOverlay.h"
+
+#include "core/Profiler.h"
+#include "gfx/Render2D.h"
+#include "gfx/RenderCommand.h"
+#include "ui/UISystem.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+
+namespace ui {
+
+namespace {
+
+constexpr float kBudgetMs = 1000.0f / 60.0f;
+constexpr float kGraphMaxMs = 2.0f * kBudgetMs;
+constexpr size_t kMaxZoneLines = 12;
+
+// upper edges in ms; the last bucket takes everything above
+constexpr std::array<float, 6> kBucketEdges = {4.f, 8.f, 12.f, 16.7f, 33.3f, 1e9f};
+constexpr std::array<const char *, 6> kBucketLabels = {"  4", "  8", " 12", " 17",
+                                                       " 33", "33+"};
+
+glm::vec4 FrameColor(float ms) {
+  if (ms <= kBudgetMs) return {0.35f, 0.85f, 0.45f, 1.0f};
+  if (ms <= 2.0f * kBudgetMs) return {0.95f, 0.80f, 0.25f, 1.0f};
+  return {0.95f, 0.35f, 0.30f, 1.0f};
+}
+
+}  // namespace
+
+void DrawProfilerOverlay(glm::vec2 pos, float width) {
+  const Profiler::FrameSummary frames = Profiler::GetFrameSummary();
+  const std::vector<Profiler::Zone> zones = Profiler::LastFrameZones();
+
+  const float pad = 8.0f;
+  const float graphH = 48.0f;
+  const float histRowH = 8.0f;
+  const TextStyle text{2.0f, glm::vec4(0.92f, 0.95f, 0.95f, 1.0f)};
+  const float lineH = text.scale * 7.0f;
+
+  size_t zoneLines = 0;
+  for (const Profiler::Zone &z : zones)
+    if (z.Depth <= 2 && zoneLines < kMaxZoneLines) ++zoneLines;
+
+  const Render2D::Statistics stats = Render2D::GetStats();
+  const bool gpu = RenderCommand::GetGpuTimings().Supported;
+
+  const float height = pad + lineH * (gpu ? 2.0f : 1.0f) + graphH + pad +
+                       histRowH * (float)kBucketEdges.size() + pad +
+                       lineH * (float)zoneLines + pad;
+  Render2D::DrawQuad(pos, glm::vec2{width, height}, glm::vec4(0.02f, 0.03f, 0.04f, 0.82f));
+
+  // header: last / average / worst over the history
+  float last = 0.0f, sum = 0.0f, worst = 0.0f;
+  std::array<uint32_t, kBucketEdges.size()> buckets{};
+  for (size_t i = 0; i < frames.Count; ++i) {
+    const float ms = frames.FrameMs[i];
+    sum += ms;
+    worst = std::max(worst, ms);
+    size_t b = 0;
+    while (ms > kBucketEdges[b]) ++b;
+    ++buckets[b];
+  }
+  if (frames.Count > 0)
+    last = frames.FrameMs[(frames.Head + Profiler::FrameHistory - 1) % Profiler::FrameHistory];
+  const float avg = frames.Count ? sum / (float)frames.Count : 0.0f;
+
+  char buf[96];
+  std::snprintf(buf, sizeof(buf), "CPU %.1fMS  AVG %.1f  MAX %.1f", last, avg, worst);
+  float y = pos.y + pad;
+  DrawText(buf, glm::vec2{pos.x + pad, y}, text);
+  y += lineH;
+  if (gpu) {
+    std::snprintf(buf, sizeof(buf), "GPU %.1fMS  FLUSH %.1f X%u", stats.GpuFrameMs,
+                  stats.GpuFlushMs, stats.GpuFlushes);
+    DrawText(buf, glm::vec2{pos.x + pad, y}, text);
+    y += lineH;
+  }
+
+  // graph: newest frame on the right, the budget as a line
+  const float graphW = width - pad * 2.0f;
+  const float barW = graphW / (float)Profiler::FrameHistory;
+  const float graphBottom = y + graphH;
+  std::array<Render2D::SpriteDesc, Profiler::FrameHistory> bars;
+  for (size_t i = 0; i < frames.Count; ++i) {
+    const size_t age = frames.Count - 1 - i;
+    const size_t slot = (frames.Head + Profiler::FrameHistory - 1 - age) % Profiler::FrameHistory;
+    const float ms = frames.FrameMs[slot];
+    const float h = std::min(ms / kGraphMaxMs, 1.0f) * graphH;
+    const float x = pos.x + pad + graphW - (float)(age + 1) * barW;
+    bars[i] = {glm::vec2{x, graphBottom - h}, glm::vec2{barW, h}, 0.0f, FrameColor(ms), nullptr};
+  }
+  Render2D::DrawQuads({bars.data(), frames.Count});
+  Render2D::DrawQuad(glm::vec2{pos.x + pad, graphBottom - graphH * (kBudgetMs / kGraphMaxMs)},
+                     glm::vec2{graphW, 1.0f}, glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
+  y = graphBottom + pad;
+
+  // histogram
+  uint32_t most = 1;
+  for (uint32_t c : buckets) most = std::max(most, c);
+  const TextStyle small{1.2f, text.color};
+  const float labelW = 28.0f;
+  for (size_t b = 0; b < buckets.size(); ++b) {
+    DrawText(kBucketLabels[b], glm::vec2{pos.x + pad, y + 1.0f}, small);
+    const float w = (graphW - labelW) * (float)buckets[b] / (float)most;
+    Render2D::DrawQuad(glm::vec2{pos.x + pad + labelW, y + 1.0f}, glm::vec2{w, histRowH - 2.0f},
+                       FrameColor(b == 0 ? 0.0f : kBucketEdges[b - 1] + 0.01f));
+    y += histRowH;
+  }
+  y += pad;
+
+  // last frame's zones, indented by depth
+  size_t shown = 0;
+  for (const Profiler::Zone &z : zones) {
+    if (z.Depth > 2) continue;
+    if (shown++ >= kMaxZoneLines) break;
+    std::snprintf(buf, sizeof(buf), "%s %.2f", z.Name ? z.Name : "?",
+                  (double)(z.EndNs - z.StartNs) * 1e-6);
+    DrawText(buf, glm::vec2{pos.x + pad + 8.0f * z.Depth, y}, text);
+    y += lineH;
+  }
+}
+
+}  // namespace ui
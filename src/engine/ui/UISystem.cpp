@@ -3,6 +3,10 @@
 #include "gfx/Render2D.h"
 
 #include <algorithm>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
 
 namespace ui {
 
@@ -16,6 +20,66 @@ float LetterSpacing(const TextStyle &style) {
   return style.scale * style.letterSpacing;
 }
 
+struct CachedLayout {
+  float scale = 0.0f;
+  float letterSpacing = 0.0f;
+  float lineSpacing = 0.0f;
+  float maxWidth = 0.0f;
+  uint32_t lastUsed = 0;
+  std::unique_ptr<TextLayout> layout;  // stable address across rehash/growth
+};
+
+constexpr size_t kMaxCachedLayouts = 256;
+
+std::unordered_map<std::string, std::vector<CachedLayout>> s_LayoutCache;
+size_t s_CachedLayoutCount = 0;
+uint32_t s_LayoutFrame = 1;
+
+void BuildLayout(const std::string &text, const TextStyle &style,
+                 float maxWidth, TextLayout &out) {
+  if (maxWidth > 0.0f) {
+    out.lines = WrapText(text, style, maxWidth);
+  } else if (!text.empty()) {
+    size_t start = 0;
+    for (;;) {
+      size_t end = text.find('\n', start);
+      out.lines.push_back(text.substr(start, end - start));
+      if (end == std::string::npos) break;
+      start = end + 1;
+    }
+  }
+
+  const float spacing = LetterSpacing(style);
+  const float advance = LineAdvance(style);
+  float y = 0.0f;
+  for (const std::string &line : out.lines) {
+    float x = 0.0f;
+    bool lineHasGlyph = false;
+    for (char ch : line) {
+      if (lineHasGlyph) {
+        x += spacing;
+      }
+      Render2D::QuadInstance q;
+      if (Render2D::MakeGlyphQuad(glm::vec2{x, y}, style.scale, ch, q)) {
+        out.quads.push_back(q);
+      }
+      x += static_cast<float>(glyphFor(ch).width) * style.scale;
+      lineHasGlyph = true;
+    }
+    out.size.x = std::max(out.size.x, x);
+    y += advance;
+  }
+
+  if (maxWidth > 0.0f) {
+    if (!out.lines.empty()) {
+      out.size.y = style.scale * 5.0f +
+                   static_cast<float>(out.lines.size() - 1) * advance;
+    }
+  } else {
+    out.size = MeasureText(text, style);
+  }
+}
+
 }  // namespace
 
 glm::vec2 MeasureText(const std::string &text, float scale) {
@@ -63,40 +127,10 @@ glm::vec2 MeasureText(const std::string &text, const TextStyle &style) {
 }
 
 void DrawText(const std::string &text, glm::vec2 pos, const TextStyle &style) {
-  float x = pos.x;
-  float y = pos.y;
-  bool lineHasGlyph = false;
-  const float spacing = LetterSpacing(style);
-
-  for (char ch : text) {
-    if (ch == '\n') {
-      y += LineAdvance(style);
-      x = pos.x;
-      lineHasGlyph = false;
-      continue;
-    }
-
-    if (lineHasGlyph) {
-      x += spacing;
-    }
-
-    const Glyph &g = glyphFor(ch);
-    for (int row = 0; row < 5; ++row) {
-      const char *rowStr = g.rows[row];
-      for (int col = 0; col < g.width && rowStr[col] != '\0'; ++col) {
-        if (rowStr[col] == ' ' || rowStr[col] == '\0') {
-          continue;
-        }
-        glm::vec2 cellPos{x + static_cast<float>(col) * style.scale,
-                          y + static_cast<float>(row) * style.scale};
-        Render2D::DrawQuad(cellPos, glm::vec2{style.scale, style.scale},
-                           style.color);
-      }
-    }
-
-    x += static_cast<float>(g.width) * style.scale;
-    lineHasGlyph = true;
+  if (text.empty()) {
+    return;
   }
+  DrawTextLayout(LayoutText(text, style), pos, style.color);
 }
 
 void DrawText(const std::string &text, glm::vec2 pos, float scale,
@@ -135,12 +169,128 @@ void DrawButton(const Rect &rect, const std::string &label,
     textColor = style.hoveredTextColor;
   }
 
-  TextStyle textStyle = style.textStyle;
-  textStyle.color = textColor;
-  glm::vec2 metrics = MeasureText(label, textStyle);
-  float textX = rect.x + rect.w * 0.5f - metrics.x * 0.5f;
-  float textY = rect.y + rect.h * 0.5f - metrics.y * 0.5f;
-  DrawText(label, glm::vec2{textX, textY}, textStyle);
+  const TextLayout &layout = LayoutText(label, style.textStyle);
+  float textX = rect.x + rect.w * 0.5f - layout.size.x * 0.5f;
+  float textY = rect.y + rect.h * 0.5f - layout.size.y * 0.5f;
+  DrawTextLayout(layout, glm::vec2{textX, textY}, textColor);
+}
+
+std::vector<std::string> WrapText(const std::string &text, const TextStyle &style,
+                                  float maxWidth) {
+  std::vector<std::string> wrapped;
+  if (text.empty()) {
+    return wrapped;
+  }
+
+  std::stringstream ss(text);
+  std::string paragraph;
+  while (std::getline(ss, paragraph)) {
+    if (paragraph.empty()) {
+      wrapped.emplace_back();
+      continue;
+    }
+
+    std::istringstream words(paragraph);
+    std::string word;
+    std::string currentLine;
+    while (words >> word) {
+      std::string candidate =
+          currentLine.empty() ? word : currentLine + " " + word;
+      float width = MeasureText(candidate, style).x;
+      if (maxWidth <= 0.f || width <= maxWidth) {
+        currentLine = std::move(candidate);
+      } else {
+        if (!currentLine.empty()) {
+          wrapped.push_back(currentLine);
+        }
+        currentLine = word;
+      }
+    }
+
+    if (!currentLine.empty()) {
+      wrapped.push_back(currentLine);
+    } else if (wrapped.empty() || !wrapped.back().empty()) {
+      wrapped.emplace_back();
+    }
+  }
+
+  while (!wrapped.empty() && wrapped.back().empty()) {
+    wrapped.pop_back();
+  }
+  return wrapped;
+}
+
+const TextLayout &LayoutText(const std::string &text, const TextStyle &style,
+                             float maxWidth) {
+  if (maxWidth < 0.0f) {
+    maxWidth = 0.0f;
+  }
+
+  std::vector<CachedLayout> &entries = s_LayoutCache[text];
+  for (CachedLayout &entry : entries) {
+    if (entry.scale == style.scale &&
+        entry.letterSpacing == style.letterSpacing &&
+        entry.lineSpacing == style.lineSpacing && entry.maxWidth == maxWidth) {
+      entry.lastUsed = s_LayoutFrame;
+      return *entry.layout;
+    }
+  }
+
+  CachedLayout entry;
+  entry.scale = style.scale;
+  entry.letterSpacing = style.letterSpacing;
+  entry.lineSpacing = style.lineSpacing;
+  entry.maxWidth = maxWidth;
+  entry.lastUsed = s_LayoutFrame;
+  entry.layout = std::make_unique<TextLayout>();
+  BuildLayout(text, style, maxWidth, *entry.layout);
+  entries.push_back(std::move(entry));
+  ++s_CachedLayoutCount;
+  return *entries.back().layout;
+}
+
+void DrawTextLayout(const TextLayout &layout, glm::vec2 pos,
+                    const glm::vec4 &color) {
+  if (layout.quads.empty()) {
+    return;
+  }
+  Render2D::DrawGlyphQuads(layout.quads.data(), layout.quads.size(), pos, color);
+}
+
+void TrimTextLayoutCache() {
+  const uint32_t frame = s_LayoutFrame++;
+  if (s_CachedLayoutCount <= kMaxCachedLayouts) {
+    return;
+  }
+
+  for (auto it = s_LayoutCache.begin(); it != s_LayoutCache.end();) {
+    std::vector<CachedLayout> &entries = it->second;
+    const size_t before = entries.size();
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [frame](const CachedLayout &entry) {
+                                   return entry.lastUsed != frame;
+                                 }),
+                  entries.end());
+    s_CachedLayoutCount -= before - entries.size();
+    it = entries.empty() ? s_LayoutCache.erase(it) : std::next(it);
+  }
+}
+
+void ClearTextLayoutCache() {
+  s_LayoutCache.clear();
+  s_CachedLayoutCount = 0;
+}
+
+NumberLabel::NumberLabel(std::string prefix, std::string suffix)
+    : m_Prefix(std::move(prefix)), m_Suffix(std::move(suffix)) {}
+
+const std::string &NumberLabel::Text(int value) {
+  if (!m_Valid || value != m_Value) {
+    m_Text = m_Prefix + std::to_string(value) + m_Suffix;
+    m_Value = value;
+    m_Valid = true;
+  }
+  return m_Text;
 }
 
 }  // namespace ui
@@ -1,28 +1,169 @@
 #pragma message("Compiling GLBuffer.cpp")
 #include "gfx/glad/GLBuffer.h"
+#include "gfx/glad/GLStateCache.h"
 #include "glad/glad.h"
 
+#include <cstring>
+
 GLBuffer::GLBuffer(BufferType t):m_Type(t){ glGenBuffers(1,&m_Id); }
-GLBuffer::~GLBuffer(){ if(m_Id) glDeleteBuffers(1,&m_Id); }
+GLBuffer::~GLBuffer(){ releaseStreaming(); if(m_Id){ GLStateCache::ForgetBuffer(m_Id); glDeleteBuffers(1,&m_Id); } }
+
+unsigned int GLBuffer::target() const {
+    return m_Type==BufferType::Vertex ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER;
+}
 
 void GLBuffer::Bind() const {
-    glBindBuffer(m_Type==BufferType::Vertex ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER, m_Id);
+    GLStateCache::BindBuffer(target(), m_Id);
 }
 void GLBuffer::Unbind() const {
-    glBindBuffer(m_Type==BufferType::Vertex ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER, 0);
+    GLStateCache::BindBuffer(target(), 0);
+}
+
+void GLBuffer::recreate() {
+    GLStateCache::ForgetBuffer(m_Id);
+    glDeleteBuffers(1,&m_Id); glGenBuffers(1,&m_Id);
 }
 void GLBuffer::SetData(const void* data,std::size_t bytes,bool dynamic){
+    if (m_Mode != StreamMode::Auto) {
+        // immutable (persistent) storage can't be respecified; start from a fresh name
+        releaseStreaming();
+        recreate();
+        m_Mode = StreamMode::Auto;
+    }
     Bind();
-    glBufferData(m_Type==BufferType::Vertex ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER,
-                 (GLsizeiptr)bytes, data, dynamic?GL_DYNAMIC_DRAW:GL_STATIC_DRAW);
+    glBufferData(target(), (GLsizeiptr)bytes, data, dynamic?GL_DYNAMIC_DRAW:GL_STATIC_DRAW);
 }
 
 void GLBuffer::UpdateSubData(std::size_t off, const void* data, std::size_t bytes) {
     Bind();
     glBufferSubData(
-        m_Type == BufferType::Vertex ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER,
+        target(),
         (GLintptr)off,
         (GLsizeiptr)bytes,
         data
     );
-}
\ No newline at end of file
+}
+
+// ---------- streaming
+
+void GLBuffer::releaseStreaming() {
+    for (GLsync& f : m_Fences) {
+        if (f) { glDeleteSync(f); f = nullptr; }
+    }
+    if (m_Mapped) {
+        Bind();
+        glUnmapBuffer(target());
+        m_Mapped = nullptr;
+    }
+}
+
+void GLBuffer::InitStreaming(std::size_t capacity, StreamMode mode) {
+    releaseStreaming();
+    if (mode == StreamMode::Auto) {
+#ifdef __EMSCRIPTEN__
+        mode = StreamMode::Orphan;  // WebGL can't map buffers
+#else
+        if (GLAD_GL_VERSION_4_4) mode = StreamMode::Persistent;
+        else if (glad_glFenceSync && glad_glMapBufferRange) mode = StreamMode::Ring;
+        else mode = StreamMode::Orphan;
+#endif
+    }
+
+    recreate();
+    m_Capacity = capacity;
+    m_Cursor = 0;
+    m_Segment = 0;
+    m_Mode = mode;
+    Bind();
+
+    if (mode == StreamMode::Persistent) allocPersistent();
+    else glBufferData(target(), (GLsizeiptr)capacity, nullptr, GL_STREAM_DRAW);
+}
+
+void GLBuffer::allocPersistent() {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(target(), (GLsizeiptr)m_Capacity, nullptr, flags);
+    m_Mapped = glMapBufferRange(target(), 0, (GLsizeiptr)m_Capacity, flags);
+    if (m_Mapped) return;
+    // driver refused the mapping; fall back to a regular fenced ring
+    recreate();
+    m_Mode = StreamMode::Ring;
+    Bind();
+    glBufferData(target(), (GLsizeiptr)m_Capacity, nullptr, GL_STREAM_DRAW);
+}
+
+void GLBuffer::orphan() {
+    // the old storage stays alive until the draws using it finish; we get a new block
+    if (m_Mode == StreamMode::Persistent) {
+        // immutable storage can't be respecified: map a fresh buffer name instead
+        glUnmapBuffer(target());
+        m_Mapped = nullptr;
+        recreate();
+        Bind();
+        allocPersistent();
+    } else {
+        glBufferData(target(), (GLsizeiptr)m_Capacity, nullptr, GL_STREAM_DRAW);
+    }
+    for (GLsync& f : m_Fences) {
+        if (f) { glDeleteSync(f); f = nullptr; }
+    }
+    m_Stats.Orphans++;
+}
+
+void GLBuffer::nextSegment() {
+    // every draw reading the segment we leave has been issued by now
+    if (m_Fences[m_Segment]) glDeleteSync(m_Fences[m_Segment]);
+    m_Fences[m_Segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_Segment = (m_Segment + 1) % kSegments;
+
+    GLsync& fence = m_Fences[m_Segment];
+    if (!fence) return;
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED) {
+        m_Stats.Stalls++;
+        orphan(); // cheaper than waiting
+        return;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+std::size_t GLBuffer::Stream(const void* data, std::size_t bytes) {
+    if (m_Mode == StreamMode::Auto)
+        InitStreaming(bytes * kSegments * 2);
+
+    const std::size_t segSize = m_Capacity / kSegments;
+    if (bytes > segSize)
+        InitStreaming(bytes * kSegments * 2, m_Mode);
+
+    Bind();
+    std::size_t off = (m_Cursor + 15) & ~(std::size_t)15; // keep attribute offsets aligned
+    if (m_Mode == StreamMode::Orphan) {
+        if (off + bytes > m_Capacity) { orphan(); off = 0; }
+    } else if (off + bytes > (std::size_t)(m_Segment + 1) * segSize) {
+        nextSegment();
+        off = (std::size_t)m_Segment * segSize;
+    }
+
+    if (m_Mapped) {
+        std::memcpy((char*)m_Mapped + off, data, bytes);
+    } else {
+#ifdef __EMSCRIPTEN__
+        glBufferSubData(target(), (GLintptr)off, (GLsizeiptr)bytes, data);
+#else
+        // nothing in flight reads [off, off+bytes): the ring/orphaning guarantees it
+        void* dst = glMapBufferRange(target(), (GLintptr)off, (GLsizeiptr)bytes,
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (dst) {
+            std::memcpy(dst, data, bytes);
+            glUnmapBuffer(target());
+        } else {
+            glBufferSubData(target(), (GLintptr)off, (GLsizeiptr)bytes, data);
+        }
+#endif
+    }
+
+    m_Cursor = off + bytes;
+    m_Stats.Bytes += bytes;
+    return off;
+}
@@ -1,4 +1,6 @@
 #include "gfx/glad/GLDevice.h"
+#include "gfx/glad/GLProgramCache.h"
+#include "gfx/glad/GLStateCache.h"
 #include "window/IWindow.h"
 #include "gfx/RenderCommand.h"
 #include "core/Factory.h"
@@ -8,8 +10,13 @@
 // GLAD
 #include "glad/glad.h"
 
+#include <algorithm>
+#include <cstring>
+
 GLDevice::GLDevice(const FactoryDesc& desc){
-  
+  if (desc.shaderCache)
+    m_ShaderCacheDir = desc.shaderCacheDir.empty() ? GLProgramCache::DefaultDirectory()
+                                                   : desc.shaderCacheDir;
 }
 
 bool GLDevice::Initialize(IWindow &window){
@@ -38,6 +45,9 @@ bool GLDevice::Initialize(IWindow &window){
   EN_CORE_INFO("[OpenGL] Renderer: {}", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
   EN_CORE_INFO("[OpenGL] Version:  {}", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
 
+  // before any shader is built
+  GLProgramCache::Init(m_ShaderCacheDir, loader);
+
   // Basic GL state
   glDisable(GL_DEPTH_TEST);
   glDisable(GL_CULL_FACE);
@@ -45,12 +55,75 @@ bool GLDevice::Initialize(IWindow &window){
   // Enable/disable vsync on the active context
   m_Window->SetSwapInterval(m_Window->IsVsyncEnabled() ? 1 : 0);
 
+  if (!m_Window->HasDefaultFramebuffer()) {
+    auto [fbW, fbH] = m_Window->GetFramebufferSize();
+    if (!ensureTarget((int)fbW, (int)fbH)) return false;
+  }
+
   m_Initialized = true;
   return true;
 }
 
+GLDevice::~GLDevice() {
+  if (m_TargetFbo) {
+    GLStateCache::ForgetFramebuffer(m_TargetFbo);
+    glDeleteFramebuffers(1, &m_TargetFbo);
+  }
+  if (m_TargetColor) glDeleteRenderbuffers(1, &m_TargetColor);
+}
+
+bool GLDevice::ensureTarget(int width, int height) {
+  width = std::max(width, 1);
+  height = std::max(height, 1);
+  if (m_TargetFbo && width == m_TargetW && height == m_TargetH) return true;
+
+  if (!m_TargetFbo) {
+    glGenFramebuffers(1, &m_TargetFbo);
+    glGenRenderbuffers(1, &m_TargetColor);
+  }
+  glBindRenderbuffer(GL_RENDERBUFFER, m_TargetColor);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+  GLStateCache::BindFramebuffer(m_TargetFbo);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_TargetColor);
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    EN_CORE_ERROR("Offscreen target {}x{} incomplete.", width, height);
+    return false;
+  }
+  // stays bound; render targets put back whatever was bound when they began
+  m_TargetW = width;
+  m_TargetH = height;
+  return true;
+}
+
+bool GLDevice::ReadPixels(std::vector<uint8_t>& rgba, int& width, int& height) {
+  // a window's back buffer is undefined after the swap; only the offscreen target keeps
+  // the finished frame
+  if (!m_Initialized || !m_TargetFbo) return false;
+  width = m_TargetW;
+  height = m_TargetH;
+  if (width <= 0 || height <= 0) return false;
+  GLStateCache::BindFramebuffer(m_TargetFbo);
+
+  const size_t stride = (size_t)width * 4;
+  rgba.resize(stride * (size_t)height);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+
+  // GL rows start at the bottom
+  std::vector<uint8_t> row(stride);
+  for (int y = 0; y < height / 2; ++y) {
+    uint8_t* a = rgba.data() + (size_t)y * stride;
+    uint8_t* b = rgba.data() + (size_t)(height - 1 - y) * stride;
+    std::memcpy(row.data(), a, stride);
+    std::memcpy(a, b, stride);
+    std::memcpy(b, row.data(), stride);
+  }
+  return glGetError() == GL_NO_ERROR;
+}
+
 void GLDevice::BeginFrame(int fbWidth, int fbHeight) {
   if (!m_Initialized) return;
+  if (m_TargetFbo && !ensureTarget(fbWidth, fbHeight)) return;
 
   // Get logical size (your IWindow already exposes it)
   auto [lw, lh] = m_Window->GetLogicalSize();
@@ -67,9 +140,11 @@ void GLDevice::BeginFrame(int fbWidth, int fbHeight) {
   const int vpY = (fbHeight - vpH) / 2;
 
   RenderCommand::SetViewport(vpX, vpY, vpW, vpH);
+  RenderCommand::BeginGpuFrame();
 }
 
 void GLDevice::EndFrame() {
     if (!m_Initialized) return;
+    RenderCommand::EndGpuFrame();
     m_Window->SwapBuffers(); // GLFW path swaps; others may be no-op or custom
 }
@@ -0,0 +1,241 @@
+#include "gfx/glad/GLProgramCache.h"
+#include "core/Log.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+namespace {
+
+using GetProgramBinaryFn  = void (APIENTRYP)(GLuint, GLsizei, GLsizei*, GLenum*, void*);
+using ProgramBinaryFn     = void (APIENTRYP)(GLuint, GLenum, const void*, GLsizei);
+using ProgramParameteriFn = void (APIENTRYP)(GLuint, GLenum, GLint);
+using MaxCompilerThreadsFn = void (APIENTRYP)(GLuint);
+
+GetProgramBinaryFn  s_GetProgramBinary  = nullptr;
+ProgramBinaryFn     s_ProgramBinary     = nullptr;
+ProgramParameteriFn s_ProgramParameteri = nullptr;
+bool                s_Parallel          = false;
+
+std::filesystem::path s_Directory;     // empty: disk cache off
+uint64_t              s_DriverHash = 0;
+GLProgramCache::Stats s_Stats;
+
+constexpr uint32_t kMagic   = 0x4342504B;   // "KPBC"
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+    uint32_t Magic;
+    uint32_t Version;
+    uint64_t SourceHash;
+    uint64_t DriverHash;
+    uint32_t Format;       // binaryFormat from glGetProgramBinary
+    uint32_t Size;
+};
+
+uint64_t fnv1a(uint64_t h, const void* data, size_t size) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) h = (h ^ p[i]) * 0x100000001b3ull;
+    return h;
+}
+constexpr uint64_t kFnvBasis = 0xcbf29ce484222325ull;
+
+bool hasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, (GLuint)i));
+        if (ext && std::strcmp(ext, name) == 0) return true;
+    }
+    return false;
+}
+
+std::string glString(GLenum name) {
+    const char* s = reinterpret_cast<const char*>(glGetString(name));
+    return s ? s : "";
+}
+
+std::filesystem::path entryPath(uint64_t sourceHash) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin",
+                  (unsigned long long)fnv1a(s_DriverHash, &sourceHash, sizeof(sourceHash)));
+    return s_Directory / name;
+}
+
+void dropEntry(const std::filesystem::path& path) {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    ++s_Stats.Rejected;
+}
+
+}  // namespace
+
+void GLProgramCache::Init(const std::string& directory, GLProc loader) {
+    s_Stats = {};
+    s_Directory.clear();
+
+    // core in 4.1 / GLES 3.0, otherwise ARB_get_program_binary (same entry points)
+    s_GetProgramBinary  = (GetProgramBinaryFn)loader("glGetProgramBinary");
+    s_ProgramBinary     = (ProgramBinaryFn)loader("glProgramBinary");
+    s_ProgramParameteri = (ProgramParameteriFn)loader("glProgramParameteri");
+    const bool binaries = (GLAD_GL_VERSION_4_1 || hasExtension("GL_ARB_get_program_binary")) &&
+                          s_GetProgramBinary && s_ProgramBinary && s_ProgramParameteri;
+    GLint formats = 0;
+    if (binaries) glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    MaxCompilerThreadsFn maxThreads = nullptr;
+    if (hasExtension("GL_KHR_parallel_shader_compile"))
+        maxThreads = (MaxCompilerThreadsFn)loader("glMaxShaderCompilerThreadsKHR");
+    else if (hasExtension("GL_ARB_parallel_shader_compile"))
+        maxThreads = (MaxCompilerThreadsFn)loader("glMaxShaderCompilerThreadsARB");
+    s_Parallel = maxThreads != nullptr;
+    if (maxThreads) maxThreads(0xFFFFFFFFu);   // as many as the driver likes
+
+    const std::string driver =
+        glString(GL_VENDOR) + '\n' + glString(GL_RENDERER) + '\n' + glString(GL_VERSION);
+    s_DriverHash = fnv1a(kFnvBasis, driver.data(), driver.size());
+
+    if (formats > 0 && !directory.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (!ec) s_Directory = directory;
+        else EN_CORE_WARN("[OpenGL] shader cache dir '{}' unusable: {}", directory, ec.message());
+    }
+    EN_CORE_INFO("[OpenGL] program binary cache: {}, parallel shader compile: {}",
+                 s_Directory.empty() ? std::string("off") : s_Directory.string(),
+                 s_Parallel ? "on" : "unavailable");
+}
+
+std::string GLProgramCache::DefaultDirectory() {
+#if defined(__EMSCRIPTEN__) || defined(__ANDROID__)
+    return {};
+#elif defined(_WIN32)
+    const char* local = std::getenv("LOCALAPPDATA");
+    return local ? std::string(local) + "\\Kasino\\ShaderCache" : std::string();
+#else
+    const char* home = std::getenv("HOME");
+  #if defined(__APPLE__)
+    return home ? std::string(home) + "/Library/Caches/Kasino/shaders" : std::string();
+  #else
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg)
+        return std::string(xdg) + "/kasino/shaders";
+    return home ? std::string(home) + "/.cache/kasino/shaders" : std::string();
+  #endif
+#endif
+}
+
+uint64_t GLProgramCache::HashSources(const std::unordered_map<GLenum, std::string>& sources) {
+    std::vector<std::pair<GLenum, std::string_view>> stages(sources.begin(), sources.end());
+    std::sort(stages.begin(), stages.end());
+    uint64_t h = kFnvBasis;
+    for (const auto& [type, text] : stages) {
+        h = fnv1a(h, &type, sizeof(type));
+        h = fnv1a(h, text.data(), text.size());
+    }
+    return h;
+}
+
+GLuint GLProgramCache::Load(uint64_t sourceHash) {
+    if (s_Directory.empty()) return 0;
+
+    const std::filesystem::path path = entryPath(sourceHash);
+    std::FILE* f = std::fopen(path.string().c_str(), "rb");
+    if (!f) {
+        ++s_Stats.Misses;
+        return 0;
+    }
+    FileHeader header{};
+    std::vector<char> binary;
+    bool ok = std::fread(&header, sizeof(header), 1, f) == 1 && header.Magic == kMagic &&
+              header.Version == kVersion && header.SourceHash == sourceHash &&
+              header.DriverHash == s_DriverHash && header.Size > 0;
+    if (ok) {
+        binary.resize(header.Size);
+        ok = std::fread(binary.data(), 1, binary.size(), f) == binary.size();
+    }
+    std::fclose(f);
+    if (!ok) {
+        dropEntry(path);
+        ++s_Stats.Misses;
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    s_ProgramBinary(program, header.Format, binary.data(), (GLsizei)binary.size());
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // the driver changed in a way the version string didn't show
+        glDeleteProgram(program);
+        dropEntry(path);
+        ++s_Stats.Misses;
+        return 0;
+    }
+    ++s_Stats.Hits;
+    return program;
+}
+
+void GLProgramCache::PrepareProgram(GLuint program) {
+    if (!s_Directory.empty())
+        s_ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void GLProgramCache::Store(GLuint program, uint64_t sourceHash) {
+    if (s_Directory.empty()) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    std::vector<char> binary((size_t)length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    s_GetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    const FileHeader header{ kMagic, kVersion, sourceHash, s_DriverHash, format, (uint32_t)written };
+    const std::filesystem::path path = entryPath(sourceHash);
+    // written aside under a name no other call or instance uses, then renamed over the
+    // entry: a crash or a second instance storing the same program never leaves half a file
+    std::random_device random;
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%08x%08x.tmp", (unsigned)random(), (unsigned)random());
+    std::filesystem::path tmp = path;
+    tmp += suffix;
+
+    std::FILE* f = std::fopen(tmp.string().c_str(), "wb");
+    if (!f) return;
+    bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1 &&
+              std::fwrite(binary.data(), 1, (size_t)written, f) == (size_t)written;
+    ok = std::fclose(f) == 0 && ok;
+    std::error_code ec;
+    if (ok) std::filesystem::rename(tmp, path, ec);
+    if (!ok || ec) {
+        std::filesystem::remove(tmp, ec);
+        EN_CORE_WARN("[OpenGL] could not write shader cache entry {}", path.string());
+        return;
+    }
+    ++s_Stats.Stores;
+}
+
+bool GLProgramCache::ParallelCompile() { return s_Parallel; }
+
+bool GLProgramCache::IsComplete(GLuint program) {
+    if (!s_Parallel) return true;
+    GLint done = GL_FALSE;
+    glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &done);
+    return done == GL_TRUE;
+}
+
+GLProgramCache::Stats GLProgramCache::GetStats() { return s_Stats; }
@@ -0,0 +1,54 @@
+#include "gfx/glad/GLRenderTarget.h"
+#include "gfx/glad/GLStateCache.h"
+#include "gfx/glad/GLTexture2D.h"
+#include "glad/glad.h"
+#include "core/Log.h"
+
+namespace {
+
+// the bound framebuffer, keeping the frame's clear color
+void clearTransparent() {
+    GLfloat color[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, color);
+    glClearColor(0.f, 0.f, 0.f, 0.f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glClearColor(color[0], color[1], color[2], color[3]);
+}
+
+}  // namespace
+
+GLRenderTarget::GLRenderTarget() : m_Texture(CreateRef<GLTexture2D>()) { glGenFramebuffers(1, &m_Fbo); }
+
+GLRenderTarget::~GLRenderTarget() {
+    if (m_Fbo) {
+        GLStateCache::ForgetFramebuffer(m_Fbo);
+        glDeleteFramebuffers(1, &m_Fbo);
+    }
+}
+
+bool GLRenderTarget::Create(uint32_t width, uint32_t height) {
+    if (!m_Texture->Create(width, height, 4, nullptr)) return false;
+
+    const GLuint prev = GLStateCache::CurrentFramebuffer();
+    GLStateCache::BindFramebuffer(m_Fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           static_cast<GLTexture2D&>(*m_Texture).id(), 0);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (complete) clearTransparent();
+    GLStateCache::BindFramebuffer(prev);
+    if (!complete) EN_CORE_ERROR("Render target {}x{} incomplete.", width, height);
+    return complete;
+}
+
+void GLRenderTarget::Begin(bool clear) {
+    m_PrevFbo = GLStateCache::CurrentFramebuffer();
+    glGetIntegerv(GL_VIEWPORT, m_PrevViewport);
+    GLStateCache::BindFramebuffer(m_Fbo);
+    glViewport(0, 0, (GLsizei)Width(), (GLsizei)Height());
+    if (clear) clearTransparent();
+}
+
+void GLRenderTarget::End() {
+    GLStateCache::BindFramebuffer(m_PrevFbo);
+    glViewport(m_PrevViewport[0], m_PrevViewport[1], m_PrevViewport[2], m_PrevViewport[3]);
+}
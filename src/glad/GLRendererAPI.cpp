@@ -1,16 +1,119 @@
 #include "gfx/glad/GLRendererAPI.h"
 #include "glad/glad.h"
+#include "gfx/glad/GLStateCache.h"
 #include "gfx/IVertexArray.h"
+#include "core/Log.h"
+
+GLRendererAPI::~GLRendererAPI() {
+    for (TimerFrame& f : m_TimerFrames)
+        if (!f.Queries.empty()) glDeleteQueries((GLsizei)f.Queries.size(), f.Queries.data());
+}
 
 void GLRendererAPI::Init() {
     glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::Invalidate();
+    SetBlendMode(BlendMode::Alpha);
+
+#ifdef __EMSCRIPTEN__
+    // WebGL2's EXT_disjoint_timer_query_webgl2 has no timestamps
+    m_GpuTimings.Supported = false;
+#else
+    // timestamps are core since 3.3 (ARB_timer_query); GLES contexts lack them
+    m_GpuTimings.Supported = GLAD_GL_VERSION_3_3 && glad_glQueryCounter && glad_glGetQueryObjectui64v;
+#endif
+    EN_CORE_INFO("[OpenGL] GPU timer queries: {}", m_GpuTimings.Supported ? "on" : "unavailable");
 }
 void GLRendererAPI::SetViewport(int x,int y,int w,int h){ glViewport(x,y,w,h); }
 void GLRendererAPI::SetClearColor(float r,float g,float b,float a){ glClearColor(r,g,b,a); }
 void GLRendererAPI::Clear(){ glClear(GL_COLOR_BUFFER_BIT); }
-void GLRendererAPI::EnableBlend(bool enable){ if(enable) glEnable(GL_BLEND); else glDisable(GL_BLEND); }
-void GLRendererAPI::DrawIndexed(const IVertexArray& /*vao*/, std::uint32_t count){
-    glDrawElements(GL_TRIANGLES, (GLsizei)count, GL_UNSIGNED_INT, (const void*)0);
+void GLRendererAPI::EnableBlend(bool enable){ GLStateCache::SetBlend(enable); }
+void GLRendererAPI::SetBlendMode(BlendMode mode){
+    switch (mode) {
+    case BlendMode::Alpha:
+        GLStateCache::SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        break;
+    case BlendMode::Additive:      GLStateCache::SetBlend(true, GL_SRC_ALPHA, GL_ONE); break;
+    case BlendMode::Premultiplied: GLStateCache::SetBlend(true, GL_ONE, GL_ONE_MINUS_SRC_ALPHA); break;
+    case BlendMode::None:          GLStateCache::SetBlend(false); break;
+    }
+}
+static GLenum glIndexType(IndexType type){
+    return type == IndexType::U16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+void GLRendererAPI::DrawIndexed(const IVertexArray& /*vao*/, std::uint32_t count, IndexType type){
+    glDrawElements(GL_TRIANGLES, (GLsizei)count, glIndexType(type), (const void*)0);
+}
+void GLRendererAPI::DrawIndexedInstanced(const IVertexArray& /*vao*/, std::uint32_t count, std::uint32_t instances,
+                                         IndexType type){
+    glDrawElementsInstanced(GL_TRIANGLES, (GLsizei)count, glIndexType(type), (const void*)0, (GLsizei)instances);
+}
+
+// ==================== GPU timers ====================
+
+unsigned int GLRendererAPI::timestamp(TimerFrame& f) {
+    if (f.Used == f.Queries.size()) {
+        const std::size_t grow = f.Queries.empty() ? 8 : f.Queries.size();
+        f.Queries.resize(f.Queries.size() + grow);
+        glGenQueries((GLsizei)grow, f.Queries.data() + f.Used);
+    }
+    const GLuint q = f.Queries[f.Used++];
+    glQueryCounter(q, GL_TIMESTAMP);
+    return q;
+}
+
+void GLRendererAPI::resolve(TimerFrame& f) {
+    f.Pending = false;
+    // frame end is issued last; once it is back, every earlier stamp is too
+    GLint ready = 0;
+    glGetQueryObjectiv(f.Queries[1], GL_QUERY_RESULT_AVAILABLE, &ready);
+    if (!ready) { ++m_GpuTimings.Dropped; return; }
+
+    auto read = [&](std::uint32_t i) {
+        GLuint64 t = 0;
+        glGetQueryObjectui64v(f.Queries[i], GL_QUERY_RESULT, &t);
+        return t;
+    };
+    const GLuint64 frameBegin = read(0);
+    const GLuint64 frameEnd = read(1);
+    GLuint64 passNs = 0;
+    for (std::uint32_t i = 2; i + 1 < f.Used; i += 2) passNs += read(i + 1) - read(i);
+
+    m_GpuTimings.FrameMs = (float)(frameEnd - frameBegin) * 1e-6f;
+    m_GpuTimings.PassMs = (float)passNs * 1e-6f;
+    m_GpuTimings.Passes = (f.Used - 2) / 2;
+}
+
+void GLRendererAPI::BeginGpuFrame() {
+    if (!m_GpuTimings.Supported || m_InGpuFrame) return;
+    m_TimerFrame = (m_TimerFrame + 1) % kTimerFrames;
+    TimerFrame& f = m_TimerFrames[m_TimerFrame];
+    if (f.Pending) resolve(f);   // the oldest frame in the ring, kTimerFrames - 1 back
+
+    f.Used = 0;
+    timestamp(f);
+    f.Used = 2;                  // [1] is written by EndGpuFrame
+    m_InGpuFrame = true;
+}
+
+void GLRendererAPI::EndGpuFrame() {
+    if (!m_InGpuFrame) return;
+    if (m_InGpuPass) EndGpuPass();
+    TimerFrame& f = m_TimerFrames[m_TimerFrame];
+    glQueryCounter(f.Queries[1], GL_TIMESTAMP);
+    f.Pending = true;
+    m_InGpuFrame = false;
+}
+
+void GLRendererAPI::BeginGpuPass() {
+    if (!m_InGpuFrame || m_InGpuPass) return;
+    TimerFrame& f = m_TimerFrames[m_TimerFrame];
+    if ((f.Used - 2) / 2 >= kMaxPasses) return;
+    timestamp(f);
+    m_InGpuPass = true;
+}
+
+void GLRendererAPI::EndGpuPass() {
+    if (!m_InGpuPass) return;
+    timestamp(m_TimerFrames[m_TimerFrame]);
+    m_InGpuPass = false;
 }
@@ -1,9 +1,12 @@
 #include "gfx/glad/GLShader.h"
 #include "core/Log.h"
+#include "gfx/glad/GLStateCache.h"
+#include "gfx/glad/GLProgramCache.h"
 
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <cctype>
+#include <cstring>
 #include <fstream>
 #include <array>
 #include <vector>
@@ -19,34 +22,22 @@ static GLenum ShaderTypeFromString(const std::string& type)
   return 0;
 }
 
-static bool compile(GLuint sh, const char* src, std::string* log){
-  glShaderSource(sh, 1, &src, nullptr);
-  glCompileShader(sh);
-  GLint ok = 0;
-  glGetShaderiv(sh, GL_COMPILE_STATUS, &ok);
-
-  if (!ok) {
-    GLint len = 0;
-    glGetShaderiv(sh, GL_INFO_LOG_LENGTH, &len);
-    std::vector<char> buf(len + 1);
-    glGetShaderInfoLog(sh, len, nullptr, buf.data());
-    std::string message = buf.data();
-    if (log)
-      *log += message;
-    EN_CORE_ERROR("Shader compilation failed:\n{}", message);
-  }
-
-  return ok==GL_TRUE;
-}
-
-GLShader::GLShader(const std::string &filepath) {
+GLShader::GLShader(const std::string &filepath) : m_Name(filepath) {
   std::string source = ReadFile(filepath);
   auto shaderSources = PreProcess(source);
   CompileFromSource(shaderSources);
 }
 
 void GLShader::Destroy() {
+  if (m_Pending) {
+    for (GLuint id : m_Stages)
+      if (id) glDeleteShader(id);
+    m_Stages = {};
+    glDeleteProgram(m_Pending);
+    m_Pending = 0;
+  }
   if (m_Program) {
+    GLStateCache::ForgetProgram(m_Program);
     glDeleteProgram(m_Program);
     m_Program = 0;
   }
@@ -105,121 +96,103 @@ std::unordered_map<GLenum, std::string> GLShader::PreProcess(const std::string&
 
 bool GLShader::CompileFromSource(const char *vs, const char *fs,
                                  std::string *outLog) {
-  GLuint v = glCreateShader(GL_VERTEX_SHADER),
-         f = glCreateShader(GL_FRAGMENT_SHADER);
-  std::string log;
-
-  if (!compile(v, vs, &log) || !compile(f, fs, &log)) {
-    if (outLog)
-      *outLog = log;
-    EN_CORE_ERROR("Shader compilation failed:\n{}", log);
-    glDeleteShader(v);
-    glDeleteShader(f);
-    return false;
-  }
-
-  GLuint p = glCreateProgram();
-  glAttachShader(p,v); glAttachShader(p,f); glLinkProgram(p);
-  glDeleteShader(v); glDeleteShader(f);
-  GLint ok=0; glGetProgramiv(p,GL_LINK_STATUS,&ok);
-  if(!ok){ GLint len=0; glGetProgramiv(p,GL_INFO_LOG_LENGTH,&len);
-    std::vector<char> buf(len + 1);
-    glGetProgramInfoLog(p, len, nullptr, buf.data());
-    std::string linkLog = buf.data();
-    if (outLog)
-      *outLog = linkLog;
-    EN_CORE_ERROR("Shader linking failed:\n{}", linkLog);
-    glDeleteProgram(p);
-    return false;
-  }
-  m_Program = p;
-  m_Uniforms.clear();
-  return true;
+  CompileFromSource({ { GL_VERTEX_SHADER, vs }, { GL_FRAGMENT_SHADER, fs } });
+  const bool ok = finishLink();
+  if (outLog)
+    *outLog = m_Log;
+  return ok;
 }
 
 void GLShader::CompileFromSource(const std::unordered_map<GLenum, std::string>& shaderSources)
 {
+  Destroy();
+  m_Log.clear();
+
+  m_SourceHash = GLProgramCache::HashSources(shaderSources);
+  if (GLuint cached = GLProgramCache::Load(m_SourceHash)) {
+    m_Program = cached;
+    resolveUniforms();
+    return;
+  }
 
+  // Submit everything and return: no status query here, so with parallel compile the
+  // driver works on this while the caller goes on to the next shader
   GLuint program = glCreateProgram();
-  // UE_CORE_ASSERT(shaderSources.size() <= 2, "We only support 2 shaders for now");
-  std::array<GLenum, 2> glShaderIDs{};
-  int glShaderIDIndex = 0;
-  bool hadError = false;
+  GLProgramCache::PrepareProgram(program);
+  int stage = 0;
   for (auto& kv : shaderSources)
     {
-      GLenum type = kv.first;
-      const std::string& source = kv.second;
-
-      GLuint shader = glCreateShader(type);
-
-      const GLchar* sourceCStr = source.c_str();
-      glShaderSource(shader, 1, &sourceCStr, 0);
-
-      glCompileShader(shader);
-
-      GLint isCompiled = 0;
-      glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
-      if (isCompiled == GL_FALSE)
+      if (stage == (int)m_Stages.size())
         {
-          GLint maxLength = 0;
-          glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
-
-          std::vector<GLchar> infoLog(maxLength);
-          glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
-
-          glDeleteShader(shader);
-
-          EN_CORE_ERROR("Shader compilation failed:\n{}", infoLog.data());
-          hadError = true;
+          EN_CORE_ERROR("Shader '{}': only {} stages are supported", m_Name, m_Stages.size());
           break;
         }
-
+      GLuint shader = glCreateShader(kv.first);
+      const GLchar* sourceCStr = kv.second.c_str();
+      glShaderSource(shader, 1, &sourceCStr, 0);
+      glCompileShader(shader);
       glAttachShader(program, shader);
-      glShaderIDs[glShaderIDIndex++] = shader;
-    }
-
-  if (hadError)
-    {
-      for (int i = 0; i < glShaderIDIndex; ++i)
-        glDeleteShader(glShaderIDs[i]);
-      glDeleteProgram(program);
-      return;
+      m_Stages[stage++] = shader;
     }
+  glLinkProgram(program);
+  m_Pending = program;
+}
 
-  m_Program = program;
+bool GLShader::IsReady() const {
+  return !m_Pending || GLProgramCache::IsComplete(m_Pending);
+}
 
-  // Link our program
-  glLinkProgram(program);
+bool GLShader::finishLink() const {
+  if (!m_Pending) return m_Program != 0;
+  const GLuint program = m_Pending;
+  m_Pending = 0;
 
-  // Note the different functions here: glGetProgram* instead of glGetShader*.
   GLint isLinked = 0;
-  glGetProgramiv(program, GL_LINK_STATUS, (int*)&isLinked);
+  glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
   if (isLinked == GL_FALSE)
     {
+      // compile errors first: they are why the link failed
+      for (GLuint id : m_Stages)
+        {
+          GLint isCompiled = GL_TRUE;
+          if (id) glGetShaderiv(id, GL_COMPILE_STATUS, &isCompiled);
+          if (isCompiled == GL_FALSE)
+            {
+              GLint maxLength = 0;
+              glGetShaderiv(id, GL_INFO_LOG_LENGTH, &maxLength);
+              std::vector<GLchar> infoLog((size_t)maxLength + 1);
+              glGetShaderInfoLog(id, maxLength, nullptr, infoLog.data());
+              m_Log += infoLog.data();
+              EN_CORE_ERROR("Shader compilation failed ({}):\n{}", m_Name, infoLog.data());
+            }
+        }
       GLint maxLength = 0;
       glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
-
-      // The maxLength includes the NULL character
-      std::vector<GLchar> infoLog(maxLength);
-      glGetProgramInfoLog(program, maxLength, &maxLength, &infoLog[0]);
-
-      // We don't need the program anymore.
+      std::vector<GLchar> infoLog((size_t)maxLength + 1);
+      glGetProgramInfoLog(program, maxLength, nullptr, infoLog.data());
+      m_Log += infoLog.data();
+      EN_CORE_ERROR("Shader linking failed ({}):\n{}", m_Name, infoLog.data());
+
+      for (GLuint id : m_Stages)
+        if (id) glDeleteShader(id);
+      m_Stages = {};
       glDeleteProgram(program);
-
-      for (auto id : glShaderIDs)
-        glDeleteShader(id);
-
-      EN_CORE_ERROR("Shader linking failed:\n{}", infoLog.data());
-      return;
+      return false;
     }
 
-  for (auto id : glShaderIDs)
+  for (GLuint id : m_Stages)
     {
       if (id == 0)
         continue;
       glDetachShader(program, id);
       glDeleteShader(id);
     }
+  m_Stages = {};
+
+  m_Program = program;
+  resolveUniforms();
+  GLProgramCache::Store(program, m_SourceHash);
+  return true;
 }
 
 std::string GLShader::ReadFile(const std::string& filepath)
@@ -250,16 +223,73 @@ std::string GLShader::ReadFile(const std::string& filepath)
   return result;
 }
 
-void GLShader::Bind() const { glUseProgram(m_Program); }
-void GLShader::Unbind() const { glUseProgram(0); }
+void GLShader::Bind() const { finishLink(); GLStateCache::UseProgram(m_Program); }
+void GLShader::Unbind() const { GLStateCache::UseProgram(0); }
+
+void GLShader::resolveUniforms() const {
+  m_Uniforms.clear();
+  m_UniformSlots.clear();
+  GLint count = 0, maxLen = 0;
+  glGetProgramiv(m_Program, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(m_Program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLen);
+  std::vector<GLchar> name((size_t)maxLen + 1);
+  for (GLint i = 0; i < count; ++i) {
+    GLint size = 0; GLenum type = 0; GLsizei len = 0;
+    glGetActiveUniform(m_Program, (GLuint)i, (GLsizei)name.size(), &len, &size, &type, name.data());
+    std::string key(name.data(), (size_t)len);
+    const GLint loc = glGetUniformLocation(m_Program, key.c_str());
+    if (loc < 0) continue;
+    // arrays are reported as "name[0]"; callers address the whole array by its name
+    if (key.size() > 3 && key.compare(key.size() - 3, 3, "[0]") == 0) key.resize(key.size() - 3);
+    m_Uniforms.emplace(std::move(key), (int)m_UniformSlots.size());
+    m_UniformSlots.push_back({ loc });
+  }
+}
+
+GLShader::Uniform* GLShader::uniform(int handle){
+  // handles come from GetUniform, which finished the link
+  return (handle >= 0 && handle < (int)m_UniformSlots.size()) ? &m_UniformSlots[handle] : nullptr;
+}
+
+bool GLShader::unchanged(Uniform& u, const float* v, size_t count){
+  if (u.Cached && std::memcmp(u.Value.data(), v, count * sizeof(float)) == 0) return true;
+  std::memcpy(u.Value.data(), v, count * sizeof(float));
+  u.Cached = true;
+  return false;
+}
+
+int GLShader::GetUniform(const char* name) const {
+  finishLink();
+  auto it = m_Uniforms.find(std::string_view(name));
+  return it != m_Uniforms.end() ? it->second : -1;
+}
+
+// glUniform* writes to the current program, so each setter makes sure it is ours
+void GLShader::SetFloat(int handle, float v){
+  Uniform* u = uniform(handle);
+  if (!u || unchanged(*u, &v, 1)) return;
+  GLStateCache::UseProgram(m_Program);
+  glUniform1f(u->Location, v);
+}
+void GLShader::SetVec2(int handle, const glm::vec2& v){
+  Uniform* u = uniform(handle);
+  if (!u || unchanged(*u, glm::value_ptr(v), 2)) return;
+  GLStateCache::UseProgram(m_Program);
+  glUniform2f(u->Location, v.x, v.y);
+}
+void GLShader::SetMat4(int handle, const glm::mat4& v){
+  Uniform* u = uniform(handle);
+  if (!u || unchanged(*u, glm::value_ptr(v), 16)) return;
+  GLStateCache::UseProgram(m_Program);
+  glUniformMatrix4fv(u->Location, 1, GL_FALSE, glm::value_ptr(v));
+}
 
-int GLShader::uniformLoc(const char* name){
-    auto it=m_Uniforms.find(name);
-    if(it!=m_Uniforms.end()) return it->second;
-    int loc=glGetUniformLocation(m_Program,name);
-    m_Uniforms[name]=loc; return loc;
+void GLShader::SetFloat(const char* name,float v){ SetFloat(GetUniform(name), v); }
+void GLShader::SetVec2 (const char* name, const glm::vec2& v){ SetVec2(GetUniform(name), v); }
+void GLShader::SetMat4 (const char* name,const glm::mat4& v){ SetMat4(GetUniform(name), v); }
+void GLShader::SetIntArray(const char* name, const int* v, int count) {
+  Uniform* u = uniform(GetUniform(name));
+  if (!u) return;
+  GLStateCache::UseProgram(m_Program);
+  glUniform1iv(u->Location, count, v);
 }
-void GLShader::SetFloat(const char* name,float v){ glUniform1f(uniformLoc(name),v); }
-void GLShader::SetVec2 (const char* name, const glm::vec2& v){ glUniform2f(uniformLoc(name),v.x,v.y); }
-void GLShader::SetMat4 (const char* name,const glm::mat4& v){ glUniformMatrix4fv(uniformLoc(name),1,GL_FALSE,glm::value_ptr(v)); }
-void GLShader::SetIntArray(const char* name, const int* v, int count) { glUniform1iv(uniformLoc(name), count, v); }
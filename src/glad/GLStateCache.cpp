@@ -0,0 +1,147 @@
+#include "gfx/glad/GLStateCache.h"
+#include "glad/glad.h"
+
+namespace {
+
+constexpr GLuint   kUnknown  = ~0u;   // never a GL name: forces the next bind through
+constexpr uint32_t kMaxUnits = 32;
+
+struct State {
+    GLuint  Program     = kUnknown;
+    GLuint  VertexArray = kUnknown;
+    GLuint  ArrayBuffer = kUnknown;
+    GLuint  Tex2D[kMaxUnits];
+    GLuint  TexArray[kMaxUnits];
+    uint32_t ActiveUnit = kUnknown;
+    int     Blend       = -1;         // -1 unknown, 0 off, 1 on
+    GLenum  BlendSrc    = 0;
+    GLenum  BlendDst    = 0;
+    GLenum  BlendSrcA   = 0;
+    GLenum  BlendDstA   = 0;
+    GLuint  Framebuffer = kUnknown;
+
+    State() { reset(); }
+    void reset() {
+        Program = VertexArray = ArrayBuffer = kUnknown;
+        for (uint32_t i = 0; i < kMaxUnits; ++i) Tex2D[i] = TexArray[i] = kUnknown;
+        ActiveUnit = kUnknown;
+        Blend = -1;
+        BlendSrc = BlendDst = BlendSrcA = BlendDstA = 0;
+        Framebuffer = kUnknown;
+    }
+};
+
+State g_State;
+GLStateCache::Stats g_Stats;
+
+GLuint* textureSlot(uint32_t unit, GLenum target) {
+    if (unit >= kMaxUnits) return nullptr;
+    if (target == GL_TEXTURE_2D) return &g_State.Tex2D[unit];
+    if (target == GL_TEXTURE_2D_ARRAY) return &g_State.TexArray[unit];
+    return nullptr;
+}
+
+// true if the call is needed (and records the new value)
+template <typename T>
+bool changes(T& cached, T value) {
+    if (cached == value) { ++g_Stats.Skipped; return false; }
+    cached = value;
+    ++g_Stats.Calls;
+    return true;
+}
+
+}  // namespace
+
+void GLStateCache::UseProgram(GLuint program) {
+    if (changes(g_State.Program, program)) glUseProgram(program);
+}
+
+void GLStateCache::BindVertexArray(GLuint vao) {
+    if (changes(g_State.VertexArray, vao)) glBindVertexArray(vao);
+}
+
+void GLStateCache::BindBuffer(GLenum target, GLuint buffer) {
+    if (target != GL_ARRAY_BUFFER) { ++g_Stats.Calls; glBindBuffer(target, buffer); return; }
+    if (changes(g_State.ArrayBuffer, buffer)) glBindBuffer(target, buffer);
+}
+
+void GLStateCache::BindTexture(uint32_t unit, GLenum target, GLuint texture) {
+    GLuint* slot = textureSlot(unit, target);
+    if (slot && *slot == texture) { ++g_Stats.Skipped; return; }
+    if (g_State.ActiveUnit != unit) {
+        g_State.ActiveUnit = unit;
+        ++g_Stats.Calls;
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    if (slot) *slot = texture;
+    ++g_Stats.Calls;
+    glBindTexture(target, texture);
+}
+
+void GLStateCache::BindTexture(GLenum target, GLuint texture) {
+    if (g_State.ActiveUnit == kUnknown) {
+        g_State.ActiveUnit = 0;
+        glActiveTexture(GL_TEXTURE0);
+    }
+    BindTexture(g_State.ActiveUnit, target, texture);
+}
+
+void GLStateCache::SetBlend(bool enable, GLenum src, GLenum dst, GLenum srcAlpha, GLenum dstAlpha) {
+    if (changes(g_State.Blend, enable ? 1 : 0)) {
+        if (enable) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+    }
+    if (!enable || (src == 0 && dst == 0)) return;
+    if (srcAlpha == 0 && dstAlpha == 0) { srcAlpha = src; dstAlpha = dst; }
+    if (g_State.BlendSrc == src && g_State.BlendDst == dst &&
+        g_State.BlendSrcA == srcAlpha && g_State.BlendDstA == dstAlpha) { ++g_Stats.Skipped; return; }
+    g_State.BlendSrc = src;
+    g_State.BlendDst = dst;
+    g_State.BlendSrcA = srcAlpha;
+    g_State.BlendDstA = dstAlpha;
+    ++g_Stats.Calls;
+    if (srcAlpha == src && dstAlpha == dst) glBlendFunc(src, dst);
+    else glBlendFuncSeparate(src, dst, srcAlpha, dstAlpha);
+}
+
+void GLStateCache::BindFramebuffer(GLuint fbo) {
+    if (changes(g_State.Framebuffer, fbo)) glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+}
+
+GLuint GLStateCache::CurrentFramebuffer() {
+    if (g_State.Framebuffer == kUnknown) {
+        GLint bound = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound);
+        g_State.Framebuffer = (GLuint)bound;
+    }
+    return g_State.Framebuffer;
+}
+
+GLuint GLStateCache::CurrentProgram() { return g_State.Program; }
+
+void GLStateCache::ForgetProgram(GLuint program) {
+    if (g_State.Program == program) g_State.Program = kUnknown;
+}
+
+void GLStateCache::ForgetVertexArray(GLuint vao) {
+    if (g_State.VertexArray == vao) g_State.VertexArray = kUnknown;
+}
+
+void GLStateCache::ForgetBuffer(GLuint buffer) {
+    if (g_State.ArrayBuffer == buffer) g_State.ArrayBuffer = kUnknown;
+}
+
+void GLStateCache::ForgetTexture(GLuint texture) {
+    for (uint32_t i = 0; i < kMaxUnits; ++i) {
+        if (g_State.Tex2D[i] == texture) g_State.Tex2D[i] = kUnknown;
+        if (g_State.TexArray[i] == texture) g_State.TexArray[i] = kUnknown;
+    }
+}
+
+void GLStateCache::ForgetFramebuffer(GLuint fbo) {
+    if (g_State.Framebuffer == fbo) g_State.Framebuffer = kUnknown;
+}
+
+void GLStateCache::Invalidate() { g_State.reset(); }
+
+GLStateCache::Stats GLStateCache::GetStats() { return g_Stats; }
+void GLStateCache::ResetStats() { g_Stats = {}; }
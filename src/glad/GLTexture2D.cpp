@@ -1,4 +1,5 @@
 #include "gfx/glad/GLTexture2D.h"
+#include "gfx/glad/GLStateCache.h"
 #include "glad/glad.h"
 #include "core/Log.h"
 #define STB_IMAGE_IMPLEMENTATION
@@ -6,12 +7,12 @@
 #include <cstdlib>
 
 GLTexture2D::GLTexture2D(){ glGenTextures(1,&m_id); }
-GLTexture2D::~GLTexture2D(){ if(m_id) glDeleteTextures(1,&m_id); }
+GLTexture2D::~GLTexture2D(){ if(m_id){ GLStateCache::ForgetTexture(m_id); glDeleteTextures(1,&m_id); } }
 
 void GLTexture2D::allocate(uint32_t w, uint32_t h, int channels){
     m_w=w; m_h=h; m_channels=channels;
     GLenum fmt = (channels==4)? GL_RGBA : GL_RGB;
-    glBindTexture(GL_TEXTURE_2D, m_id);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, m_id);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, /*GL_LINEAR*/GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, /*GL_LINEAR*/GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -25,6 +26,7 @@ bool GLTexture2D::Create(uint32_t w, uint32_t h, int channels, const void* pixel
         return false;
     }
     allocate(w,h,channels);
+    if(!pixels) return true; // storage only (render targets)
     GLenum fmt = (channels==4)? GL_RGBA : GL_RGB;
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0,0, w,h, fmt, GL_UNSIGNED_BYTE, pixels);
     return true;
@@ -60,6 +62,5 @@ bool GLTexture2D::LoadFromFile(const char* path, bool flipY){
 }
 
 void GLTexture2D::Bind(uint32_t slot) const {
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_2D, m_id);
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D, m_id);
 }
@@ -0,0 +1,39 @@
+#include "gfx/glad/GLTextureArray.h"
+#include "gfx/glad/GLStateCache.h"
+#include "glad/glad.h"
+#include "core/Log.h"
+
+GLTextureArray::GLTextureArray(){ glGenTextures(1,&m_id); }
+GLTextureArray::~GLTextureArray(){ if(m_id){ GLStateCache::ForgetTexture(m_id); glDeleteTextures(1,&m_id); } }
+
+bool GLTextureArray::Create(uint32_t w, uint32_t h, uint32_t layers){
+    GLint maxLayers = 0, maxSize = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if(w==0 || h==0 || layers==0 || (GLint)layers > maxLayers || (GLint)w > maxSize || (GLint)h > maxSize){
+        EN_CORE_ERROR("GLTextureArray unsupported size {}x{}x{}", w, h, layers);
+        return false;
+    }
+    m_w=w; m_h=h; m_layers=layers;
+    // same sampling as GLTexture2D, so a texture looks identical on either path
+    GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, (GLsizei)w, (GLsizei)h, (GLsizei)layers, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    return glGetError() == GL_NO_ERROR;
+}
+
+bool GLTextureArray::SetLayer(uint32_t layer, const void* rgba){
+    if(layer >= m_layers || !rgba) return false;
+    GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, (GLint)layer, (GLsizei)m_w, (GLsizei)m_h, 1,
+                    GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    return true;
+}
+
+void GLTextureArray::Bind(uint32_t slot) const {
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D_ARRAY, m_id);
+}
@@ -1,7 +1,46 @@
 #include "core/Factory.h"
 #include "Kasino/KasinoGame.h"
+#include "window/null/NullWindow.h"
+#include "gfx/null/NullCommandLog.h"
+#include "gfx/ImageIO.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+static void usage(const char* exe) {
+  std::printf("usage: %s [--headless FRAMES | --offscreen FRAMES] [--seed N]\n"
+              "          [--capture PNG] [--golden PNG] [--tolerance N] [--render-thread 0|1]\n", exe);
+}
+
+int main(int argc, char** argv) {
+  long headlessFrames = 0, offscreenFrames = 0;
+  unsigned seed = 1;
+  std::string capturePath, goldenPath;
+  int tolerance = 2;
+  bool renderThread = false;
+  for (int i=1; i<argc; ++i) {
+    const char* a = argv[i];
+    const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!v) { usage(argv[0]); return 1; }
+    if (!std::strcmp(a, "--headless")) headlessFrames = std::atol(v);
+    else if (!std::strcmp(a, "--offscreen")) offscreenFrames = std::atol(v);
+    else if (!std::strcmp(a, "--seed")) seed = (unsigned)std::strtoul(v, nullptr, 10);
+    else if (!std::strcmp(a, "--capture")) capturePath = v;
+    else if (!std::strcmp(a, "--golden")) goldenPath = v;
+    else if (!std::strcmp(a, "--tolerance")) tolerance = std::atoi(v);
+    else if (!std::strcmp(a, "--render-thread")) renderThread = std::atoi(v) != 0;
+    else { usage(argv[0]); return 1; }
+    ++i;
+  }
+  // headless: null backends, nothing drawn; offscreen: the real GL path without a window
+  const bool offscreen = offscreenFrames > 0;
+  const bool headless = headlessFrames > 0 && !offscreen;
+  const long scriptedFrames = offscreen ? offscreenFrames : headlessFrames;
 
-int main() {
   FactoryDesc desc;
   desc.title = "Kasino – Mobile Logical Scale";
   desc.logicalWidth = 480;
@@ -10,14 +49,89 @@ int main() {
   desc.windowHeight = 800;
   desc.resizable = false;
   desc.fullscreen = false;
-  desc.window_api = WindowAPI::GLFW;
-  desc.graphics_api = GraphicsAPI::OpenGL;
-  desc.audio_api = AudioAPI::Miniaudio;
+  desc.window_api = offscreen ? WindowAPI::Offscreen : headless ? WindowAPI::None : WindowAPI::GLFW;
+  desc.graphics_api = headless ? GraphicsAPI::None : GraphicsAPI::OpenGL;
+  desc.audio_api = headless || offscreen ? AudioAPI::Null : AudioAPI::Miniaudio;
 
   KasinoGame game;
   if (!game.Init(desc)) return 1;
+  game.SetThreadedRendering(renderThread);
+
+  if (headless || offscreen) {
+    // every frame runs and renders, one fixed step each; seeded taps drive the table
+    game.SetSeed(seed);
+    game.SetRedrawMode(Game::RedrawMode::Continuous);
+    Game::FrameTiming timing = game.GetFrameTiming();
+    timing.Deterministic = true;
+    game.SetFrameTiming(timing);
+    NullCommandLog::SetRecording(false);
+
+    auto& window = static_cast<NullWindow&>(*game.GetWindow());
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> px(0.0f, (float)desc.logicalWidth);
+    std::uniform_real_distribution<float> py(0.0f, (float)desc.logicalHeight);
+    for (long f = 30; f < scriptedFrames; f += 15) window.Click((uint64_t)f, px(rng), py(rng));
+    window.CloseAt((uint64_t)scriptedFrames);
+  }
+
+  const auto runStart = std::chrono::steady_clock::now();
   game.Run();
+  const double runMs =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStart).count();
+
+  int status = 0;
+  if (headless || offscreen) {
+    const Game::FrameStats& fs = game.GetFrameStats();
+    std::printf("frames %llu  %.3f ms/frame\n", (unsigned long long)fs.Frames,
+                fs.Frames ? runMs / (double)fs.Frames : 0.0);
+    if (renderThread) {
+      const RenderThread::Stats rt = game.GetRenderThreadStats();
+      std::printf("render thread: %llu frames, last execute %.3f ms, last wait %.3f ms\n",
+                  (unsigned long long)rt.Frames, rt.LastExecuteMs, rt.LastWaitMs);
+    }
+  }
+  if (headless) {
+    const NullCommandLog::Counters& c = NullCommandLog::Totals();
+    std::printf("draws %llu (%.1f/frame)  instances %llu  indices %llu\n",
+                (unsigned long long)c.Draws, c.Frames ? (double)c.Draws / c.Frames : 0.0,
+                (unsigned long long)c.Instances, (unsigned long long)c.Indices);
+    std::printf("uploads %.1f MB  state changes %llu  commands %llu\n",
+                (double)c.UploadBytes / (1024.0 * 1024.0), (unsigned long long)c.StateChanges,
+                (unsigned long long)c.Commands);
+  }
+  if (offscreen) {
+    const GpuTimings gpu = RenderCommand::GetGpuTimings();
+    if (gpu.Supported) std::printf("gpu %.3f ms/frame  %.3f ms in passes\n", gpu.FrameMs, gpu.PassMs);
+
+    // the last frame, still in the offscreen target
+    Image frame;
+    if (!game.ReadFrame(frame)) {
+      std::printf("frame readback failed\n");
+      status = 1;
+    }
+    if (status == 0 && !capturePath.empty() && !WritePNG(capturePath, frame)) {
+      std::printf("writing %s failed\n", capturePath.c_str());
+      status = 1;
+    }
+    if (status == 0 && !goldenPath.empty()) {
+      Image golden;
+      if (!ReadImage(goldenPath, golden)) {
+        std::printf("reading %s failed\n", goldenPath.c_str());
+        status = 1;
+      } else {
+        const ImageDiff diff = CompareImages(frame, golden, tolerance);
+        if (diff.SizeMismatch) {
+          std::printf("golden %dx%d, frame %dx%d\n", golden.Width, golden.Height, frame.Width,
+                      frame.Height);
+          status = 2;
+        } else {
+          std::printf("golden: %llu pixels off by more than %d (max delta %d)\n",
+                      (unsigned long long)diff.Differing, tolerance, diff.MaxDelta);
+          if (diff.Differing) status = 2;
+        }
+      }
+    }
+  }
   game.Shutdown();
-  return 0;
+  return status;
 }
-
@@ -0,0 +1,106 @@
+#include "gfx/null/NullCommandLog.h"
+
+#include <algorithm>
+
+bool                     NullCommandLog::s_Recording = true;
+size_t                   NullCommandLog::s_Capacity = 1u << 20;
+std::vector<NullCommand> NullCommandLog::s_Commands;
+NullCommandLog::Counters NullCommandLog::s_Totals;
+NullCommandLog::Counters NullCommandLog::s_Frame;
+NullCommandLog::Counters NullCommandLog::s_LastFrame;
+uint32_t                 NullCommandLog::s_NextId = 0;
+
+namespace {
+
+void count(NullCommandLog::Counters& c, NullOp op, uint64_t a, uint64_t b) {
+  ++c.Commands;
+  switch (op) {
+  case NullOp::BeginFrame:
+  case NullOp::Viewport:
+  case NullOp::Clear:
+    break;
+  case NullOp::EndFrame:
+    ++c.Frames;
+    break;
+  case NullOp::Blend:
+  case NullOp::BindProgram:
+  case NullOp::Uniform:
+  case NullOp::BindTexture:
+  case NullOp::BindVertexArray:
+  case NullOp::BindTarget:
+    ++c.StateChanges;
+    break;
+  case NullOp::BufferData:
+  case NullOp::BufferStream:
+  case NullOp::TextureUpload:
+    c.UploadBytes += a;
+    break;
+  case NullOp::Draw:
+    ++c.Draws;
+    c.Indices += a;
+    break;
+  case NullOp::DrawInstanced:
+    ++c.Draws;
+    c.Indices += a;
+    c.Instances += b;
+    break;
+  }
+}
+
+}  // namespace
+
+void NullCommandLog::SetCapacity(size_t maxCommands) {
+  s_Capacity = maxCommands;
+  s_Commands.reserve(maxCommands);
+}
+
+void NullCommandLog::Record(NullOp op, uint32_t object, uint64_t a, uint64_t b) {
+  if (op == NullOp::BeginFrame) s_Frame = {};
+
+  count(s_Totals, op, a, b);
+  count(s_Frame, op, a, b);
+  if (s_Recording) {
+    if (s_Commands.size() < s_Capacity) {
+      if (s_Commands.empty()) s_Commands.reserve(std::min<size_t>(s_Capacity, 1u << 16));
+      s_Commands.push_back(NullCommand{op, object, a, b});
+    } else {
+      ++s_Totals.Dropped;
+      ++s_Frame.Dropped;
+    }
+  }
+
+  if (op == NullOp::EndFrame) s_LastFrame = s_Frame;
+}
+
+size_t NullCommandLog::CountOf(NullOp op) {
+  return (size_t)std::count_if(s_Commands.begin(), s_Commands.end(),
+                               [op](const NullCommand& c) { return c.Op == op; });
+}
+
+void NullCommandLog::Clear() {
+  s_Commands.clear();
+  s_Totals = {};
+  s_Frame = {};
+  s_LastFrame = {};
+}
+
+const char* NullCommandLog::OpName(NullOp op) {
+  switch (op) {
+  case NullOp::BeginFrame:      return "BeginFrame";
+  case NullOp::EndFrame:        return "EndFrame";
+  case NullOp::Viewport:        return "Viewport";
+  case NullOp::Clear:           return "Clear";
+  case NullOp::Blend:           return "Blend";
+  case NullOp::BindProgram:     return "BindProgram";
+  case NullOp::Uniform:         return "Uniform";
+  case NullOp::BindTexture:     return "BindTexture";
+  case NullOp::BindVertexArray: return "BindVertexArray";
+  case NullOp::BindTarget:      return "BindTarget";
+  case NullOp::BufferData:      return "BufferData";
+  case NullOp::BufferStream:    return "BufferStream";
+  case NullOp::TextureUpload:   return "TextureUpload";
+  case NullOp::Draw:            return "Draw";
+  case NullOp::DrawInstanced:   return "DrawInstanced";
+  }
+  return "?";
+}
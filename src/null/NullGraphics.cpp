@@ -0,0 +1,165 @@
+#include "gfx/null/NullGraphics.h"
+#include "gfx/RenderCommand.h"
+#include "window/IWindow.h"
+#include "core/Log.h"
+
+#include "stb_image.h"
+
+#include <algorithm>
+
+namespace {
+
+// Under GraphicsAPI::None the factory only hands out null objects.
+uint32_t idOf(const IVertexArray& vao) { return static_cast<const NullVertexArray&>(vao).Id(); }
+
+}  // namespace
+
+// ---------------------------------------------------------------- device
+
+NullDevice::NullDevice(const FactoryDesc&) {}
+
+bool NullDevice::Initialize(IWindow& window) {
+  m_Window = &window;
+  EN_CORE_INFO("[Null] graphics device: commands are recorded, nothing is drawn");
+  return true;
+}
+
+void NullDevice::BeginFrame(int fbWidth, int fbHeight) {
+  NullCommandLog::Record(NullOp::BeginFrame);
+  RenderCommand::SetViewport(0, 0, fbWidth, fbHeight);
+}
+
+void NullDevice::EndFrame() {
+  NullCommandLog::Record(NullOp::EndFrame);
+  if (m_Window) m_Window->SwapBuffers();
+}
+
+// ---------------------------------------------------------------- commands
+
+void NullRendererAPI::SetViewport(int x, int y, int w, int h) {
+  NullCommandLog::Record(NullOp::Viewport, 0, (uint32_t)x | (uint64_t)(uint32_t)y << 32,
+                         (uint32_t)w | (uint64_t)(uint32_t)h << 32);
+}
+
+void NullRendererAPI::Clear() { NullCommandLog::Record(NullOp::Clear); }
+
+void NullRendererAPI::EnableBlend(bool enable) {
+  NullCommandLog::Record(NullOp::Blend, 0, enable ? 0xFE : 0xFF);
+}
+
+void NullRendererAPI::SetBlendMode(BlendMode mode) {
+  NullCommandLog::Record(NullOp::Blend, 0, (uint64_t)mode);
+}
+
+void NullRendererAPI::DrawIndexed(const IVertexArray& vao, std::uint32_t indexCount,
+                                  IndexType type) {
+  NullCommandLog::Record(NullOp::Draw, idOf(vao), indexCount, (uint64_t)type);
+}
+
+void NullRendererAPI::DrawIndexedInstanced(const IVertexArray& vao, std::uint32_t indexCount,
+                                           std::uint32_t instanceCount, IndexType) {
+  NullCommandLog::Record(NullOp::DrawInstanced, idOf(vao), indexCount, instanceCount);
+}
+
+// ---------------------------------------------------------------- buffers
+
+void NullBuffer::SetData(const void*, std::size_t bytes, bool) {
+  NullCommandLog::Record(NullOp::BufferData, m_Id, bytes);
+}
+
+void NullBuffer::UpdateSubData(std::size_t byteOffset, const void*, std::size_t bytes) {
+  NullCommandLog::Record(NullOp::BufferData, m_Id, bytes, byteOffset);
+}
+
+void NullBuffer::InitStreaming(std::size_t capacity, StreamMode) {
+  m_Capacity = capacity;
+  m_Head = 0;
+  m_Stats = {};
+}
+
+// same offsets an orphaning GL buffer would return, so attribute setup sees real values
+std::size_t NullBuffer::Stream(const void*, std::size_t bytes) {
+  if (m_Head + bytes > m_Capacity) {
+    m_Head = 0;
+    ++m_Stats.Orphans;
+  }
+  const std::size_t offset = m_Head;
+  m_Head += bytes;
+  m_Stats.Bytes += bytes;
+  NullCommandLog::Record(NullOp::BufferStream, m_Id, bytes, offset);
+  return offset;
+}
+
+void NullVertexArray::Bind() const { NullCommandLog::Record(NullOp::BindVertexArray, m_Id); }
+
+// ---------------------------------------------------------------- shaders
+
+void NullShader::Bind() const { NullCommandLog::Record(NullOp::BindProgram, m_Id); }
+
+int NullShader::GetUniform(const char* name) const {
+  auto it = m_Uniforms.find(std::string_view(name));
+  if (it != m_Uniforms.end()) return it->second;
+  const int handle = (int)m_Uniforms.size();
+  m_Uniforms.emplace(name, handle);
+  return handle;
+}
+
+void NullShader::SetIntArray(const char* name, const int*, int) { record(GetUniform(name)); }
+
+void NullShader::record(int uniform) const {
+  NullCommandLog::Record(NullOp::Uniform, m_Id, (uint64_t)(uint32_t)uniform);
+}
+
+// ---------------------------------------------------------------- textures
+
+bool NullTexture2D::LoadFromFile(const char* path, bool) {
+  int w = 0, h = 0, n = 0;
+  if (!stbi_info(path, &w, &h, &n)) {
+    EN_CORE_ERROR("[Null] failed to read image header: {}", path);
+    return false;
+  }
+  return Create((uint32_t)w, (uint32_t)h, 4, nullptr);
+}
+
+bool NullTexture2D::Create(uint32_t width, uint32_t height, int channels, const void*) {
+  m_Width = width;
+  m_Height = height;
+  NullCommandLog::Record(NullOp::TextureUpload, m_Id,
+                         (uint64_t)width * height * (uint64_t)std::max(channels, 1));
+  return width > 0 && height > 0;
+}
+
+void NullTexture2D::Bind(uint32_t slot) const {
+  NullCommandLog::Record(NullOp::BindTexture, m_Id, slot);
+}
+
+bool NullTextureArray::Create(uint32_t width, uint32_t height, uint32_t layers) {
+  m_Width = width;
+  m_Height = height;
+  m_Layers = layers;
+  return width > 0 && height > 0 && layers > 0;
+}
+
+bool NullTextureArray::SetLayer(uint32_t layer, const void*) {
+  if (layer >= m_Layers) return false;
+  NullCommandLog::Record(NullOp::TextureUpload, m_Id, (uint64_t)m_Width * m_Height * 4, layer);
+  return true;
+}
+
+void NullTextureArray::Bind(uint32_t slot) const {
+  NullCommandLog::Record(NullOp::BindTexture, m_Id, slot);
+}
+
+NullRenderTarget::NullRenderTarget() : m_Texture(CreateRef<NullTexture2D>()) {}
+
+bool NullRenderTarget::Create(uint32_t width, uint32_t height) {
+  return m_Texture->Create(width, height, 4, nullptr);
+}
+
+void NullRenderTarget::Begin(bool clear) {
+  NullCommandLog::Record(NullOp::BindTarget, static_cast<NullTexture2D&>(*m_Texture).Id());
+  RenderCommand::SetViewport(0, 0, (int)Width(), (int)Height());
+  if (clear) NullCommandLog::Record(NullOp::Clear);
+}
+
+void NullRenderTarget::End() { NullCommandLog::Record(NullOp::BindTarget); }
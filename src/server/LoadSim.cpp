@@ -0,0 +1,332 @@
+// Local load generator for KasinoServer: opens many client connections, each hosting a
+// few tables (one human seat, the rest AI), plays random legal moves and reports the
+// per-move round-trip latency. Clients mirror table state from the seed and the
+// MoveApplied stream, exactly like a real client would.
+#include "server/Protocol.h"
+#include "Kasino/GameLogic.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace net;
+using Clock = std::chrono::steady_clock;
+
+struct SimOptions {
+  std::string host = "127.0.0.1";
+  uint16_t port = 7777;
+  std::string unixPath;
+  int connections = 1000;
+  int tablesPerConn = 10;
+  int players = 2;
+  int threads = 4;
+  int seconds = 10;
+  int thinkMs = 0;
+};
+
+struct SimTable {
+  GameState gs;
+  int seat = 0;
+  uint16_t turn = 0;
+  bool started = false;
+  bool inFlight = false;
+  Clock::time_point sentAt;
+};
+
+struct SimConn {
+  int fd = -1;
+  bool wantWrite = false;
+  std::vector<uint8_t> in;
+  std::vector<uint8_t> out;
+  std::unordered_map<uint32_t, SimTable> tables;
+};
+
+struct SimResult {
+  std::vector<uint32_t> latencyUs;
+  uint64_t moves = 0;
+  uint64_t rounds = 0;
+  uint64_t errors = 0;
+  int connected = 0;
+};
+
+static int connectTo(const SimOptions& o) {
+  int fd;
+  if (!o.unixPath.empty()) {
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, o.unixPath.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) { close(fd); return -1; }
+  } else {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(o.port);
+    inet_pton(AF_INET, o.host.c_str(), &addr.sin_addr);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) { close(fd); return -1; }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  }
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  return fd;
+}
+
+class SimWorker {
+public:
+  SimWorker(const SimOptions& o, int conns, uint32_t seed) : m_Opt(o), m_Rng(seed) {
+    m_Epoll = epoll_create1(0);
+    for (int i=0; i<conns; ++i) {
+      int fd = connectTo(o);
+      if (fd < 0) continue;
+      SimConn c; c.fd = fd;
+      m_Conns.push_back(std::move(c));
+    }
+    for (size_t i=0; i<m_Conns.size(); ++i) {
+      epoll_event ev{};
+      ev.events = EPOLLIN;
+      ev.data.u64 = i;
+      epoll_ctl(m_Epoll, EPOLL_CTL_ADD, m_Conns[i].fd, &ev);
+    }
+    m_Result.connected = (int)m_Conns.size();
+  }
+
+  ~SimWorker() {
+    for (auto& c : m_Conns) close(c.fd);
+    close(m_Epoll);
+  }
+
+  SimResult Run(Clock::time_point until) {
+    for (size_t i=0; i<m_Conns.size(); ++i) {
+      for (int t=0; t<m_Opt.tablesPerConn; ++t) createTable(m_Conns[i]);
+      flush(i);
+    }
+
+    epoll_event events[256];
+    while (Clock::now() < until) {
+      int timeout = m_Timers.empty() ? 50 : 1;
+      int n = epoll_wait(m_Epoll, events, 256, timeout);
+      for (int e=0; e<n; ++e) {
+        size_t i = (size_t)events[e].data.u64;
+        if (events[e].events & EPOLLOUT) flush(i);
+        if (events[e].events & EPOLLIN) onReadable(i);
+      }
+      const auto now = Clock::now();
+      while (!m_Timers.empty() && m_Timers.top().at <= now) {
+        Timer t = m_Timers.top(); m_Timers.pop();
+        auto it = m_Conns[t.conn].tables.find(t.table);
+        if (it != m_Conns[t.conn].tables.end()) play(m_Conns[t.conn], t.table, it->second);
+        flush(t.conn);
+      }
+    }
+    return std::move(m_Result);
+  }
+
+private:
+  struct Timer {
+    Clock::time_point at;
+    size_t conn;
+    uint32_t table;
+    bool operator<(const Timer& o) const { return at > o.at; } // min-heap
+  };
+
+  void createTable(SimConn& c) {
+    uint8_t aiMask = (uint8_t)(((1u << m_Opt.players) - 1) & ~1u);
+    FrameWriter w(c.out, MsgType::CreateTable);
+    w.U8((uint8_t)m_Opt.players).U8(aiMask);
+  }
+
+  void flush(size_t i) {
+    SimConn& c = m_Conns[i];
+    size_t off = 0;
+    while (off < c.out.size()) {
+      ssize_t w = write(c.fd, c.out.data() + off, c.out.size() - off);
+      if (w > 0) { off += (size_t)w; continue; }
+      if (w < 0 && errno == EINTR) continue;
+      break;
+    }
+    c.out.erase(c.out.begin(), c.out.begin() + off);
+    bool want = !c.out.empty();
+    if (want != c.wantWrite) {
+      c.wantWrite = want;
+      epoll_event ev{};
+      ev.events = want ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+      ev.data.u64 = i;
+      epoll_ctl(m_Epoll, EPOLL_CTL_MOD, c.fd, &ev);
+    }
+  }
+
+  void onReadable(size_t i) {
+    SimConn& c = m_Conns[i];
+    uint8_t buf[16384];
+    while (true) {
+      ssize_t r = read(c.fd, buf, sizeof(buf));
+      if (r > 0) { c.in.insert(c.in.end(), buf, buf + r); continue; }
+      if (r < 0 && errno == EINTR) continue;
+      break;
+    }
+    DrainFrames(c.in, [&](MsgType type, const uint8_t* p, size_t n) { onFrame(i, type, p, n); });
+    flush(i);
+  }
+
+  void schedule(size_t conn, uint32_t table) {
+    if (m_Opt.thinkMs <= 0) { play(m_Conns[conn], table, m_Conns[conn].tables[table]); return; }
+    m_Timers.push(Timer{Clock::now() + std::chrono::milliseconds(m_Opt.thinkMs), conn, table});
+  }
+
+  void play(SimConn& c, uint32_t id, SimTable& t) {
+    if (!t.started || t.inFlight || t.gs.current != t.seat || t.gs.RoundOver()) return;
+    auto moves = LegalMoves(t.gs);
+    if (moves.empty()) return;
+    int code = (int)(m_Rng() % moves.size());
+    FrameWriter w(c.out, MsgType::PlayMove);
+    w.U32(id).U16(t.turn).U16((uint16_t)code);
+    t.inFlight = true;
+    t.sentAt = Clock::now();
+  }
+
+  void onFrame(size_t i, MsgType type, const uint8_t* p, size_t n) {
+    SimConn& c = m_Conns[i];
+    FrameReader r(p, n);
+    const uint32_t id = r.U32();
+    switch (type) {
+    case MsgType::Joined: {
+      SimTable t;
+      t.seat = r.U8();
+      int players = r.U8();
+      uint32_t seed = r.U32();
+      StartRound(t.gs, players, seed);
+      c.tables[id] = std::move(t);
+    } break;
+
+    case MsgType::Started: {
+      auto it = c.tables.find(id);
+      if (it == c.tables.end()) break;
+      it->second.started = true;
+      schedule(i, id);
+    } break;
+
+    case MsgType::MoveApplied: {
+      auto it = c.tables.find(id);
+      if (it == c.tables.end()) break;
+      SimTable& t = it->second;
+      uint16_t turn = r.U16();
+      int seat = r.U8();
+      int code = r.U16();
+      if (seat == t.seat && t.inFlight) {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t.sentAt).count();
+        m_Result.latencyUs.push_back((uint32_t)us);
+        m_Result.moves++;
+        t.inFlight = false;
+      }
+      Move mv;
+      if (turn != t.turn || !DecodeMove(t.gs, code, mv) || !ApplyMove(t.gs, mv)) { m_Result.errors++; break; }
+      t.turn++;
+      if (t.gs.HandsEmpty()) DealNextHands(t.gs);
+      schedule(i, id);
+    } break;
+
+    case MsgType::RoundOver:
+      c.tables.erase(id);
+      m_Result.rounds++;
+      createTable(c);
+      break;
+
+    case MsgType::Error: {
+      m_Result.errors++;
+      // p[0] is the error code and the table id follows it
+      FrameReader e(p, n);
+      e.U8();
+      auto it = c.tables.find(e.U32());
+      if (it != c.tables.end()) it->second.inFlight = false;
+    } break;
+
+    default:
+      break;
+    }
+  }
+
+  SimOptions m_Opt;
+  std::mt19937 m_Rng;
+  int m_Epoll = -1;
+  std::vector<SimConn> m_Conns;
+  std::priority_queue<Timer> m_Timers;
+  SimResult m_Result;
+};
+
+static void usage(const char* exe) {
+  std::printf("usage: %s [--host IP] [--port N] [--unix PATH] [--conns N] [--tables-per-conn N]\n"
+              "          [--players N] [--threads N] [--seconds N] [--think-ms N]\n", exe);
+}
+
+int main(int argc, char** argv) {
+  SimOptions o;
+  for (int i=1; i<argc; ++i) {
+    const char* a = argv[i];
+    const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!v) { usage(argv[0]); return 1; }
+    if (!std::strcmp(a, "--host")) o.host = v;
+    else if (!std::strcmp(a, "--port")) o.port = (uint16_t)std::atoi(v);
+    else if (!std::strcmp(a, "--unix")) o.unixPath = v;
+    else if (!std::strcmp(a, "--conns")) o.connections = std::atoi(v);
+    else if (!std::strcmp(a, "--tables-per-conn")) o.tablesPerConn = std::atoi(v);
+    else if (!std::strcmp(a, "--players")) o.players = std::clamp(std::atoi(v), 2, 4);
+    else if (!std::strcmp(a, "--threads")) o.threads = std::max(1, std::atoi(v));
+    else if (!std::strcmp(a, "--seconds")) o.seconds = std::atoi(v);
+    else if (!std::strcmp(a, "--think-ms")) o.thinkMs = std::atoi(v);
+    else { usage(argv[0]); return 1; }
+    ++i;
+  }
+  std::signal(SIGPIPE, SIG_IGN);
+
+  const auto until = Clock::now() + std::chrono::seconds(o.seconds);
+  std::vector<SimResult> results(o.threads);
+  std::vector<std::thread> threads;
+  for (int t=0; t<o.threads; ++t) {
+    int conns = o.connections / o.threads + (t < o.connections % o.threads ? 1 : 0);
+    threads.emplace_back([&, t, conns]{
+      SimWorker w(o, conns, 1234u + (uint32_t)t);
+      results[t] = w.Run(until);
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  SimResult all;
+  for (auto& r : results) {
+    all.latencyUs.insert(all.latencyUs.end(), r.latencyUs.begin(), r.latencyUs.end());
+    all.moves += r.moves; all.rounds += r.rounds; all.errors += r.errors; all.connected += r.connected;
+  }
+  std::sort(all.latencyUs.begin(), all.latencyUs.end());
+  auto pct = [&](double q) -> uint32_t {
+    if (all.latencyUs.empty()) return 0;
+    size_t k = std::min(all.latencyUs.size() - 1, (size_t)(q * all.latencyUs.size()));
+    return all.latencyUs[k];
+  };
+
+  std::printf("connections %d  tables %d  duration %ds\n", all.connected, all.connected * o.tablesPerConn, o.seconds);
+  std::printf("moves %llu (%.0f/s)  rounds %llu  errors %llu\n", (unsigned long long)all.moves,
+              o.seconds > 0 ? (double)all.moves / o.seconds : 0.0, (unsigned long long)all.rounds,
+              (unsigned long long)all.errors);
+  std::printf("latency us: p50 %u  p90 %u  p99 %u  p99.9 %u  max %u\n",
+              pct(0.50), pct(0.90), pct(0.99), pct(0.999), all.latencyUs.empty() ? 0 : all.latencyUs.back());
+  return all.errors ? 2 : 0;
+}
@@ -0,0 +1,54 @@
+#include "server/TableServer.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <pthread.h>
+
+static void usage(const char* exe) {
+  std::printf("usage: %s [--port N] [--unix PATH] [--shards N] [--workers N]\n", exe);
+}
+
+int main(int argc, char** argv) {
+  ServerConfig cfg;
+  for (int i=1; i<argc; ++i) {
+    const char* a = argv[i];
+    const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!std::strcmp(a, "--port") && v) { cfg.port = (uint16_t)std::atoi(v); ++i; }
+    else if (!std::strcmp(a, "--unix") && v) { cfg.unixPath = v; ++i; }
+    else if (!std::strcmp(a, "--shards") && v) { cfg.shards = std::atoi(v); ++i; }
+    else if (!std::strcmp(a, "--workers") && v) { cfg.aiWorkers = std::atoi(v); ++i; }
+    else { usage(argv[0]); return 1; }
+  }
+
+  // handle SIGINT/SIGTERM synchronously on the main thread; block them before any
+  // worker thread starts so they inherit the mask
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGINT);
+  sigaddset(&set, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &set, nullptr);
+  std::signal(SIGPIPE, SIG_IGN);
+
+  TableServer server(cfg);
+  if (!server.Start()) return 1;
+  std::printf("KasinoServer listening (tcp %u%s%s)\n", cfg.port,
+              cfg.unixPath.empty() ? "" : ", unix ", cfg.unixPath.c_str());
+
+  timespec every{5, 0};
+  while (true) {
+    int sig = sigtimedwait(&set, nullptr, &every);
+    if (sig == SIGINT || sig == SIGTERM) break;
+    ServerStats st = server.Stats();
+    std::printf("conns %llu  tables %llu  moves %llu (ai %llu)\n",
+                (unsigned long long)st.connections, (unsigned long long)st.tablesOpen,
+                (unsigned long long)st.movesApplied, (unsigned long long)st.aiMoves);
+    std::fflush(stdout);
+  }
+
+  server.Stop();
+  server.Wait();
+  return 0;
+}
@@ -0,0 +1,797 @@
+#include "server/TableServer.h"
+#include "server/Protocol.h"
+#include "Kasino/GameLogic.h"
+#include "Kasino/Scoring.h"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace net;
+
+namespace {
+
+struct ConnRef {
+  uint16_t shard = 0;
+  int fd = -1;
+  uint32_t gen = 0;
+
+  bool Valid() const { return fd >= 0; }
+  bool operator==(const ConnRef& o) const { return shard == o.shard && fd == o.fd && gen == o.gen; }
+};
+
+struct Conn {
+  int fd = -1;
+  uint32_t gen = 0;
+  bool wantWrite = false;
+  bool readPaused = false; // out is over the high-water mark; its requests wait
+  bool dead = false;   // write failed; closed once the current event batch is done
+  std::vector<uint8_t> in;
+  std::vector<uint8_t> out;
+  std::vector<uint32_t> tables; // tables this connection holds a seat at (any shard)
+};
+
+struct ServerTable {
+  GameState gs;
+  std::array<ConnRef, 4> seats{};
+  uint32_t id = 0;
+  uint32_t seed = 0;
+  uint32_t version = 0;   // bumped on every state change; tags AI jobs
+  uint16_t turn = 0;
+  uint8_t numPlayers = 2;
+  uint8_t aiMask = 0;
+  uint8_t generation = 0; // reuse counter for the slot, part of the id
+  bool active = false;
+  bool started = false;
+  bool aiPending = false;
+};
+
+struct Mail {
+  enum class Kind : uint8_t { Request, Send, AiResult, SeatLost, Adopt } kind{};
+  ConnRef conn;
+  uint32_t table = 0;
+  uint32_t version = 0;
+  int code = -1;               // AiResult: move code, Adopt: accepted fd
+  std::vector<uint8_t> bytes; // Request: type + payload, Send: whole frame
+};
+
+struct AiJob {
+  int shard = 0;
+  uint32_t table = 0;
+  uint32_t version = 0;
+  GameState gs;
+};
+
+// bytes read from one connection per wakeup; the rest waits for the next epoll_wait
+// (level-triggered) so one chatty client can't starve the shard
+constexpr size_t kReadBudget = 64 * 1024;
+
+inline int tableShard(uint32_t id) { return (int)(id & 0xff); }
+inline int tableSlot(uint32_t id) { return (int)((id >> 8) & 0xffff); }
+
+// same choice as the in-game AI: first capture, otherwise first trail
+int chooseAiMove(const GameState& gs) {
+  auto moves = LegalMoves(gs);
+  int trail = -1;
+  for (int i=0; i<(int)moves.size(); ++i) {
+    if (moves[i].type == MoveType::Capture) return i;
+    if (trail < 0 && moves[i].type == MoveType::Trail) trail = i;
+  }
+  return trail >= 0 ? trail : (moves.empty() ? -1 : 0);
+}
+
+} // namespace
+
+// ---------- AI worker pool
+
+struct TableServer::AiPool {
+  TableServer* server = nullptr;
+  std::mutex lock;
+  std::condition_variable cv;
+  std::deque<AiJob> jobs;
+  std::vector<std::thread> threads;
+  bool stop = false;
+
+  void Start(int count);
+  void Stop();
+  void Push(AiJob&& job);
+};
+
+// ---------- shard
+
+struct TableServer::Shard {
+  TableServer* server = nullptr;
+  int index = 0;
+  int epfd = -1;
+  int wakeFd = -1;
+  int tcpFd = -1;
+  int unixFd = -1;
+
+  std::unordered_map<int, Conn> conns;
+  std::vector<int> deadFds;
+  uint32_t nextGen = 1;
+  uint32_t nextAdopt = 0;
+
+  std::vector<ServerTable> tables;
+  std::vector<int> freeSlots;
+  std::mt19937 rng{std::random_device{}()};
+
+  std::mutex mailLock;
+  std::vector<Mail> mailbox;
+  std::vector<Mail> mailScratch;
+
+  std::atomic<uint64_t> statConnections{0};
+  std::atomic<uint64_t> statTables{0};
+  std::atomic<uint64_t> statMoves{0};
+  std::atomic<uint64_t> statAiMoves{0};
+
+  bool Open();
+  void Close();
+  void Run();
+  void Post(Mail&& mail);
+
+  // connections
+  void acceptAll(int listenFd);
+  void addConn(int fd);
+  void onReadable(Conn& c);
+  void flush(Conn& c);
+  void watch(Conn& c);
+  void drop(Conn& c);
+  void closeConn(int fd);
+  void deliver(const ConnRef& to, const uint8_t* frame, size_t size);
+  void sendTo(const ConnRef& to, std::vector<uint8_t>&& frame);
+  void sendError(const ConnRef& to, ErrorCode code, uint32_t table);
+
+  // messages
+  void drainMail();
+  void onFrame(const ConnRef& from, MsgType type, const uint8_t* payload, size_t size);
+  void onTableMessage(const ConnRef& from, MsgType type, const uint8_t* payload, size_t size);
+
+  // tables
+  ServerTable* findTable(uint32_t id);
+  ServerTable* createTable(int players, uint8_t aiMask);
+  void freeTable(ServerTable& t);
+  void startTable(ServerTable& t);
+  bool applyCode(ServerTable& t, int seat, int code, bool byAi);
+  void aiFailed(ServerTable& t, int code);
+  void finishTable(ServerTable& t);
+  void scheduleAi(ServerTable& t);
+  void seatLost(uint32_t tableId, const ConnRef& who);
+  void broadcast(const ServerTable& t, const std::vector<uint8_t>& frame);
+};
+
+static ConnRef refOf(int shard, const Conn& c) { return ConnRef{(uint16_t)shard, c.fd, c.gen}; }
+
+bool TableServer::Shard::Open() {
+  epfd = epoll_create1(EPOLL_CLOEXEC);
+  wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epfd < 0 || wakeFd < 0) return false;
+
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = wakeFd;
+  epoll_ctl(epfd, EPOLL_CTL_ADD, wakeFd, &ev);
+
+  const ServerConfig& cfg = server->m_Config;
+  if (cfg.port) {
+    tcpFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    setsockopt(tcpFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(tcpFd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(cfg.port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(tcpFd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(tcpFd, 1024) < 0) {
+      std::fprintf(stderr, "shard %d: tcp listen on %u failed: %s\n", index, cfg.port, std::strerror(errno));
+      return false;
+    }
+    ev.data.fd = tcpFd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, tcpFd, &ev);
+  }
+
+  // unix sockets have no SO_REUSEPORT, so shard 0 listens and hands connections out
+  if (index == 0 && !cfg.unixPath.empty()) {
+    unixFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, cfg.unixPath.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(cfg.unixPath.c_str());
+    if (bind(unixFd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(unixFd, 1024) < 0) {
+      std::fprintf(stderr, "unix listen on %s failed: %s\n", cfg.unixPath.c_str(), std::strerror(errno));
+      return false;
+    }
+    ev.data.fd = unixFd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, unixFd, &ev);
+  }
+  return true;
+}
+
+void TableServer::Shard::Close() {
+  for (auto& [fd, c] : conns) close(fd);
+  conns.clear();
+  // unix clients dealt to this shard that it never got to adopt
+  for (const Mail& m : mailbox)
+    if (m.kind == Mail::Kind::Adopt) close(m.code);
+  mailbox.clear();
+  if (tcpFd >= 0) close(tcpFd);
+  if (unixFd >= 0) { close(unixFd); unlink(server->m_Config.unixPath.c_str()); }
+  if (wakeFd >= 0) close(wakeFd);
+  if (epfd >= 0) close(epfd);
+  tcpFd = unixFd = wakeFd = epfd = -1;
+}
+
+void TableServer::Shard::Post(Mail&& mail) {
+  bool wasEmpty;
+  {
+    std::lock_guard<std::mutex> g(mailLock);
+    wasEmpty = mailbox.empty();
+    mailbox.push_back(std::move(mail));
+  }
+  if (wasEmpty) {
+    uint64_t one = 1;
+    (void)!write(wakeFd, &one, sizeof(one));
+  }
+}
+
+void TableServer::Shard::Run() {
+  epoll_event events[256];
+  while (server->m_Running.load(std::memory_order_relaxed)) {
+    int n = epoll_wait(epfd, events, 256, 100);
+    if (n < 0 && errno != EINTR) break;
+    for (int i=0; i<n; ++i) {
+      const int fd = events[i].data.fd;
+      if (fd == wakeFd) {
+        uint64_t v;
+        (void)!read(wakeFd, &v, sizeof(v));
+        drainMail();
+      } else if (fd == tcpFd || fd == unixFd) {
+        acceptAll(fd);
+      } else {
+        auto it = conns.find(fd);
+        if (it == conns.end()) continue;
+        if (events[i].events & (EPOLLHUP | EPOLLERR)) { closeConn(fd); continue; }
+        if (events[i].events & EPOLLOUT) flush(it->second);
+        if (events[i].events & EPOLLIN) {
+          it = conns.find(fd); // flush may have closed or paused it
+          if (it != conns.end() && !it->second.readPaused) onReadable(it->second);
+        }
+      }
+    }
+    for (int fd : deadFds) closeConn(fd);
+    deadFds.clear();
+  }
+}
+
+// ---------- connections
+
+void TableServer::Shard::acceptAll(int listenFd) {
+  while (true) {
+    int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) return;
+    if (listenFd == tcpFd) {
+      int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      addConn(fd);
+      continue;
+    }
+    // unix clients all land on shard 0; deal them out so tables still spread
+    int target = (int)(nextAdopt++ % server->m_Shards.size());
+    if (target == index) { addConn(fd); continue; }
+    Mail m; m.kind = Mail::Kind::Adopt; m.code = fd;
+    server->m_Shards[target]->Post(std::move(m));
+  }
+}
+
+void TableServer::Shard::addConn(int fd) {
+  Conn c;
+  c.fd = fd;
+  c.gen = nextGen++;
+  conns[fd] = std::move(c);
+
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = fd;
+  epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+  statConnections.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TableServer::Shard::onReadable(Conn& c) {
+  const int fd = c.fd;
+  uint8_t buf[16384];
+  size_t budget = kReadBudget;
+  while (budget > 0) {
+    ssize_t r = read(fd, buf, std::min(sizeof(buf), budget));
+    if (r > 0) { c.in.insert(c.in.end(), buf, buf + r); budget -= (size_t)r; continue; }
+    if (r == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) { closeConn(fd); return; }
+    if (errno == EINTR) continue;
+    break;
+  }
+
+  const ConnRef self = refOf(index, c);
+  std::vector<uint8_t> pending;
+  pending.swap(c.in);
+  bool ok = DrainFrames(pending, [&](MsgType type, const uint8_t* payload, size_t size) {
+    onFrame(self, type, payload, size);
+  });
+  // handlers may have closed the connection (or rehashed the map)
+  auto it = conns.find(fd);
+  if (it == conns.end() || it->second.gen != self.gen) return;
+  if (!ok) { closeConn(fd); return; }
+  it->second.in.swap(pending);
+}
+
+void TableServer::Shard::flush(Conn& c) {
+  size_t off = 0;
+  while (off < c.out.size()) {
+    ssize_t w = write(c.fd, c.out.data() + off, c.out.size() - off);
+    if (w > 0) { off += (size_t)w; continue; }
+    if (w < 0 && errno == EINTR) continue;
+    if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+    drop(c);
+    return;
+  }
+  c.out.erase(c.out.begin(), c.out.begin() + off);
+  watch(c);
+}
+
+// Keeps the epoll mask in step with the outbound queue: EPOLLOUT while anything is
+// queued, and no EPOLLIN from the high-water mark until it drains to half of it, so a
+// client that doesn't read its replies can't keep asking for more.
+void TableServer::Shard::watch(Conn& c) {
+  const size_t highWater = server->m_Config.outHighWater;
+  const bool want = !c.out.empty();
+  const bool paused = c.readPaused ? c.out.size() > highWater / 2 : c.out.size() >= highWater;
+  if (want == c.wantWrite && paused == c.readPaused) return;
+  c.wantWrite = want;
+  c.readPaused = paused;
+  epoll_event ev{};
+  ev.events = (paused ? 0u : (uint32_t)EPOLLIN) | (want ? (uint32_t)EPOLLOUT : 0u);
+  ev.data.fd = c.fd;
+  epoll_ctl(epfd, EPOLL_CTL_MOD, c.fd, &ev);
+}
+
+// Closed once the current event batch is done, not from inside a table update.
+void TableServer::Shard::drop(Conn& c) {
+  c.dead = true;
+  c.out.clear();
+  deadFds.push_back(c.fd);
+}
+
+void TableServer::Shard::closeConn(int fd) {
+  auto it = conns.find(fd);
+  if (it == conns.end()) return;
+  const ConnRef self = refOf(index, it->second);
+  std::vector<uint32_t> held = std::move(it->second.tables);
+  epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
+  close(fd);
+  conns.erase(it);
+  statConnections.fetch_sub(1, std::memory_order_relaxed);
+
+  for (uint32_t id : held) {
+    int owner = tableShard(id);
+    if (owner == index) { seatLost(id, self); continue; }
+    Mail m; m.kind = Mail::Kind::SeatLost; m.conn = self; m.table = id;
+    server->m_Shards[owner]->Post(std::move(m));
+  }
+}
+
+// Local write. Joined/RoundOver frames also maintain the connection's seat list here,
+// so the bookkeeping is the same whether the table lives on this shard or another.
+void TableServer::Shard::deliver(const ConnRef& to, const uint8_t* frame, size_t size) {
+  auto it = conns.find(to.fd);
+  if (it == conns.end() || it->second.gen != to.gen || it->second.dead) return;
+  Conn& c = it->second;
+
+  if (size >= 7) {
+    const auto type = static_cast<MsgType>(frame[2]);
+    FrameReader r(frame + 3, size - 3);
+    uint32_t id = r.U32();
+    if (type == MsgType::Joined) c.tables.push_back(id);
+    else if (type == MsgType::RoundOver) std::erase(c.tables, id);
+  }
+
+  // broadcasts keep coming while reads are paused; past the hard limit it's gone
+  if (c.out.size() + size > server->m_Config.outLimit) { drop(c); return; }
+  const bool idle = c.out.empty();
+  c.out.insert(c.out.end(), frame, frame + size);
+  if (idle) flush(c);
+  else watch(c);
+}
+
+void TableServer::Shard::sendTo(const ConnRef& to, std::vector<uint8_t>&& frame) {
+  if (!to.Valid()) return;
+  if (to.shard == index) { deliver(to, frame.data(), frame.size()); return; }
+  Mail m; m.kind = Mail::Kind::Send; m.conn = to; m.bytes = std::move(frame);
+  server->m_Shards[to.shard]->Post(std::move(m));
+}
+
+void TableServer::Shard::sendError(const ConnRef& to, ErrorCode code, uint32_t table) {
+  std::vector<uint8_t> f;
+  { FrameWriter w(f, MsgType::Error); w.U8(static_cast<uint8_t>(code)).U32(table); }
+  sendTo(to, std::move(f));
+}
+
+void TableServer::Shard::broadcast(const ServerTable& t, const std::vector<uint8_t>& frame) {
+  for (int s=0; s<t.numPlayers; ++s) {
+    if (!t.seats[s].Valid()) continue;
+    std::vector<uint8_t> copy = frame;
+    sendTo(t.seats[s], std::move(copy));
+  }
+}
+
+// ---------- messages
+
+void TableServer::Shard::drainMail() {
+  {
+    std::lock_guard<std::mutex> g(mailLock);
+    mailScratch.swap(mailbox);
+  }
+  for (Mail& m : mailScratch) {
+    switch (m.kind) {
+    case Mail::Kind::Request:
+      if (!m.bytes.empty())
+        onTableMessage(m.conn, static_cast<MsgType>(m.bytes[0]), m.bytes.data() + 1, m.bytes.size() - 1);
+      break;
+    case Mail::Kind::Send:
+      deliver(m.conn, m.bytes.data(), m.bytes.size());
+      break;
+    case Mail::Kind::AiResult: {
+      ServerTable* t = findTable(m.table);
+      if (!t || t->version != m.version) break; // table moved on or closed meanwhile
+      t->aiPending = false;
+      if (!applyCode(*t, t->gs.current, m.code, true)) aiFailed(*t, m.code);
+    } break;
+    case Mail::Kind::SeatLost:
+      seatLost(m.table, m.conn);
+      break;
+    case Mail::Kind::Adopt:
+      addConn(m.code);
+      break;
+    }
+  }
+  mailScratch.clear();
+}
+
+void TableServer::Shard::onFrame(const ConnRef& from, MsgType type, const uint8_t* payload, size_t size) {
+  FrameReader r(payload, size);
+  switch (type) {
+  case MsgType::CreateTable: {
+    int players = r.U8();
+    uint8_t aiMask = r.U8();
+    if (!r.ok || players < 2 || players > 4) { sendError(from, ErrorCode::BadMessage, 0); return; }
+    ServerTable* t = createTable(players, (uint8_t)(aiMask & ~1u));
+    if (!t) { sendError(from, ErrorCode::ServerFull, 0); return; }
+    t->seats[0] = from;
+    std::vector<uint8_t> f;
+    { FrameWriter w(f, MsgType::Joined); w.U32(t->id).U8(0).U8(t->numPlayers).U32(t->seed); }
+    sendTo(from, std::move(f));
+    startTable(*t);
+  } break;
+
+  case MsgType::JoinTable:
+  case MsgType::PlayMove:
+  case MsgType::LeaveTable: {
+    uint32_t id = r.U32();
+    if (!r.ok) { sendError(from, ErrorCode::BadMessage, 0); return; }
+    int owner = tableShard(id);
+    if (owner >= (int)server->m_Shards.size()) { sendError(from, ErrorCode::NoSuchTable, id); return; }
+    if (owner == index) { onTableMessage(from, type, payload, size); return; }
+    Mail m; m.kind = Mail::Kind::Request; m.conn = from;
+    m.bytes.reserve(size + 1);
+    m.bytes.push_back(static_cast<uint8_t>(type));
+    m.bytes.insert(m.bytes.end(), payload, payload + size);
+    server->m_Shards[owner]->Post(std::move(m));
+  } break;
+
+  default:
+    sendError(from, ErrorCode::BadMessage, 0);
+    break;
+  }
+}
+
+void TableServer::Shard::onTableMessage(const ConnRef& from, MsgType type, const uint8_t* payload, size_t size) {
+  FrameReader r(payload, size);
+  const uint32_t id = r.U32();
+  ServerTable* t = findTable(id);
+  if (!t) { sendError(from, ErrorCode::NoSuchTable, id); return; }
+
+  switch (type) {
+  case MsgType::JoinTable: {
+    int seat = -1;
+    if (!t->started)
+      for (int s=1; s<t->numPlayers && seat < 0; ++s)
+        if (!(t->aiMask & (1u << s)) && !t->seats[s].Valid()) seat = s;
+    if (seat < 0) { sendError(from, ErrorCode::TableFull, id); return; }
+    t->seats[seat] = from;
+    std::vector<uint8_t> f;
+    { FrameWriter w(f, MsgType::Joined); w.U32(t->id).U8((uint8_t)seat).U8(t->numPlayers).U32(t->seed); }
+    sendTo(from, std::move(f));
+    startTable(*t);
+  } break;
+
+  case MsgType::PlayMove: {
+    uint16_t turn = r.U16();
+    uint16_t code = r.U16();
+    if (!r.ok) { sendError(from, ErrorCode::BadMessage, id); return; }
+    const int cur = t->gs.current;
+    if (!t->started || !(t->seats[cur] == from) || turn != t->turn) { sendError(from, ErrorCode::NotYourTurn, id); return; }
+    applyCode(*t, cur, code, false);
+  } break;
+
+  case MsgType::LeaveTable:
+    seatLost(id, from);
+    break;
+
+  default:
+    break;
+  }
+}
+
+// ---------- tables
+
+ServerTable* TableServer::Shard::findTable(uint32_t id) {
+  if (tableShard(id) != index) return nullptr;
+  int slot = tableSlot(id);
+  if (slot >= (int)tables.size()) return nullptr;
+  ServerTable& t = tables[slot];
+  return (t.active && t.id == id) ? &t : nullptr;
+}
+
+ServerTable* TableServer::Shard::createTable(int players, uint8_t aiMask) {
+  int slot;
+  if (!freeSlots.empty()) { slot = freeSlots.back(); freeSlots.pop_back(); }
+  else {
+    if ((int)tables.size() >= std::min(server->m_Config.maxTablesPerShard, 0x10000)) return nullptr;
+    slot = (int)tables.size();
+    tables.emplace_back();
+  }
+
+  ServerTable& t = tables[slot];
+  const uint8_t generation = (uint8_t)(t.generation + 1);
+  t = ServerTable{};
+  t.generation = generation;
+  t.id = ((uint32_t)generation << 24) | ((uint32_t)slot << 8) | (uint32_t)index;
+  t.seed = rng() | 1u; // StartRound treats 0 as "random", keep it reproducible
+  t.numPlayers = (uint8_t)players;
+  t.aiMask = aiMask & (uint8_t)((1u << players) - 1);
+  t.active = true;
+  StartRound(t.gs, players, t.seed);
+  statTables.fetch_add(1, std::memory_order_relaxed);
+  return &t;
+}
+
+void TableServer::Shard::freeTable(ServerTable& t) {
+  const uint8_t generation = t.generation;
+  const int slot = tableSlot(t.id);
+  t = ServerTable{};
+  t.generation = generation;
+  freeSlots.push_back(slot);
+  statTables.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void TableServer::Shard::startTable(ServerTable& t) {
+  if (t.started) return;
+  for (int s=0; s<t.numPlayers; ++s)
+    if (!(t.aiMask & (1u << s)) && !t.seats[s].Valid()) return; // still waiting for humans
+  t.started = true;
+  std::vector<uint8_t> f;
+  { FrameWriter w(f, MsgType::Started); w.U32(t.id); }
+  broadcast(t, f);
+  scheduleAi(t);
+}
+
+bool TableServer::Shard::applyCode(ServerTable& t, int seat, int code, bool byAi) {
+  Move mv;
+  if (!DecodeMove(t.gs, code, mv) || !ApplyMove(t.gs, mv)) {
+    if (!byAi) sendError(t.seats[seat], ErrorCode::IllegalMove, t.id);
+    return false;
+  }
+  t.version++;
+  statMoves.fetch_add(1, std::memory_order_relaxed);
+  if (byAi) statAiMoves.fetch_add(1, std::memory_order_relaxed);
+
+  std::vector<uint8_t> f;
+  { FrameWriter w(f, MsgType::MoveApplied); w.U32(t.id).U16(t.turn).U8((uint8_t)seat).U16((uint16_t)code); }
+  t.turn++;
+  broadcast(t, f);
+
+  if (t.gs.HandsEmpty() && !DealNextHands(t.gs)) {
+    finishTable(t);
+    return true;
+  }
+  scheduleAi(t);
+  return true;
+}
+
+// The AI seat's code didn't apply (none legal, or stale): nothing else would move the
+// table, so trail, or play the first legal move, and give up on the table if even
+// that fails.
+void TableServer::Shard::aiFailed(ServerTable& t, int code) {
+  const int seat = t.gs.current;
+  std::fprintf(stderr, "shard %d: table %08x seat %d: AI code %d rejected\n", index, t.id, seat, code);
+  auto moves = LegalMoves(t.gs);
+  int fallback = moves.empty() ? -1 : 0;
+  for (int i=0; i<(int)moves.size(); ++i)
+    if (moves[i].type == MoveType::Trail) { fallback = i; break; }
+  if (fallback >= 0 && fallback != code && applyCode(t, seat, fallback, true)) return;
+
+  std::fprintf(stderr, "shard %d: table %08x has no playable move; closing it\n", index, t.id);
+  std::vector<uint8_t> f;
+  { FrameWriter w(f, MsgType::Error); w.U8(static_cast<uint8_t>(ErrorCode::IllegalMove)).U32(t.id); }
+  broadcast(t, f);
+  finishTable(t);
+}
+
+// RoundOver with the totals so far to every seat (which also drops the table from each
+// connection's seat list), then the slot is free.
+void TableServer::Shard::finishTable(ServerTable& t) {
+  auto lines = ScoreRound(t.gs);
+  std::vector<uint8_t> over;
+  {
+    FrameWriter w(over, MsgType::RoundOver);
+    w.U32(t.id).U8(t.numPlayers);
+    for (const auto& line : lines) w.U16((uint16_t)(int16_t)line.total);
+  }
+  broadcast(t, over);
+  freeTable(t);
+}
+
+void TableServer::Shard::scheduleAi(ServerTable& t) {
+  if (!t.started || t.aiPending) return;
+  if (!(t.aiMask & (1u << t.gs.current))) return;
+  t.aiPending = true;
+  AiJob job;
+  job.shard = index;
+  job.table = t.id;
+  job.version = t.version;
+  job.gs = t.gs;
+  server->m_AiPool->Push(std::move(job));
+}
+
+// A human left or dropped. Before the start the seat just opens up again; once playing,
+// the AI takes it over. Tables with nobody left to watch are closed.
+void TableServer::Shard::seatLost(uint32_t tableId, const ConnRef& who) {
+  ServerTable* t = findTable(tableId);
+  if (!t) return;
+  int humans = 0;
+  for (int s=0; s<t->numPlayers; ++s) {
+    if (t->seats[s] == who) {
+      t->seats[s] = ConnRef{};
+      if (t->started) t->aiMask |= (uint8_t)(1u << s);
+    }
+    if (t->seats[s].Valid()) humans++;
+  }
+  if (humans == 0) { freeTable(*t); return; }
+  t->version++;
+  t->aiPending = false;
+  scheduleAi(*t);
+}
+
+// ---------- AI pool
+
+void TableServer::AiPool::Start(int count) {
+  for (int i=0; i<count; ++i) {
+    threads.emplace_back([this]{
+      while (true) {
+        AiJob job;
+        {
+          std::unique_lock<std::mutex> g(lock);
+          cv.wait(g, [this]{ return stop || !jobs.empty(); });
+          if (stop) return;
+          job = std::move(jobs.front());
+          jobs.pop_front();
+        }
+        Mail m;
+        m.kind = Mail::Kind::AiResult;
+        m.table = job.table;
+        m.version = job.version;
+        m.code = chooseAiMove(job.gs);
+        server->m_Shards[job.shard]->Post(std::move(m));
+      }
+    });
+  }
+}
+
+void TableServer::AiPool::Stop() {
+  {
+    std::lock_guard<std::mutex> g(lock);
+    stop = true;
+  }
+  cv.notify_all();
+  for (auto& t : threads) if (t.joinable()) t.join();
+  threads.clear();
+}
+
+void TableServer::AiPool::Push(AiJob&& job) {
+  {
+    std::lock_guard<std::mutex> g(lock);
+    jobs.push_back(std::move(job));
+  }
+  cv.notify_one();
+}
+
+// ---------- TableServer
+
+TableServer::TableServer(const ServerConfig& cfg) : m_Config(cfg) {
+  const int hw = (int)std::max(1u, std::thread::hardware_concurrency());
+  if (m_Config.shards <= 0) m_Config.shards = hw;
+  if (m_Config.shards > 255) m_Config.shards = 255;
+  if (m_Config.aiWorkers <= 0) m_Config.aiWorkers = std::max(1, hw / 2);
+}
+
+TableServer::~TableServer() {
+  Stop();
+  Wait();
+}
+
+bool TableServer::Start() {
+  m_Running = true;
+  for (int i=0; i<m_Config.shards; ++i) {
+    auto shard = std::make_unique<Shard>();
+    shard->server = this;
+    shard->index = i;
+    m_Shards.push_back(std::move(shard));
+  }
+  for (auto& shard : m_Shards) {
+    if (!shard->Open()) {
+      m_Running = false;
+      for (auto& s : m_Shards) s->Close();
+      m_Shards.clear();
+      return false;
+    }
+  }
+
+  m_AiPool = std::make_unique<AiPool>();
+  m_AiPool->server = this;
+  m_AiPool->Start(m_Config.aiWorkers);
+
+  for (auto& shard : m_Shards) {
+    Shard* s = shard.get();
+    m_Threads.emplace_back([s]{ s->Run(); });
+  }
+  return true;
+}
+
+void TableServer::Stop() {
+  if (!m_Running.exchange(false)) return;
+  for (auto& s : m_Shards) {
+    uint64_t one = 1;
+    (void)!write(s->wakeFd, &one, sizeof(one));
+  }
+}
+
+void TableServer::Wait() {
+  for (auto& t : m_Threads) if (t.joinable()) t.join();
+  m_Threads.clear();
+  if (m_AiPool) { m_AiPool->Stop(); m_AiPool.reset(); }
+  for (auto& s : m_Shards) s->Close();
+  m_Shards.clear();
+}
+
+ServerStats TableServer::Stats() const {
+  ServerStats st;
+  for (const auto& s : m_Shards) {
+    st.connections += s->statConnections.load(std::memory_order_relaxed);
+    st.tablesOpen += s->statTables.load(std::memory_order_relaxed);
+    st.movesApplied += s->statMoves.load(std::memory_order_relaxed);
+    st.aiMoves += s->statAiMoves.load(std::memory_order_relaxed);
+  }
+  return st;
+}
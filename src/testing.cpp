@@ -1,14 +1,343 @@
 #include "Kasino/GameLogic.h"
 #include "Kasino/Scoring.h"
+#include "Kasino/Lockstep.h"
+#include "Kasino/Canonical.h"
+#include "Kasino/Search.h"
+#include "Kasino/BatchRollout.h"
+#include "Kasino/StateCodec.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
-using namespace Casino;
 
 static Card C(Rank r, Suit s){ return Card{r,s}; }
 static void Assert(bool ok, const char* what){ if(!ok){ std::cerr<<"[FAIL] "<<what<<"\n"; std::abort(); } }
 static void AssertEq(int got,int want,const char* what){ if(got!=want){ std::cerr<<"[FAIL] "<<what<<" got="<<got<<" want="<<want<<"\n"; std::abort(); } }
 
+// Lock-step deal over loopback: both peers must deal the same cards, and those cards
+// are pinned so a shuffle that differs between standard libraries shows up here.
+static void LockstepDealTest() {
+  auto [t0, t1] = LoopbackTransport::CreatePair();
+  LockstepConfig c0; c0.localPeer = 0;
+  LockstepConfig c1; c1.localPeer = 1;
+  LockstepSession s0(c0), s1(c1);
+  s0.AddPeer(1, t0);
+  s1.AddPeer(0, t1);
+  s0.Start(0x1234u);   // seed 0x1234 ^ 0xBEEF
+  s1.Start(0xBEEFu);
+  for (int i=0; i<4 && !(s0.Started() && s1.Started()); ++i) { s0.Poll(); s1.Poll(); }
+  Assert(s0.Started() && s1.Started(), "loopback peers started");
+
+  const std::vector<Card> p0 = { C(Rank::Ten,Suit::Clubs), C(Rank::Ten,Suit::Diamonds), C(Rank::Three,Suit::Clubs), C(Rank::Eight,Suit::Diamonds) };
+  const std::vector<Card> p1 = { C(Rank::Jack,Suit::Clubs), C(Rank::Nine,Suit::Hearts), C(Rank::Four,Suit::Spades), C(Rank::Queen,Suit::Diamonds) };
+  const std::vector<Card> table = { C(Rank::Three,Suit::Diamonds), C(Rank::Five,Suit::Spades), C(Rank::Ace,Suit::Diamonds), C(Rank::King,Suit::Spades) };
+  for (const LockstepSession* s : { &s0, &s1 }) {
+    Assert(s->State().players[0].hand == p0, "pinned P0 deal");
+    Assert(s->State().players[1].hand == p1, "pinned P1 deal");
+    Assert(s->State().table.loose == table, "pinned table deal");
+  }
+}
+
+static void StartLoopbackPair(LockstepSession& s0, LockstepSession& s1,
+                              const Ref<LoopbackTransport>& t0, const Ref<LoopbackTransport>& t1) {
+  s0.AddPeer(1, t0);
+  s1.AddPeer(0, t1);
+  s0.Start(0x1234u);
+  s1.Start(0xBEEFu);
+  for (int i=0; i<4 && !(s0.Started() && s1.Started()); ++i) { s0.Poll(); s1.Poll(); }
+  Assert(s0.Started() && s1.Started(), "loopback peers started");
+}
+
+// Raw lock-step frames, as a peer that lies would send them.
+static void SendMove(LoopbackTransport& t, uint16_t turn, uint16_t code) {
+  const uint8_t msg[5] = { 2, (uint8_t)turn, (uint8_t)(turn >> 8), (uint8_t)code, (uint8_t)(code >> 8) };
+  t.Send(msg, sizeof(msg));
+}
+static void SendChecksum(LoopbackTransport& t, uint16_t turn, uint32_t hash) {
+  const uint8_t msg[7] = { 3, (uint8_t)turn, (uint8_t)(turn >> 8),
+                           (uint8_t)hash, (uint8_t)(hash >> 8), (uint8_t)(hash >> 16), (uint8_t)(hash >> 24) };
+  t.Send(msg, sizeof(msg));
+}
+
+// One whole round of move codes over the loopback: both peers must end on the same state.
+static void LockstepRoundTest() {
+  auto [t0, t1] = LoopbackTransport::CreatePair();
+  LockstepConfig c0; c0.localPeer = 0; c0.checksumInterval = 1;
+  LockstepConfig c1; c1.localPeer = 1; c1.checksumInterval = 1;
+  LockstepSession s0(c0), s1(c1);
+  int desyncs = 0;
+  s0.OnDesync = s1.OnDesync = [&desyncs](int){ ++desyncs; };
+  StartLoopbackPair(s0, s1, t0, t1);
+
+  for (int turn=0; !s0.State().RoundOver() && turn < 200; ++turn) {
+    LockstepSession& mover = s0.IsLocalTurn() ? s0 : s1;
+    Assert(mover.IsLocalTurn(), "one peer is to move");
+    auto moves = LegalMoves(mover.State());
+    Assert(!moves.empty(), "moves in a live round");
+    Assert(mover.SubmitLocalMove(moves[(size_t)(turn * 5) % moves.size()]), "local move sent");
+    s0.Poll(); s1.Poll();
+    AssertEq(s0.Turn(), s1.Turn(), "peers on the same turn");
+  }
+  Assert(s0.State().RoundOver() && s1.State().RoundOver(), "round played out on both peers");
+  Assert(StateChecksum(s0.State()) == StateChecksum(s1.State()), "equal state checksums after the round");
+  AssertEq(desyncs, 0, "no desync in an honest round");
+}
+
+// A peer that sends an illegal code, or a checksum for a different state, must trip
+// OnDesync, and nothing it sends afterwards may move the state on.
+static void LockstepDesyncTest() {
+  {
+    auto [t0, t1] = LoopbackTransport::CreatePair();
+    LockstepConfig c0; c0.localPeer = 0;
+    LockstepConfig c1; c1.localPeer = 1;
+    LockstepSession s0(c0), s1(c1);
+    int desyncTurn = -1;
+    s1.OnDesync = [&desyncTurn](int turn){ desyncTurn = turn; };
+    StartLoopbackPair(s0, s1, t0, t1);
+    if (s1.IsLocalTurn()) {
+      Assert(s1.SubmitLocalMove(LegalMoves(s1.State())[0]), "local move sent");
+      s0.Poll();
+    }
+    Assert(s0.IsLocalTurn(), "peer 0 to move");
+    const uint16_t turn = s1.Turn();
+    SendMove(*t0, turn, 0xffff);
+    s1.Poll();
+    Assert(s1.Desynced(), "tampered code desyncs");
+    AssertEq(desyncTurn, turn, "OnDesync at the tampered turn");
+
+    SendMove(*t0, turn, 0);   // a legal code for that turn, too late
+    s1.Poll();
+    AssertEq(s1.Turn(), turn, "no moves applied after a desync");
+  }
+  {
+    auto [t0, t1] = LoopbackTransport::CreatePair();
+    LockstepConfig c0; c0.localPeer = 0; c0.checksumInterval = 1;
+    LockstepConfig c1; c1.localPeer = 1; c1.checksumInterval = 1;
+    LockstepSession s0(c0), s1(c1);
+    int desyncTurn = -1;
+    s1.OnDesync = [&desyncTurn](int turn){ desyncTurn = turn; };
+    StartLoopbackPair(s0, s1, t0, t1);
+    for (int i=0; i<3; ++i) {
+      LockstepSession& mover = s0.IsLocalTurn() ? s0 : s1;
+      Assert(mover.SubmitLocalMove(LegalMoves(mover.State())[0]), "local move sent");
+      s0.Poll(); s1.Poll();
+    }
+    Assert(!s1.Desynced(), "in sync before the bad checksum");
+    const uint64_t h = StateChecksum(s1.State());
+    SendChecksum(*t0, s1.Turn(), (uint32_t)(h ^ (h >> 32)) ^ 1u);
+    s1.Poll();
+    Assert(s1.Desynced(), "checksum mismatch desyncs");
+    AssertEq(desyncTurn, s1.Turn(), "OnDesync at the mismatched turn");
+  }
+}
+
+static GameState PermuteSuits(const GameState& gs, const std::array<Suit,4>& map) {
+  GameState out = gs;
+  auto remap = [&map](std::vector<Card>& v){ for (Card& c : v) c = RemapCard(c, map); };
+  for (auto& p : out.players) { remap(p.hand); remap(p.pile); }
+  remap(out.table.loose);
+  for (auto& b : out.table.builds) remap(b.cards);
+  remap(out.stock);
+  return out;
+}
+
+// Whole rounds through the hashing ApplyMove/DealNextHands: the incremental hash must
+// match a full rehash after every move, and every suit relabeling must hash the same.
+static void PositionHashTest() {
+  std::array<Suit,4> identity = { Suit::Clubs, Suit::Diamonds, Suit::Hearts, Suit::Spades };
+  for (uint32_t seed=1; seed<=8; ++seed) {
+    GameState gs; PositionHash h;
+    StartRound(gs, h, seed % 2 ? 2 : 4, seed);
+    for (int turn=0; !gs.RoundOver(); ++turn) {
+      if (gs.HandsEmpty()) Assert(DealNextHands(gs, h), "hashed deal");
+      auto moves = LegalMoves(gs);
+      Assert(!moves.empty(), "moves in a live round");
+      // spread over move types instead of always the first (usually a capture)
+      Assert(ApplyMove(gs, moves[(size_t)(turn * 7) % moves.size()], h), "hashed apply");
+      PositionHash full; full.Reset(gs);
+      Assert(h.suitHash == full.suitHash && h.buildKey == full.buildKey && h.scalarKey == full.scalarKey,
+             "incremental hash == full rehash");
+      Assert(h.Key() == CanonicalHash(gs), "incremental key == CanonicalHash");
+
+      if (turn % 5 != 0) continue;
+      std::array<Suit,4> perm = identity;
+      do {
+        Assert(CanonicalHash(PermuteSuits(gs, perm)) == h.Key(), "hash invariant under suit permutation");
+      } while (std::next_permutation(perm.begin(), perm.end()));
+      Assert(CanonicalHash(Canonicalize(gs, h)) == h.Key(), "canonical relabeling keeps the key");
+    }
+  }
+}
+
+// Suit-symmetric children share a cache entry, and a repeated search is all hits.
+static void MoveSearchCacheTest() {
+  GameState gs; gs.numPlayers = 2; gs.players.resize(2); gs.current = 0;
+  gs.players[0].hand = { C(Rank::Five,Suit::Clubs), C(Rank::Five,Suit::Hearts) };
+  gs.players[1].hand = { C(Rank::Nine,Suit::Spades), C(Rank::Two,Suit::Diamonds) };
+  gs.table.loose = { C(Rank::King,Suit::Spades) };
+  auto moves = LegalMoves(gs);
+  AssertEq((int)moves.size(), 2, "two trails");
+
+  MoveSearch search(1u << 8);
+  const int pick = search.Choose(gs, moves);
+  Assert(pick >= 0 && pick < (int)moves.size(), "search picks a legal move");
+  Assert(search.Cache().Hits() == 1, "5C and 5H trails transpose");
+  search.Choose(gs, moves);
+  Assert(search.Cache().Hits() == 3, "second search served from the cache");
+
+  GameState world = Determinize(gs, 0, 7);
+  Assert(world.players[0].hand == gs.players[0].hand, "viewer's hand kept");
+  Assert(LegalMoves(world).size() == moves.size(), "viewer's moves kept");
+  Assert(search.ChooseHidden(gs, moves) >= 0, "hidden search picks a move");
+}
+
+// The batched runner deals hands as bitmasks and enumerates captures its own way, so it
+// plays different individual games than the reference for the same seed; what has to
+// match is the outcome. For fixed seeds, per-player mean scores over 4000 games stay
+// within 0.75 points of the reference (about 5 standard errors), from fresh deals and
+// from a position with builds.
+static void BatchRolloutTest() {
+  std::vector<GameState> starts;
+  for (int players=2; players<=4; ++players) {
+    GameState gs; StartRound(gs, players, 0x5EED0u + (uint32_t)players);
+    starts.push_back(gs);
+  }
+  GameState mid; StartRound(mid, 2, 99);
+  for (int turn=0; turn<6 && !mid.RoundOver(); ++turn) {
+    if (mid.HandsEmpty()) DealNextHands(mid);
+    auto moves = LegalMoves(mid);
+    auto build = std::find_if(moves.begin(), moves.end(), [](const Move& m){ return m.type == MoveType::Build; });
+    ApplyMove(mid, build != moves.end() ? *build : moves.back());
+  }
+  Assert(!mid.table.builds.empty(), "rollout start with builds");
+  starts.push_back(mid);
+
+  const int games = 4001; // not a multiple of 8: the last group runs partly idle
+  for (const GameState& start : starts) {
+    for (uint32_t seed : { 1u, 0xC0FFEEu }) {
+      const RolloutStats ref = ReferenceRollouts(start, games, seed);
+      const RolloutStats batch = BatchRollouts(start, games, seed);
+      AssertEq(batch.games, ref.games, "batch game count");
+      for (int p=0; p<start.numPlayers; ++p) {
+        const double diff = (double)(batch.totalScore[p] - ref.totalScore[p]) / games;
+        Assert(diff > -0.75 && diff < 0.75, "batch mean score matches the reference");
+      }
+    }
+  }
+}
+
+static bool SameState(const GameState& a, const GameState& b) {
+  return StateChecksum(a) == StateChecksum(b);
+}
+
+// Snapshots and deltas round-trip over whole rounds; a delta against the wrong base is
+// refused without touching the state; corrupt snapshots never decode into a state with
+// out-of-range builds.
+static void StateCodecTest() {
+  uint8_t buf[MaxSnapshotBytes];
+  for (uint32_t seed=1; seed<=4; ++seed) {
+    GameState gs; StartRound(gs, seed % 2 ? 2 : 4, seed);
+    GameState mirror;
+    size_t n = EncodeSnapshot(gs, buf, sizeof(buf));
+    Assert(n > 0 && DecodeSnapshot(buf, n, mirror) && SameState(mirror, gs), "snapshot round trip");
+
+    for (int turn=0; !gs.RoundOver(); ++turn) {
+      const GameState base = gs;
+      if (gs.HandsEmpty()) DealNextHands(gs);
+      auto moves = LegalMoves(gs);
+      ApplyMove(gs, moves[(size_t)(turn * 5) % moves.size()]);
+
+      n = EncodeDelta(base, gs, buf, sizeof(buf));
+      Assert(n > 0 && ApplyDelta(buf, n, mirror) && SameState(mirror, gs), "delta round trip");
+      GameState stale = base;
+      Assert(!ApplyDelta(buf, n, mirror), "delta refused on the wrong base");
+      Assert(SameState(mirror, gs), "wrong base left untouched");
+      Assert(DecodeState(buf, n, stale) && SameState(stale, gs), "DecodeState applies deltas");
+    }
+    n = EncodeSnapshot(gs, buf, sizeof(buf));
+    Assert(n > 0 && DecodeSnapshot(buf, n, mirror) && SameState(mirror, gs), "final snapshot round trip");
+    Assert(EncodeSnapshot(gs, buf, 8) == 0, "snapshot into a short buffer");
+  }
+
+  // after ReserveState, a round of deltas and a snapshot decode must not reallocate
+  {
+    GameState gs; StartRound(gs, 4, 9);
+    GameState mirror;
+    size_t n = EncodeSnapshot(gs, buf, sizeof(buf));
+    Assert(DecodeSnapshot(buf, n, mirror), "snapshot for the reserved state");
+    ReserveState(mirror, 4);
+    auto storage = [](GameState& s) {
+      std::vector<std::pair<const void*, size_t>> v;
+      auto add = [&v](const auto& c){ v.emplace_back((const void*)c.data(), c.capacity()); };
+      add(s.players);
+      for (auto& p : s.players) { add(p.hand); add(p.pile); }
+      add(s.table.loose); add(s.table.builds); add(s.stock);
+      return v;
+    };
+    const auto before = storage(mirror);
+    for (int turn=0; !gs.RoundOver(); ++turn) {
+      const GameState base = gs;
+      if (gs.HandsEmpty()) DealNextHands(gs);
+      auto moves = LegalMoves(gs);
+      ApplyMove(gs, moves[(size_t)(turn * 3) % moves.size()]);
+      n = EncodeDelta(base, gs, buf, sizeof(buf));
+      Assert(n > 0 && ApplyDelta(buf, n, mirror), "delta into the reserved state");
+      Assert(storage(mirror) == before, "no reallocation applying a delta");
+    }
+    n = EncodeSnapshot(gs, buf, sizeof(buf));
+    Assert(DecodeSnapshot(buf, n, mirror) && SameState(mirror, gs), "snapshot into the reserved state");
+    Assert(storage(mirror) == before, "no reallocation decoding a snapshot");
+  }
+
+  GameState bad; bad.numPlayers = 2; bad.players.resize(2);
+  bad.table.builds.push_back(Build{ 8, 0, { C(Rank::Five,Suit::Clubs), C(Rank::Three,Suit::Hearts) } });
+  GameState out;
+  size_t n = EncodeSnapshot(bad, buf, sizeof(buf));
+  Assert(DecodeSnapshot(buf, n, out), "valid build decodes");
+  Assert(!DecodeSnapshot(buf, n - 1, out), "truncated snapshot rejected");
+  for (int owner : { 2, 3, -2 }) {
+    bad.table.builds[0].ownerPlayer = owner;
+    n = EncodeSnapshot(bad, buf, sizeof(buf));
+    Assert(!DecodeSnapshot(buf, n, out), "build owner out of range rejected");
+  }
+  bad.table.builds[0].ownerPlayer = -1;
+  n = EncodeSnapshot(bad, buf, sizeof(buf));
+  Assert(DecodeSnapshot(buf, n, out), "unowned build decodes");
+  for (int value : { 0, 14, 200 }) {
+    bad.table.builds[0].value = value;
+    n = EncodeSnapshot(bad, buf, sizeof(buf));
+    Assert(!DecodeSnapshot(buf, n, out), "build value out of range rejected");
+  }
+  buf[0] = 'X';
+  Assert(!DecodeSnapshot(buf, n, out), "bad magic rejected");
+
+  // any single corrupted byte either fails or still decodes into something in range
+  GameState gs; StartRound(gs, 2, 77);
+  for (int turn=0; turn<5; ++turn) { auto moves = LegalMoves(gs); ApplyMove(gs, moves[moves.size() / 2]); }
+  const size_t len = EncodeSnapshot(gs, buf, sizeof(buf));
+  RolloutRng rng(5);
+  for (size_t i=4; i<len; ++i) {
+    for (int k=0; k<8; ++k) {
+      uint8_t copy[MaxSnapshotBytes];
+      std::copy(buf, buf + len, copy);
+      copy[i] = (uint8_t)rng.Next();
+      if (!DecodeSnapshot(copy, len, out)) continue;
+      Assert(out.current >= 0 && out.current < out.numPlayers, "decoded turn in range");
+      for (const Build& b : out.table.builds)
+        Assert(b.value >= 1 && b.value <= 13 && b.ownerPlayer >= -1 && b.ownerPlayer < out.numPlayers,
+               "decoded build in range");
+    }
+  }
+}
+
 int main() {
+  LockstepDealTest();
+  LockstepRoundTest();
+  LockstepDesyncTest();
+  PositionHashTest();
+  MoveSearchCacheTest();
+  BatchRolloutTest();
+  StateCodecTest();
+
   // deterministic sandbox state: 2 players, no stock, exact hands/table
   GameState gs; gs.numPlayers = 2; gs.players.resize(2);
   gs.stock.clear();
@@ -0,0 +1,108 @@
+#include "window/egl/EglWindow.h"
+#include "core/Log.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+static bool hasExtension(const char* list, const char* name) {
+  if (!list) return false;
+  const size_t n = std::strlen(name);
+  for (const char* p = std::strstr(list, name); p; p = std::strstr(p + n, name))
+    if ((p == list || p[-1] == ' ') && (p[n] == ' ' || p[n] == '\0')) return true;
+  return false;
+}
+
+EglWindow::EglWindow(const FactoryDesc& desc) : NullWindow(desc) {}
+
+EglWindow::~EglWindow() {
+  if (!m_Display) return;
+  EGLDisplay dpy = (EGLDisplay)m_Display;
+  eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  if (m_Context) eglDestroyContext(dpy, (EGLContext)m_Context);
+  eglTerminate(dpy);
+}
+
+bool EglWindow::EnsureGLContext(int major, int minor, bool debug) {
+  if (m_Context) return true;
+
+  // the surfaceless platform needs no display server; fall back to the default display
+  EGLDisplay dpy = EGL_NO_DISPLAY;
+  auto getPlatformDisplay =
+      (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+  if (getPlatformDisplay &&
+      hasExtension(eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS), "EGL_MESA_platform_surfaceless"))
+    dpy = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+  if (dpy == EGL_NO_DISPLAY) dpy = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+  EGLint eglMajor = 0, eglMinor = 0;
+  if (dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, &eglMajor, &eglMinor)) {
+    EN_CORE_ERROR("[EGL] no display could be initialized");
+    return false;
+  }
+  m_Display = dpy;
+
+  if (!hasExtension(eglQueryString(dpy, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")) {
+    EN_CORE_ERROR("[EGL] EGL_KHR_surfaceless_context unsupported");
+    return false;
+  }
+  if (!eglBindAPI(EGL_OPENGL_API)) {
+    EN_CORE_ERROR("[EGL] desktop OpenGL unavailable");
+    return false;
+  }
+
+  // no surface is ever created, so any surface type will do
+  const EGLint configAttribs[] = {
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_SURFACE_TYPE, 0,
+    EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+    EGL_NONE
+  };
+  EGLConfig config = nullptr;
+  EGLint configs = 0;
+  if (!eglChooseConfig(dpy, configAttribs, &config, 1, &configs) || configs == 0) {
+    EN_CORE_ERROR("[EGL] no RGBA8 OpenGL config");
+    return false;
+  }
+
+  const EGLint contextAttribs[] = {
+    EGL_CONTEXT_MAJOR_VERSION, major,
+    EGL_CONTEXT_MINOR_VERSION, minor,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_CONTEXT_OPENGL_DEBUG, debug ? EGL_TRUE : EGL_FALSE,
+    EGL_NONE
+  };
+  EGLContext ctx = eglCreateContext(dpy, config, EGL_NO_CONTEXT, contextAttribs);
+  if (ctx == EGL_NO_CONTEXT) {
+    EN_CORE_ERROR("[EGL] creating a {}.{} core context failed (0x{:x})", major, minor,
+                  (unsigned)eglGetError());
+    return false;
+  }
+  if (!eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx)) {
+    eglDestroyContext(dpy, ctx);
+    EN_CORE_ERROR("[EGL] making the surfaceless context current failed");
+    return false;
+  }
+  m_Context = ctx;
+  EN_CORE_INFO("[EGL] {}.{} surfaceless context ({})", eglMajor, eglMinor,
+               eglQueryString(dpy, EGL_VENDOR));
+  return true;
+}
+
+IWindow::GLProc EglWindow::GetGLProcLoader() const {
+  return [](const char* name) -> void* { return (void*)eglGetProcAddress(name); };
+}
+
+bool EglWindow::MakeContextCurrent() {
+  if (!m_Context) return false;
+  return eglMakeCurrent((EGLDisplay)m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                        (EGLContext)m_Context) == EGL_TRUE;
+}
+
+void EglWindow::ReleaseContext() {
+  if (m_Display) eglMakeCurrent((EGLDisplay)m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
@@ -117,6 +117,21 @@ void GlfwWindow::PollEvents() {
     glfwPollEvents();
 }
 
+void GlfwWindow::WaitEvents(double timeoutSeconds) {
+#ifdef __EMSCRIPTEN__
+    // the browser owns the loop; blocking here would stall it
+    (void)timeoutSeconds;
+    glfwPollEvents();
+#else
+    if (timeoutSeconds > 0.0) glfwWaitEventsTimeout(timeoutSeconds);
+    else glfwPollEvents();
+#endif
+}
+
+void GlfwWindow::PostEmptyEvent() {
+    glfwPostEmptyEvent();
+}
+
 void GlfwWindow::SwapBuffers() {
   if(m_HasGL) glfwSwapBuffers(m_Window);
 }
@@ -162,6 +177,14 @@ bool GlfwWindow::EnsureGLContext(int /*major*/, int /*minor*/, bool /*debug*/) {
 GlfwWindow::GLProc GlfwWindow::GetGLProcLoader() const {
   return (GLProc)glfwGetProcAddress;
 }
+bool GlfwWindow::MakeContextCurrent() {
+  if (!m_HasGL) return true;
+  glfwMakeContextCurrent(m_Window);
+  return glfwGetCurrentContext() == m_Window;
+}
+void GlfwWindow::ReleaseContext() {
+  if (m_HasGL) glfwMakeContextCurrent(nullptr);
+}
 void GlfwWindow::SetSwapInterval(int interval) {
   if (m_HasGL) glfwSwapInterval(interval);
 }
@@ -0,0 +1,84 @@
+#include "window/null/NullWindow.h"
+
+#include <algorithm>
+
+NullWindow::NullWindow(const FactoryDesc& desc) {
+  m_logicalW = desc.logicalWidth;
+  m_logicalH = desc.logicalHeight;
+  m_fbW = desc.windowWidth > 0 ? desc.windowWidth : desc.logicalWidth;
+  m_fbH = desc.windowHeight > 0 ? desc.windowHeight : desc.logicalHeight;
+  m_dpr = m_logicalW > 0 ? (float)m_fbW / (float)m_logicalW : 1.0f;
+  m_Vsync = desc.vsync;
+}
+
+void NullWindow::PollEvents() {
+  // actions may schedule more; those land at or after m_Next, so index, don't iterate
+  while (m_Next < m_Script.size() && m_Script[m_Next].Poll <= m_Polls) {
+    Action run = std::move(m_Script[m_Next].Run);
+    ++m_Next;
+    run(*this);
+  }
+  if (m_Next == m_Script.size()) {
+    m_Script.clear();
+    m_Next = 0;
+  }
+  ++m_Polls;
+}
+
+std::pair<float, float> NullWindow::GetLogicalSize() const {
+  return {(float)m_logicalW, (float)m_logicalH};
+}
+
+// no window decorations or scaling: the window is the framebuffer
+std::pair<float, float> NullWindow::GetWindowSize() const { return {(float)m_fbW, (float)m_fbH}; }
+std::pair<float, float> NullWindow::GetFramebufferSize() const {
+  return {(float)m_fbW, (float)m_fbH};
+}
+
+void NullWindow::At(uint64_t poll, Action action) {
+  auto it = std::upper_bound(m_Script.begin() + (std::ptrdiff_t)m_Next, m_Script.end(), poll,
+                             [](uint64_t p, const Scripted& s) { return p < s.Poll; });
+  m_Script.insert(it, Scripted{poll, std::move(action)});
+}
+
+void NullWindow::Click(uint64_t poll, float x, float y, MouseButton button) {
+  At(poll, [=](NullWindow& w) {
+    w.m_Events.Emit(EMouseMove{x, y});
+    w.m_Events.Emit(EMouseButton{button, x, y}, true);
+    w.m_Events.Emit(EMouseButton{button, x, y}, false);
+  });
+}
+
+void NullWindow::MoveMouse(uint64_t poll, float x, float y) {
+  At(poll, [=](NullWindow& w) { w.m_Events.Emit(EMouseMove{x, y}); });
+}
+
+void NullWindow::PressKey(uint64_t poll, Key key) {
+  At(poll, [=](NullWindow& w) {
+    w.m_Events.Emit(EKey{key, false}, true);
+    w.m_Events.Emit(EKey{key, false}, false);
+  });
+}
+
+void NullWindow::Resize(uint64_t poll, int fbWidth, int fbHeight) {
+  At(poll, [=](NullWindow& w) { w.SetFramebufferSize(fbWidth, fbHeight); });
+}
+
+void NullWindow::CloseAt(uint64_t poll) {
+  At(poll, [](NullWindow& w) { w.Close(); });
+}
+
+void NullWindow::Close() {
+  if (m_ShouldClose) return;
+  m_Events.EmitClose();
+  if (m_OnClose) m_OnClose();
+  m_ShouldClose = true;
+}
+
+void NullWindow::SetFramebufferSize(int fbWidth, int fbHeight) {
+  m_fbW = std::max(fbWidth, 1);
+  m_fbH = std::max(fbHeight, 1);
+  m_dpr = m_logicalW > 0 ? (float)m_fbW / (float)m_logicalW : 1.0f;
+  m_Events.Emit(EWindowResize{m_fbW, m_fbH, m_dpr});
+  if (m_OnResize) m_OnResize(m_fbW, m_fbH, m_dpr);
+}